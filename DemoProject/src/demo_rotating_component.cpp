@@ -20,7 +20,7 @@ void DemoRotatingComponent::Tick(float deltaTime)
 {
 	Super::Tick(deltaTime);
 
-	Vec3 rot = GetOwner()->GetRotation();
-	rot += mRotation * deltaTime;
-	GetOwner()->SetRotation(rot);
+	// composed as a quaternion, going through euler angles flips at 90 degrees pitch
+	Quat delta = math::QuatFromEuler(mRotation * deltaTime);
+	GetOwner()->SetRotation(math::QuatNormalize(math::QuatMultiply(GetOwner()->GetRotation(), delta)));
 }
\ No newline at end of file
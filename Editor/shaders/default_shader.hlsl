@@ -12,16 +12,17 @@ cbuffer ViewProjBuffer : register(b0)
     float4x4 vp;
 };
 
+// one model matrix per instance, size is RENDERER_MAX_INSTANCES_PER_DRAW
 cbuffer ModelBuffer : register(b1)
 {
-    float4x4 m;
+    float4x4 m[256];
 };
 
-VertexOutput main(float4 position : POSITION, float4 color : COLOR, float2 textCoords : TEXTCOORDS)
+VertexOutput main(float4 position : POSITION, float4 color : COLOR, float2 textCoords : TEXTCOORDS, uint instanceID : SV_InstanceID)
 {
     VertexOutput output;
 
-    output.position = mul(position, mul(m, vp));
+    output.position = mul(position, mul(m[instanceID], vp));
     output.color = color;
     output.textCoords = textCoords;
 
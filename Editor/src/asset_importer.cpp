@@ -13,11 +13,22 @@
 #include "engine/project.h"
 
 #include "renderer/mesh.h"
+#include "utils/mesh_utils.h"
 #include "classes/object_serializer.h"
 
 #include "utils/string_utils.h"
 
+#include <float.h>
+#include <algorithm>
+
 #define DEFAULT_IMAGE_IMPORT_CHANNELS 4
+#define DEFAULT_MESH_IMPORT_VERTEX_FORMAT MESH_VERTEX_FORMAT_PACKED
+// lod 0 included
+#define MESH_IMPORT_MAX_LODS 4
+// relative to the mesh extent
+#define MESH_IMPORT_MAX_LOD_ERROR 0.05f
+// fraction of the screen height a lod error can take before switching to a better lod, about a pixel at 1080p
+#define MESH_IMPORT_LOD_SCREEN_ERROR 0.001f
 
 const std::vector<SupportedImport> sSupportedImports =
 {
@@ -117,6 +128,7 @@ void AssetImporter::TryImportAsset(const std::string& file)
     }
 
     bool importedSuccessfully = false;
+    std::string importReport;
     switch (assetType)
     {
     case ASSET_TYPE_TEXTURE:
@@ -124,8 +136,12 @@ void AssetImporter::TryImportAsset(const std::string& file)
         break;
 
     case ASSET_TYPE_MESH:
-        importedSuccessfully = AssetImporter::ImportMesh(file, newFileName);
+    {
+        MeshImportReport meshReport;
+        importedSuccessfully = AssetImporter::ImportMesh(file, newFileName, &meshReport);
+        importReport = meshReport.ToString();
         break;
+    }
 
     case ASSET_TYPE_AUDIO_CLIP:
         importedSuccessfully = AssetImporter::ImportAudio(file, newFileName);
@@ -133,11 +149,19 @@ void AssetImporter::TryImportAsset(const std::string& file)
     }
 
     if (importedSuccessfully)
-        SysMessageBox::Show_Info("Asset imported successfully!", "Asset imported successfully!");
+        SysMessageBox::Show_Info("Asset imported successfully!", importReport.empty() ? "Asset imported successfully!" : "Asset imported successfully!\n\n" + importReport);
     else
         SysMessageBox::Show_Error("Asset import failed!", "Unable to import asset :(");
 }
 
+std::string MeshImportReport::ToString() const
+{
+    char report[256];
+    snprintf(report, sizeof(report), "vertices %u -> %u, indices %u, geometry %.1f KB -> %.1f KB (%u lods), cache misses per triangle %.2f -> %.2f",
+        sourceVertexCount, vertexCount, indexCount, sourceSize / 1024.0f, size / 1024.0f, lodCount, acmrBefore, acmrAfter);
+    return report;
+}
+
 const std::vector<SupportedImport>& AssetImporter::GetSupportedImports()
 {
     return sSupportedImports;
@@ -188,7 +212,13 @@ bool AssetImporter::ImportTexture(const std::string& originalFile, const std::st
 
 extern CORE_API Material* DEFAULT_MATERIAL;
 
-bool AssetImporter::ImportMesh(const std::string& originalFile, const std::string& newFile)
+struct ImportedGeometry
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<MeshIndex> indices;
+};
+
+bool AssetImporter::ImportMesh(const std::string& originalFile, const std::string& newFile, MeshImportReport* outReport)
 {
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
@@ -206,107 +236,186 @@ bool AssetImporter::ImportMesh(const std::string& originalFile, const std::strin
         GROOVY_LOG_WARN("tinyobj LoadObj warning: %s", warn.c_str());
     }
 
-    Buffer fileData;
-    size_t vertexBufferSize = 0;
-    size_t indexBufferSize = 0;
-    uint32 submeshCount = 0;
-
-    for (const auto& shape : shapes)
-    {
-        vertexBufferSize += shape.mesh.indices.size() * sizeof(MeshVertex);
-        indexBufferSize += shape.mesh.indices.size() * sizeof(MeshIndex);
-        submeshCount++;
-    }
-
-    fileData.resize
-    (
-        sizeof(MeshAssetHeader) + // mesh asset header
-        vertexBufferSize + // vertex buffer
-        indexBufferSize // index buffer
-    );
-
-    BufferView fileDataView(fileData);
+    MeshImportReport report = {};
 
-    MeshAssetHeader* header = fileDataView.read<MeshAssetHeader>(1);
-    header->vertexBufferSize = vertexBufferSize;
-    header->indexBufferSize = indexBufferSize;
+    // lods[lod][shape], indices are relative to the submesh first vertex
+    std::vector<std::vector<ImportedGeometry>> lods(1, std::vector<ImportedGeometry>(shapes.size()));
 
-    MeshVertex* vertexBuffer = (MeshVertex*)fileDataView.read(header->vertexBufferSize);
-    MeshIndex* indexBuffer = (MeshIndex*)fileDataView.read(header->indexBufferSize);
     MeshAssetFile asset;
-    asset.submeshes.resize(submeshCount);
-    asset.materials.resize(submeshCount);
+    asset.materials.resize(shapes.size());
     for (Material*& m : asset.materials)
         m = DEFAULT_MATERIAL;
 
+    std::vector<MeshVertex> shapeVertices;
+    std::vector<MeshVertex> weldedVertices;
+    std::vector<MeshIndex> weldedIndices;
+
     for (uint32 i = 0; i < shapes.size(); i++)
     {
         const auto& shape = shapes[i];
 
-
+        // one vertex per obj index, welded right after
+        shapeVertices.resize(shape.mesh.indices.size());
         for (uint32 j = 0; j < shape.mesh.indices.size(); j++)
         {
             const auto& index = shape.mesh.indices[j];
+            MeshVertex& vertex = shapeVertices[j];
 
-            // vertex data
+            // position
+            vertex.position =
             {
-                // position
-                vertexBuffer->position =
-                {
-                    attrib.vertices[3 * index.vertex_index + 0],
-                    attrib.vertices[3 * index.vertex_index + 1],
-                    attrib.vertices[3 * index.vertex_index + 2],
-                    1.0f
-                };
+                attrib.vertices[3 * index.vertex_index + 0],
+                attrib.vertices[3 * index.vertex_index + 1],
+                attrib.vertices[3 * index.vertex_index + 2],
+                1.0f
+            };
 
-                // texture coordinates
-                vertexBuffer->textCoords = { 0.0f, 0.0f };
+            // texture coordinates
+            vertex.textCoords = { 0.0f, 0.0f };
 
-                if (index.texcoord_index != -1)
-                {
-                    vertexBuffer->textCoords =
-                    {
-                        attrib.texcoords[2 * index.texcoord_index + 0],
-                        1.0f - attrib.texcoords[2 * index.texcoord_index + 1]
-                    };
-                }
-
-                // color
-                vertexBuffer->color =
+            if (index.texcoord_index != -1)
+            {
+                vertex.textCoords =
                 {
-                    1.0f, 1.0f, 1.0f, 1.0f
+                    attrib.texcoords[2 * index.texcoord_index + 0],
+                    1.0f - attrib.texcoords[2 * index.texcoord_index + 1]
                 };
             }
-            // index data
+
+            // color, white when the obj has none
+            vertex.color =
+            {
+                1.0f, 1.0f, 1.0f, 1.0f
+            };
+
+            if (attrib.colors.size() >= 3 * (index.vertex_index + 1))
             {
-                *indexBuffer = j;
+                vertex.color =
+                {
+                    attrib.colors[3 * index.vertex_index + 0],
+                    attrib.colors[3 * index.vertex_index + 1],
+                    attrib.colors[3 * index.vertex_index + 2],
+                    1.0f
+                };
             }
+        }
+
+        meshUtils::WeldVertices(shapeVertices.data(), (uint32)shapeVertices.size(), weldedVertices, weldedIndices);
+
+        uint32 vertexCount = (uint32)weldedVertices.size();
+        uint32 indexCount = (uint32)weldedIndices.size();
+
+        report.acmrBefore += meshUtils::ComputeACMR(weldedIndices.data(), indexCount, vertexCount) * (indexCount / 3);
 
-            vertexBuffer++;
-            indexBuffer++;
+        meshUtils::OptimizeVertexCache(weldedIndices.data(), indexCount, vertexCount);
+        meshUtils::OptimizeOverdraw(weldedIndices.data(), indexCount, weldedVertices.data(), vertexCount);
+        vertexCount = meshUtils::OptimizeVertexFetch(weldedVertices.data(), vertexCount, weldedIndices.data(), indexCount);
 
-            asset.submeshes[i].vertexCount++;
-            asset.submeshes[i].indexCount++;
+        report.acmrAfter += meshUtils::ComputeACMR(weldedIndices.data(), indexCount, vertexCount) * (indexCount / 3);
+
+        lods[0][i].vertices.assign(weldedVertices.begin(), weldedVertices.begin() + vertexCount);
+        lods[0][i].indices = weldedIndices;
+
+        report.sourceVertexCount += (uint32)shapeVertices.size();
+        report.vertexCount += vertexCount;
+        report.indexCount += indexCount;
+    }
+
+    // lod chain, every lod simplifies the previous one to half its triangles
+    std::vector<float> lodErrors(1, 0.0f);
+    std::vector<MeshIndex> simplifiedIndices;
+
+    for (uint32 lod = 1; lod < MESH_IMPORT_MAX_LODS; lod++)
+    {
+        const std::vector<ImportedGeometry>& previous = lods.back();
+        std::vector<ImportedGeometry> current(shapes.size());
+
+        size_t previousTriangleCount = 0;
+        size_t triangleCount = 0;
+        float lodError = 0.0f;
+
+        for (uint32 i = 0; i < shapes.size(); i++)
+        {
+            const ImportedGeometry& source = previous[i];
+
+            float error = 0.0f;
+            uint32 targetIndexCount = (uint32)(source.indices.size() / 6 * 3);
+            meshUtils::Simplify(source.indices.data(), (uint32)source.indices.size(), source.vertices.data(), (uint32)source.vertices.size(), targetIndexCount, MESH_IMPORT_MAX_LOD_ERROR, simplifiedIndices, &error);
+
+            ImportedGeometry& geometry = current[i];
+            geometry.vertices = source.vertices;
+            geometry.indices = simplifiedIndices;
+
+            meshUtils::OptimizeVertexCache(geometry.indices.data(), (uint32)geometry.indices.size(), (uint32)geometry.vertices.size());
+            uint32 vertexCount = meshUtils::OptimizeVertexFetch(geometry.vertices.data(), (uint32)geometry.vertices.size(), geometry.indices.data(), (uint32)geometry.indices.size());
+            geometry.vertices.resize(vertexCount);
+
+            previousTriangleCount += source.indices.size() / 3;
+            triangleCount += geometry.indices.size() / 3;
+            lodError = std::max(lodError, error);
+        }
+
+        // not worth a lod, the simplifier is stuck on borders and seams or hit the error limit
+        if (triangleCount > previousTriangleCount * 4 / 5)
+            break;
+
+        lods.push_back(std::move(current));
+        // errors add up along the chain
+        lodErrors.push_back(lodErrors.back() + lodError);
+    }
+
+    // a lod is drawn until the next one's error would be visible
+    if (lods.size() > 1)
+    {
+        asset.lodScreenSizes.resize(lods.size());
+        for (uint32 lod = 0; lod + 1 < lods.size(); lod++)
+            asset.lodScreenSizes[lod] = lodErrors[lod + 1] > 0.0f ? MESH_IMPORT_LOD_SCREEN_ERROR / lodErrors[lod + 1] : FLT_MAX;
+        asset.lodScreenSizes.back() = 0.0f;
+    }
+
+    // lod major, one submesh per shape in every lod
+    std::vector<MeshVertex> vertices;
+    std::vector<MeshIndex> indices;
+
+    for (const std::vector<ImportedGeometry>& lod : lods)
+    {
+        for (const ImportedGeometry& geometry : lod)
+        {
+            vertices.insert(vertices.end(), geometry.vertices.begin(), geometry.vertices.end());
+            indices.insert(indices.end(), geometry.indices.begin(), geometry.indices.end());
+            asset.submeshes.push_back({ (uint32)geometry.vertices.size(), (uint32)geometry.indices.size() });
         }
     }
 
-    DynamicBuffer fileData2;
+    report.lodCount = (uint32)lods.size();
+
+    DynamicBuffer fileData;
+    meshUtils::WriteGeometry(vertices.data(), (uint32)vertices.size(), indices.data(), (uint32)indices.size(), DEFAULT_MESH_IMPORT_VERTEX_FORMAT, fileData);
+    size_t geometrySize = fileData.used();
+
     PropertyPack meshAssetPropPack;
     ObjectSerializer::CreatePropertyPack(&asset, MeshAssetFile::StaticCDO(), meshAssetPropPack);
-    ObjectSerializer::SerializePropertyPack(meshAssetPropPack, fileData2);
-
-    Buffer finalFileData;
-    finalFileData.resize(fileData.size() + fileData2.used());
-    memcpy(finalFileData.data(), fileData.data(), fileData.size());
-    memcpy(finalFileData.data() + fileData.size(), fileData2.data(), fileData2.used());
+    ObjectSerializer::SerializePropertyPack(meshAssetPropPack, fileData);
 
-    if (FileSystem::WriteFileBinary((gProj.GetAssetsPath() / newFile).string(), finalFileData) != FILE_OPEN_RESULT_OK)
+    if (FileSystem::WriteFileBinary((gProj.GetAssetsPath() / newFile).string(), fileData) != FILE_OPEN_RESULT_OK)
     {
         return false;
     }
     
     AssetManager::Editor_Add(newFile, ASSET_TYPE_MESH);
 
+    // averages weighted by triangle count
+    uint32 triangleCount = report.indexCount / 3;
+    report.sourceSize = report.sourceVertexCount * (sizeof(MeshVertex) + sizeof(MeshIndex));
+    report.size = geometrySize;
+    report.acmrBefore = triangleCount ? report.acmrBefore / triangleCount : 0.0f;
+    report.acmrAfter = triangleCount ? report.acmrAfter / triangleCount : 0.0f;
+
+    GROOVY_LOG_INFO("Imported mesh %s: %s", newFile.c_str(), report.ToString().c_str());
+
+    if (outReport)
+        *outReport = report;
+
     return true;
 }
 
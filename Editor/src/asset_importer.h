@@ -11,12 +11,33 @@ struct SupportedImport
 	EAssetType type;
 };
 
+// geometry before and after the import optimizations
+struct MeshImportReport
+{
+	// one vertex per obj index, what the mesh would take unwelded and unpacked
+	uint32 sourceVertexCount;
+	size_t sourceSize;
+
+	// lod 0
+	uint32 vertexCount;
+	uint32 indexCount;
+	// geometry in the asset file, every lod
+	size_t size;
+	uint32 lodCount;
+
+	// cache misses per triangle of the welded mesh, before and after the reordering
+	float acmrBefore;
+	float acmrAfter;
+
+	std::string ToString() const;
+};
+
 class AssetImporter
 {
 public:
 	static EAssetType GetTypeFromFilename(const std::string& filename);
 	static bool ImportTexture(const std::string& originalFile, const std::string& newFile);
-	static bool ImportMesh(const std::string& originalFile, const std::string& newFile);
+	static bool ImportMesh(const std::string& originalFile, const std::string& newFile, MeshImportReport* outReport = nullptr);
 	static bool ImportAudio(const std::string& originalFile, const std::string& newFile);
 
 	static bool GetRawTexture(const std::string& compressedFile, Buffer& outBuffer, TextureSpec& outSpec);
@@ -37,6 +37,7 @@
 #include "renderer/scene_renderer.h"
 
 #include "audio/audio.h"
+#include "core/async_io.h"
 
 #include "math/math.h"
 
@@ -50,7 +51,7 @@ void EditorSettings::Load()
 	{
 		PropertyPack pack;
 		BufferView settingsFileView(settingsFile);
-		ObjectSerializer::DeserializePropertyPack(EditorSettings::StaticClass(), settingsFileView, pack);
+		ObjectSerializer::DeserializePropertyPack(EditorSettings::StaticClass(), settingsFileView, pack, true);
 		ObjectSerializer::DeserializePropertyPackData(pack, this);
 	}
 }
@@ -421,6 +422,8 @@ namespace assetPopups
 
 					AssetManager::Editor_Remove(sAssetActionHandle);
 
+					// a save may still be on its way to disk
+					AsyncIO::WaitForPath((gProj.GetAssetsPath() / sAssetActionHandle.name).string());
 					FileSystem::DeleteFile((gProj.GetAssetsPath() / sAssetActionHandle.name).string());
 
 					popupShouldClose = true;
@@ -454,6 +457,7 @@ namespace assetPopups
 				if (ImGui::Button("Rename"))
 				{
 					AssetManager::Editor_Rename(sAssetActionHandle, sAssetRename + GROOVY_ASSET_EXT);
+					AsyncIO::WaitForPath((gProj.GetAssetsPath() / sAssetActionHandle.name).string());
 					FileSystem::Rename((gProj.GetAssetsPath() / sAssetActionHandle.name).string(), (gProj.GetAssetsPath() / (sAssetRename + GROOVY_ASSET_EXT)).string());
 
 					popupShouldClose = true;
@@ -1471,6 +1475,8 @@ namespace panels
 			{
 				ImGui::Text("Transform");
 				transformChanged = editorGui::Transform("##actor_transform", &sCurrentScene->selectedActor->Editor_TransformRef());
+				if (transformChanged)
+					sCurrentScene->selectedActor->Editor_OnTransformChanged();
 				ImGui::Spacing();
 				ImGui::Spacing();
 			}
@@ -1478,6 +1484,8 @@ namespace panels
 			{
 				ImGui::Text("Transform (relative)");
 				transformChanged = editorGui::Transform("##scene_comp_transform", &sceneComp->Editor_TransformRef());
+				if (transformChanged)
+					sceneComp->Editor_OnTransformChanged();
 				ImGui::Spacing();
 				ImGui::Spacing();
 			}
@@ -1993,6 +2001,18 @@ void editor::Render()
 			ImGui::EndMenu();
 		}
 
+#if GROOVY_PROFILER_ENABLED
+		if (ImGui::BeginMenu("Profiler"))
+		{
+			if (ImGui::MenuItem("Start capture", nullptr, false, !Profiler::IsCapturing()))
+				Profiler::BeginCapture();
+			if (ImGui::MenuItem("Stop capture", nullptr, false, Profiler::IsCapturing()))
+				Profiler::EndCapture((std::filesystem::path(Profiler::GetCaptureDirectory()) / "capture.json").string());
+
+			ImGui::EndMenu();
+		}
+#endif
+
 		if (ImGui::BeginMenu("Help"))
 		{
 			if(ImGui::MenuItem("Help"))
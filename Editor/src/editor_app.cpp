@@ -8,6 +8,7 @@
 #include "platform/messagebox.h"
 #include "renderer/api/shader.h"
 #include "platform/window.h"
+#include "assets/asset_manager.h"
 
 IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
@@ -20,6 +21,9 @@ extern CORE_API Shader* DEFAULT_SHADER;
 void Application::PreInit()
 {
 	SetGroovyLogger(editor::ConsoleLog);
+
+	// assets are edited in place, they must never be unloaded under the editor
+	AssetManager::SetKeepEverythingLoaded(true);
 }
 
 void Application::Init()
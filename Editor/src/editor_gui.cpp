@@ -6,6 +6,8 @@
 #include "gameframework/blueprint.h"
 #include "gameframework/actor.h"
 #include "gameframework/actor_component.h"
+#include "math/quat.h"
+#include <unordered_map>
 
 bool editorGui::AssetRef(const char* label, EAssetType type, void* data, bool allowNull, GroovyClass* classFilter)
 {
@@ -228,13 +230,39 @@ static bool Vec3Control(const char* label, void* data, float speed)
 	return changed;
 }
 
+// transforms store a quaternion, the editor shows euler angles. the angles last shown are kept per transform
+// so they don't jump to an equivalent set (or flip near 90 pitch) while the quaternion still matches them
+struct EulerView
+{
+	Quat rotation;
+	Vec3 euler;
+};
+
+static std::unordered_map<const void*, EulerView> sEulerViews;
+
 bool editorGui::Transform(const char* label, void* data)
 {
 	struct Transform* t = (struct Transform*)data;
+
+	EulerView& view = sEulerViews[t];
+	if (memcmp(&view.rotation, &t->rotation, sizeof(Quat)) != 0)
+	{
+		// changed somewhere else (or first time shown)
+		view.rotation = t->rotation;
+		view.euler = math::QuatToEuler(t->rotation);
+	}
+
 	ImGui::NewLine();
 	bool loc = Vec3Control("Location", &t->location, 0.01f);
-	bool rot = Vec3Control("Rotation", &t->rotation, 0.1f);
+	bool rot = Vec3Control("Rotation", &view.euler, 0.1f);
 	bool scale = Vec3Control("Scale", &t->scale, 0.01f);
+
+	if (rot)
+	{
+		t->rotation = math::QuatFromEuler(view.euler);
+		view.rotation = t->rotation;
+	}
+
 	return loc || rot || scale;
 }
 
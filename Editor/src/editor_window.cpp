@@ -160,7 +160,7 @@ MeshPreviewWindow::MeshPreviewWindow(const AssetHandle& asset)
 	mPreviewFrameBuffer = FrameBuffer::Create(frameBufferSpec);
 
 	mModelTransform.location = { 0.0f, 0.0f, 0.0f };
-	mModelTransform.rotation = { 0.0f, 0.0f, 0.0f };
+	mModelTransform.rotation = math::GetIdentityQuat();
 	mModelTransform.scale = { 1.0f, 1.0f, 1.0f };
 
 	mCameraZoom = -3.0f;
@@ -227,7 +227,7 @@ void MeshPreviewWindow::RenderContent()
 	if (okSize)
 	{
 		Mat4 camera =
-			math::GetViewMatrix({ 0, 0, mCameraZoom }, { 0,0,0 })
+			math::GetViewMatrix({ 0, 0, mCameraZoom }, math::GetIdentityQuat())
 			*
 			math::GetPerspectiveMatrix(wndSize.x / wndSize.y, 60.0f, 0.01f, 1000.0f);
 
@@ -236,6 +236,7 @@ void MeshPreviewWindow::RenderContent()
 		camera = math::GetMatrixTransposed(camera);
 		model = math::GetMatrixTransposed(model);
 
+		Renderer::InvalidateBindings();
 		Renderer::SetCamera(camera);
 		Renderer::SetModel(model);
 
@@ -250,6 +251,7 @@ void MeshPreviewWindow::RenderContent()
 void MeshPreviewWindow::Save()
 {
 	mMesh->Editor_MaterialsRef() = mMeshMats;
+	mMesh->Editor_OnMaterialsChanged();
 	mMesh->Save();
 	AssetEditorWindow::Save();
 }
@@ -554,7 +556,7 @@ void ActorBlueprintEditorWindow::RenderContent()
 
 		if (okSize)
 		{
-			SceneRenderer::BeginScene({ 0.0f, 0.0f, mCameraZoom }, { 0.0f, 0.0f, 0.0f }, 60.0f, wndSize.x / wndSize.y);
+			SceneRenderer::BeginScene({ 0.0f, 0.0f, mCameraZoom }, math::GetIdentityQuat(), 60.0f, wndSize.x / wndSize.y);
 			SceneRenderer::RenderScene(&mLiveScene);
 		}
 
@@ -575,6 +577,8 @@ void ActorBlueprintEditorWindow::RenderContent()
 		{
 			ImGui::Text("Transform (relative)");
 			transformChanged = editorGui::Transform("##scene_comp_transform", &sceneComp->Editor_TransformRef());
+			if (transformChanged)
+				sceneComp->Editor_OnTransformChanged();
 			ImGui::Spacing();
 			ImGui::Spacing();
 		}
@@ -17,21 +17,37 @@ project "Groovy"
         "%{wks.location}/vendor"
     }
 
-    libdirs
-    {
-        "%{wks.location}/vendor/fmod/bin"
-    }
+    -- fmod only ships windows binaries in vendor, other platforms build audio/audio_null.cpp
+    filter "system:windows"
+        libdirs
+        {
+            "%{wks.location}/vendor/fmod/bin"
+        }
 
-    links
-    {
-        "fmod"
-    }
+        links
+        {
+            "fmod"
+        }
+    filter {}
+
+    -- the only files built with avx2 codegen, picked at runtime when the cpu supports it
+    filter "files:src/renderer/api/software/software_raster_avx2.cpp or src/math/matrix_avx2.cpp"
+        vectorextensions "AVX2"
+
+    filter {}
 
     postbuildcommands
     {
         ("{COPYDIR} %{cfg.buildtarget.directory}" .. " %{wks.location}bin/" .. outputdir .. "/Editor/"),
         ("{COPYDIR} %{cfg.buildtarget.directory}" .. " %{wks.location}bin/" .. outputdir .. "/Sandbox/"),
+        ("{COPYDIR} %{cfg.buildtarget.directory}" .. " %{wks.location}bin/" .. outputdir .. "/Headless/")
+    }
 
-        ("{COPYDIR} %{wks.location}/vendor/fmod/bin/" .. " %{wks.location}bin/" .. outputdir .. "/Editor/"),
-        ("{COPYDIR} %{wks.location}/vendor/fmod/bin/" .. " %{wks.location}bin/" .. outputdir .. "/Sandbox/")
-    }
\ No newline at end of file
+    filter "system:windows"
+        postbuildcommands
+        {
+            ("{COPYDIR} %{wks.location}/vendor/fmod/bin/" .. " %{wks.location}bin/" .. outputdir .. "/Editor/"),
+            ("{COPYDIR} %{wks.location}/vendor/fmod/bin/" .. " %{wks.location}bin/" .. outputdir .. "/Sandbox/"),
+            ("{COPYDIR} %{wks.location}/vendor/fmod/bin/" .. " %{wks.location}bin/" .. outputdir .. "/Headless/")
+        }
+    filter {}
\ No newline at end of file
@@ -5,3 +5,60 @@ std::string AssetInstance::GetAssetName() const
 {
 	return AssetManager::Get(GetUUID()).name;
 }
+
+AssetHandle::AssetHandle(const AssetHandle& other)
+	: name(other.name), uuid(other.uuid), type(other.type), instance(other.instance), __internal_entry(other.__internal_entry), __internal_counted(other.__internal_counted)
+{
+	if (__internal_counted)
+		AssetManager::__internal_AddRef(__internal_entry);
+}
+
+AssetHandle::AssetHandle(AssetHandle&& other) noexcept
+	: name(std::move(other.name)), uuid(other.uuid), type(other.type), instance(other.instance), __internal_entry(other.__internal_entry), __internal_counted(other.__internal_counted)
+{
+	other.__internal_counted = false;
+}
+
+AssetHandle& AssetHandle::operator=(const AssetHandle& other)
+{
+	if (this == &other)
+		return *this;
+
+	// add first, other may be the last reference we hold
+	if (other.__internal_counted)
+		AssetManager::__internal_AddRef(other.__internal_entry);
+	if (__internal_counted)
+		AssetManager::__internal_Release(__internal_entry);
+
+	name = other.name;
+	uuid = other.uuid;
+	type = other.type;
+	instance = other.instance;
+	__internal_entry = other.__internal_entry;
+	__internal_counted = other.__internal_counted;
+	return *this;
+}
+
+AssetHandle& AssetHandle::operator=(AssetHandle&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	if (__internal_counted)
+		AssetManager::__internal_Release(__internal_entry);
+
+	name = std::move(other.name);
+	uuid = other.uuid;
+	type = other.type;
+	instance = other.instance;
+	__internal_entry = other.__internal_entry;
+	__internal_counted = other.__internal_counted;
+	other.__internal_counted = false;
+	return *this;
+}
+
+AssetHandle::~AssetHandle()
+{
+	if (__internal_counted)
+		AssetManager::__internal_Release(__internal_entry);
+}
@@ -25,16 +25,34 @@ enum EAssetType
 typedef uint64 AssetUUID;
 
 #define GROOVY_ASSET_EXT ".groovyasset"
+#define GROOVY_PAK_EXT ".groovypak"
 
 #define GROOVY_SHADER_VERTEX_SEGMENT    "GROOVY_SHADER_VERTEX"
 #define GROOVY_SHADER_PIXEL_SEGMENT     "GROOVY_SHADER_PIXEL"
 
-struct AssetHandle
+/*
+    Handles from AssetManager::Load are counted: while one of them (or a copy) is alive the asset stays loaded.
+    Handles from AssetManager::Get and the registry are just a view and don't keep anything loaded.
+*/
+struct CORE_API AssetHandle
 {
     std::string name;
     AssetUUID uuid = 0;
     EAssetType type = ASSET_TYPE_NONE;
     class AssetInstance* instance = nullptr;
+
+    AssetHandle() = default;
+    AssetHandle(const AssetHandle& other);
+    AssetHandle(AssetHandle&& other) noexcept;
+    AssetHandle& operator=(const AssetHandle& other);
+    AssetHandle& operator=(AssetHandle&& other) noexcept;
+    ~AssetHandle();
+
+    bool IsCounted() const { return __internal_counted; }
+
+    // for internal use
+    struct AssetEntry* __internal_entry = nullptr;
+    bool __internal_counted = false;
 };
 
 class CORE_API AssetInstance
@@ -51,6 +69,8 @@ public:
 
     virtual bool IsLoaded() const = 0;
     virtual void Load() = 0;
+    // frees what Load created, the instance itself stays valid and can be loaded again
+    virtual void Unload() = 0;
     virtual void Save() = 0;
 
     virtual void Serialize(DynamicBuffer& fileData) const = 0;
@@ -72,8 +92,57 @@ struct TextureAssetHeader
     EColorFormat format;
 };
 
+#define GROOVY_MESH_MAGIC       0x48534D47 // "GMSH", never a valid legacy vertex buffer size (always a multiple of 40)
+#define GROOVY_MESH_VERSION     2
+
+/*
+    scene asset layout:
+    magic | version | uint64 name table offset | actor count | per actor: name | blueprint uuid | Transform | actor pack | name table
+    the actor packs are v2 property packs using the scene PropertyNameTable, at the offset from the file start
+    version 1 has no name table (v1 property packs), files without the magic are legacy (version 0): they start at the actor count and store EulerTransform
+*/
+#define GROOVY_SCENE_MAGIC      0x4E435347 // "GSCN", never a valid legacy actor count
+#define GROOVY_SCENE_VERSION    2
+
+enum EMeshVertexFormat
+{
+    // MeshVertex as is, 40 bytes
+    MESH_VERTEX_FORMAT_FULL = 0,
+    // 16 bit unorm position within the mesh bounds, half float uv, rgba8 color only with MESH_ASSET_FLAG_VERTEX_COLOR: 10 or 14 bytes
+    MESH_VERTEX_FORMAT_PACKED = 1
+};
+
+enum EMeshAssetFlags
+{
+    MESH_ASSET_FLAG_NONE = 0,
+    // packed vertices have a color, white otherwise
+    MESH_ASSET_FLAG_VERTEX_COLOR = 1 << 0,
+    // indices stored as uint16 (they're relative to the submesh)
+    MESH_ASSET_FLAG_16BIT_INDICES = 1 << 1
+};
+
+/*
+    mesh asset layout:
+    MeshAssetHeader | vertices (vertexFormat) | indices | MeshAssetFile property pack
+    files without the magic are legacy: size_t vertexBufferSize | size_t indexBufferSize | MeshVertex vertices | MeshIndex indices | property pack
+*/
 struct MeshAssetHeader
 {
-    size_t vertexBufferSize;
-    size_t indexBufferSize;
+    uint32 magic;
+    uint32 version;
+    uint32 vertexFormat;
+    uint32 flags;
+    uint32 vertexCount;
+    uint32 indexCount;
+    // packed position = positionOffset + quantized position * positionScale
+    float positionOffset[3];
+    float positionScale[3];
+    // bytes in the file
+    uint64 vertexBufferSize;
+    uint64 indexBufferSize;
+    // local space bounds, version 2+ (version 1 headers stop here)
+    float boundsMin[3];
+    float boundsMax[3];
+    float sphereCenter[3];
+    float sphereRadius;
 };
\ No newline at end of file
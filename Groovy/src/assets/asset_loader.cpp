@@ -1,46 +1,93 @@
 #include "asset_loader.h"
 #include "platform/filesystem.h"
 #include "asset_manager.h"
+#include "asset_pak.h"
 #include "engine/project.h"
+#include "core/jobs.h"
+#include "core/async_io.h"
 
 #include "renderer/api/texture.h"
 #include "renderer/api/shader.h"
 
+BufferView AssetLoader::ReadAsset(const AssetHandle& handle, AssetFileStorage& storage)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	// cooked builds serve assets straight from the pak
+	if (const PakEntry* entry = AssetPak::Find(handle.uuid))
+		return AssetPak::Read(*entry, storage.buffer);
+
+	extern GroovyProject gProj;
+	std::string path = (gProj.GetAssetsPath() / handle.name).string();
+
+	// a save of this asset may still be in flight
+	AsyncIO::WaitForPath(path);
+
+	// assets are parsed front to back once
+	FileSystem::MapFileReadOnly(path, storage.mapping, FILE_ACCESS_HINT_SEQUENTIAL);
+	return storage.mapping.GetView();
+}
+
 Texture* AssetLoader::LoadTexture(const std::string& filePath)
 {
-	Buffer data;
-	FileSystem::ReadFileBinary(filePath, data);
-	TextureAssetHeader* header = data.as<TextureAssetHeader>();
+	MappedFile file;
+	FileSystem::MapFileReadOnly(filePath, file, FILE_ACCESS_HINT_SEQUENTIAL);
+	return LoadTexture(file.GetView());
+}
+
+Texture* AssetLoader::LoadTexture(BufferView data)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	size_t size = data.remaining();
+	TextureAssetHeader* header = data.read<TextureAssetHeader>(1);
 	
 	TextureSpec spec;
 	spec.width = header->width;
 	spec.height = header->height;
 	spec.format = header->format;
-	
-	return Texture::Create(spec, data.data() + sizeof(TextureAssetHeader), data.size() - sizeof(TextureAssetHeader));
+
+	// file read and parsing can happen on any thread, the gpu object is created on the main one
+	Texture* texture = nullptr;
+	Jobs::CallOnMainThread([&]() { texture = Texture::Create(spec, data.seek(), size - sizeof(TextureAssetHeader)); });
+	return texture;
 }
 
 Shader* AssetLoader::LoadShader(const std::string& filePath)
 {
-	Buffer data;
-	FileSystem::ReadFileBinary(filePath, data);
+	MappedFile file;
+	FileSystem::MapFileReadOnly(filePath, file, FILE_ACCESS_HINT_SEQUENTIAL);
+	return LoadShader(file.GetView());
+}
+
+Shader* AssetLoader::LoadShader(BufferView data)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	size_t size = data.remaining();
+	const char* source = (const char*)data.seek();
 
-	std::string_view tmpFakeStr((char*)data.data(), data.size());
+	std::string_view tmpFakeStr(source, size);
 	size_t vertexStart = tmpFakeStr.find(GROOVY_SHADER_VERTEX_SEGMENT, 0) + strlen(GROOVY_SHADER_VERTEX_SEGMENT);
 	size_t pixelStart = tmpFakeStr.find(GROOVY_SHADER_PIXEL_SEGMENT, vertexStart) + strlen(GROOVY_SHADER_PIXEL_SEGMENT);
 
 	size_t vertexSize = pixelStart - strlen(GROOVY_SHADER_PIXEL_SEGMENT) - vertexStart;
-	size_t pixelSize = data.size() - pixelStart;
-	
-	return Shader::Create(data.data() + vertexStart, vertexSize, data.data() + pixelStart, pixelSize);
+	size_t pixelSize = size - pixelStart;
+
+	Shader* shader = nullptr;
+	Jobs::CallOnMainThread([&]() { shader = Shader::Create(source + vertexStart, vertexSize, source + pixelStart, pixelSize); });
+	return shader;
 }
 
 void AssetLoader::LoadGenericAsset(AssetInstance* asset)
 {
-	extern GroovyProject gProj;
-	AssetHandle handle = AssetManager::Get(asset->GetUUID());
-	std::string absPath = (gProj.GetAssetsPath() / handle.name).string();
-	Buffer fileData;
-	FileSystem::ReadFileBinary(absPath, fileData);
+	GROOVY_PROFILE_FUNCTION();
+
+	AssetFileStorage storage;
+	BufferView fileData = ReadAsset(AssetManager::Get(asset->GetUUID()), storage);
+
+	// assets got while deserializing stay loaded with this one
+	AssetManager::__internal_BeginLoading(asset->GetUUID());
 	asset->Deserialize(fileData);
-}
\ No newline at end of file
+	AssetManager::__internal_EndLoading();
+}
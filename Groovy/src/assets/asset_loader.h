@@ -1,14 +1,27 @@
 #pragma once
 
 #include "asset.h"
+#include "platform/filesystem.h"
+
+// backs the view returned by AssetLoader::ReadAsset
+struct AssetFileStorage
+{
+	MappedFile mapping;
+	Buffer buffer;
+};
 
 // raw asset loader
 class CORE_API AssetLoader
 {
 public:
 
+	// the asset file content, mapped (or a view into the mounted pak when the asset is cooked), valid as long as storage is
+	static BufferView ReadAsset(const AssetHandle& handle, AssetFileStorage& storage);
+
 	static class Texture* LoadTexture(const std::string& filePath);
+	static class Texture* LoadTexture(BufferView data);
 	static class Shader* LoadShader(const std::string& filePath);
+	static class Shader* LoadShader(BufferView data);
 
 	static void LoadGenericAsset(class AssetInstance* asset);
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "platform/filesystem.h"
 #include "engine/project.h"
 #include "asset_loader.h"
+#include "asset_pak.h"
 #include <random>
 #include "renderer/api/renderer_api.h"
 #include "renderer/api/texture.h"
@@ -13,11 +14,45 @@
 #include "audio/audio_clip.h"
 #include "utils/string_utils.h"
 #include "audio/audio_clip.h"
+#include "core/jobs.h"
+#include "core/async_io.h"
+#include "classes/class_db.h"
+#include "runtime/object_allocator.h"
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+extern ClassDB gClassDB;
+
+// bookkeeping behind every registry asset, handles point to it
+struct AssetEntry
+{
+	// in sAssets
+	uint32 assetIndex = 0;
+	std::atomic<int32> refs = 0;
+	// when the asset got loaded or lost its last reference, the grace period starts from here
+	std::atomic<uint64> idleSinceNs = 0;
+	// held while loading or unloading, recursive because loading an asset loads what it references
+	std::recursive_mutex lock;
+	// counted handles to what the asset referenced while loading
+	std::vector<AssetHandle> dependencies;
+	// default assets
+	bool permanent = false;
+};
 
+// both hold uncounted handles
 static std::map<AssetUUID, AssetHandle> sAssetRegistry;
 static std::vector<AssetHandle> sAssets;
 
 static constexpr uint32 DEFAULT_ASSETS_COUNT = 4;
+static constexpr double DEFAULT_UNLOAD_GRACE_PERIOD = 10.0;
+
+static bool sKeepEverythingLoaded = false;
+static uint64 sUnloadGracePeriodNs = (uint64)(DEFAULT_UNLOAD_GRACE_PERIOD * 1000000000.0);
+
+// assets being deserialized on this thread, innermost last
+static thread_local std::vector<AssetEntry*> tLoadingAssets;
 
 // random stuff
 static std::random_device sRandomDevice;
@@ -38,15 +73,15 @@ CORE_API Mesh* DEFAULT_CUBE = nullptr;
 
 static AssetInstance* InstantiateAsset(const AssetHandle& handle)
 {
-	std::string absFilePath = (gProj.GetAssetsPath() / handle.name).string();
+	AssetFileStorage storage;
 
 	switch (handle.type)
 	{
 		case ASSET_TYPE_TEXTURE:
-			return AssetLoader::LoadTexture(absFilePath);
+			return AssetLoader::LoadTexture(AssetLoader::ReadAsset(handle, storage));
 
 		case ASSET_TYPE_SHADER:
-			return AssetLoader::LoadShader(absFilePath);
+			return AssetLoader::LoadShader(AssetLoader::ReadAsset(handle, storage));
 
 		case ASSET_TYPE_MATERIAL:
 			return new Material();
@@ -65,14 +100,312 @@ static AssetInstance* InstantiateAsset(const AssetHandle& handle)
 
 		case ASSET_TYPE_AUDIO_CLIP:
 			return new AudioClip();
+
+		default:
+			break;
 	}
 
-	checkslowf(0, "Trying to instantiate an unknown type asset??!?!?");
+	checkslowf(0, "Trying to instantiate an unknown type asset!");
 	return nullptr;
 }
 
+#if !BUILD_SHIPPING
+
+static const char* GetAssetTypeName(EAssetType type)
+{
+	switch (type)
+	{
+		case ASSET_TYPE_TEXTURE:			return "texture";
+		case ASSET_TYPE_SHADER:				return "shader";
+		case ASSET_TYPE_AUDIO_CLIP:			return "audio clip";
+		case ASSET_TYPE_MATERIAL:			return "material";
+		case ASSET_TYPE_MESH:				return "mesh";
+		case ASSET_TYPE_BLUEPRINT:			return "blueprint";
+		case ASSET_TYPE_ACTOR_BLUEPRINT:	return "actor blueprint";
+		case ASSET_TYPE_SCENE:				return "scene";
+		default:							break;
+	}
+	return "none";
+}
+
+#endif
+
+static uint64 GetLoadTimeNs()
+{
+	return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static AssetHandle& AddAsset(const AssetHandle& handle, bool permanent)
+{
+	AssetEntry* entry = new AssetEntry();
+	entry->assetIndex = (uint32)sAssets.size();
+	entry->permanent = permanent;
+
+	AssetHandle& asset = sAssets.emplace_back(handle);
+	asset.__internal_entry = entry;
+	asset.__internal_counted = false;
+	sAssetRegistry[asset.uuid] = asset;
+	return asset;
+}
+
+// raw assets are the gpu objects themselves, they come and go with loads and unloads
+static void PublishInstance(AssetEntry* entry, AssetInstance* instance)
+{
+	AssetHandle& asset = sAssets[entry->assetIndex];
+	asset.instance = instance;
+	sAssetRegistry.find(asset.uuid)->second.instance = instance;
+}
+
+static bool IsRawAsset(EAssetType type)
+{
+	return type == ASSET_TYPE_TEXTURE || type == ASSET_TYPE_SHADER;
+}
+
+static bool IsAssetLoaded(const AssetHandle& handle)
+{
+	// built in code, never go through Load
+	if (handle.__internal_entry->permanent)
+		return true;
+
+	if (IsRawAsset(handle.type))
+		return handle.instance != nullptr;
+	return handle.instance && handle.instance->IsLoaded();
+}
+
+// entry lock must be held
+static void LoadAsset(AssetEntry* entry)
+{
+	AssetHandle& handle = sAssets[entry->assetIndex];
+
+	if (IsRawAsset(handle.type))
+	{
+		AssetInstance* instance = InstantiateAsset(handle);
+		instance->__internal_SetUUID(handle.uuid);
+		PublishInstance(entry, instance);
+	}
+	else
+	{
+		handle.instance->Load();
+	}
+
+	entry->idleSinceNs.store(GetLoadTimeNs(), std::memory_order_relaxed);
+}
+
+// main thread only
+static void UnloadAsset(AssetEntry* entry)
+{
+	std::vector<AssetHandle> dependencies;
+	{
+		std::lock_guard<std::recursive_mutex> lock(entry->lock);
+
+		// somebody took a reference in the meantime
+		if (entry->refs.load(std::memory_order_acquire))
+			return;
+
+		AssetHandle& handle = sAssets[entry->assetIndex];
+		if (IsRawAsset(handle.type))
+		{
+			delete handle.instance;
+			PublishInstance(entry, nullptr);
+		}
+		else
+		{
+			handle.instance->Unload();
+		}
+
+		dependencies.swap(entry->dependencies);
+	}
+
+	// released outside of the lock, dependencies start their own grace period
+}
+
+// unload candidates by instance, set to null when an object still points to them
+typedef std::unordered_map<AssetInstance*, AssetEntry*> AssetRefsScan;
+
+static void ScanObjectAssetRefs(GroovyObject* obj, void* userData)
+{
+	AssetRefsScan& candidates = *(AssetRefsScan*)userData;
+
+	for (const GroovyProperty& prop : gClassDB[obj->GetClass()])
+	{
+		if (prop.type != PROPERTY_TYPE_ASSET_REF)
+			continue;
+
+		byte* propData = (byte*)obj + prop.offset;
+		uint32 count = prop.arrayCount;
+		if (prop.flags & PROPERTY_FLAG_IS_DYNAMIC_ARRAY)
+		{
+			DynamicArrayPtr dap = GroovyProperty_GetDynamicArrayPtr(prop.type);
+			count = (uint32)dap.size(propData);
+			propData = (byte*)dap.data(propData);
+		}
+
+		AssetInstance** assets = (AssetInstance**)propData;
+		for (uint32 i = 0; i < count; i++)
+		{
+			auto it = assets[i] ? candidates.find(assets[i]) : candidates.end();
+			if (it != candidates.end())
+				it->second = nullptr;
+		}
+	}
+}
+
+// the asset loading on this thread (if any) keeps entry loaded from now on
+static void RecordDependency(AssetEntry* entry, const AssetHandle& handle)
+{
+	if (tLoadingAssets.empty() || !tLoadingAssets.back() || tLoadingAssets.back() == entry)
+		return;
+
+	std::vector<AssetHandle>& dependencies = tLoadingAssets.back()->dependencies;
+	for (const AssetHandle& dependency : dependencies)
+		if (dependency.__internal_entry == entry)
+			return;
+
+	AssetHandle& dependency = dependencies.emplace_back(handle);
+	dependency.__internal_counted = true;
+	AssetManager::__internal_AddRef(entry);
+}
+
+struct AssetLoadJob
+{
+	uint32 assetIndex;
+	uint32 threadIndex;
+	uint64 startNs, endNs;
+};
+
+static void LoadRegistryAsset(void* data)
+{
+	AssetLoadJob* job = (AssetLoadJob*)data;
+	AssetEntry* entry = sAssets[job->assetIndex].__internal_entry;
+
+	job->threadIndex = Jobs::GetCurrentThreadIndex();
+	job->startNs = GetLoadTimeNs();
+
+	// textures and shaders are created by their loader, the instance is published before any dependent asset starts
+	std::lock_guard<std::recursive_mutex> lock(entry->lock);
+	if (!IsAssetLoaded(sAssets[job->assetIndex]))
+		LoadAsset(entry);
+
+	job->endNs = GetLoadTimeNs();
+}
+
+static void ReportAssetLoads(std::vector<AssetLoadJob>& jobs, uint64 startNs, uint64 endNs)
+{
+#if !BUILD_SHIPPING
+
+	if (jobs.empty())
+		return;
+
+	std::sort(jobs.begin(), jobs.end(), [](const AssetLoadJob& a, const AssetLoadJob& b) { return a.endNs - a.startNs > b.endNs - b.startNs; });
+
+	uint64 workNs = 0;
+	for (const AssetLoadJob& job : jobs)
+		workNs += job.endNs - job.startNs;
+
+	double wallMs = (double)(endNs - startNs) / 1000000.0;
+	double workMs = (double)workNs / 1000000.0;
+	GROOVY_LOG_INFO
+	(
+		"Loaded %u assets in %.2fms on %u threads (%.2fms of loading work, %.2fx)",
+		(uint32)jobs.size(), wallMs, Jobs::GetThreadCount(), workMs, wallMs > 0.0 ? workMs / wallMs : 1.0
+	);
+
+	const AssetLoadJob& slowest = jobs[0];
+	GROOVY_LOG_INFO("Slowest asset: %s (%.2fms)", sAssets[slowest.assetIndex].name.c_str(), (double)(slowest.endNs - slowest.startNs) / 1000000.0);
+
+	// per asset times, slowest first, next to the profiler capture when one was asked for
+	if (!Profiler::IsCapturing())
+		return;
+
+	std::string report = "asset,type,thread,start_ms,duration_ms\n";
+	char line[128];
+	for (const AssetLoadJob& job : jobs)
+	{
+		const AssetHandle& handle = sAssets[job.assetIndex];
+		report += handle.name;
+		snprintf
+		(
+			line, sizeof(line), ",%s,%u,%.3f,%.3f\n", GetAssetTypeName(handle.type), job.threadIndex,
+			(double)(job.startNs - startNs) / 1000000.0, (double)(job.endNs - job.startNs) / 1000000.0
+		);
+		report += line;
+	}
+
+	std::filesystem::path reportPath = std::filesystem::path(Profiler::GetCaptureDirectory()) / "asset_loads.csv";
+	std::filesystem::create_directories(reportPath.parent_path());
+	if (FileSystem::WriteFileBinary(reportPath.string(), report.data(), report.size()) != FILE_OPEN_RESULT_OK)
+		GROOVY_LOG_WARN("Unable to write %s", reportPath.string().c_str());
+
+#endif
+}
+
+/*
+	Registry assets load on the job threads: textures, shaders and audio clips first, then materials (they read their shader),
+	then meshes. Gpu objects are created on the main thread while it waits (see Jobs::CallOnMainThread).
+	Blueprints instantiate objects and the object allocator is main thread only, they load last on the main thread.
+	Only runs when everything is kept loaded (editor). Otherwise assets load on first use (GetInstance / Load) on the thread
+	asking for them, so a runtime scene load still loads what it references one asset after the other.
+*/
+static void LoadRegistryAssets()
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	// jobs point into this, no reallocation once they are queued
+	std::vector<AssetLoadJob> jobs;
+	jobs.reserve(sAssets.size());
+
+	std::vector<JobDecl> rawAssets, materials, meshes;
+	std::vector<uint32> blueprints;
+
+	for (uint32 i = DEFAULT_ASSETS_COUNT; i < sAssets.size(); i++)
+	{
+		const AssetHandle& handle = sAssets[i];
+		if (handle.type == ASSET_TYPE_SCENE || IsAssetLoaded(handle))
+			continue;
+
+		if (handle.type == ASSET_TYPE_BLUEPRINT || handle.type == ASSET_TYPE_ACTOR_BLUEPRINT)
+		{
+			blueprints.push_back(i);
+			continue;
+		}
+
+		AssetLoadJob& job = jobs.emplace_back();
+		job.assetIndex = i;
+
+		JobDecl decl = { LoadRegistryAsset, &job };
+		switch (handle.type)
+		{
+			case ASSET_TYPE_MATERIAL:	materials.push_back(decl);	break;
+			case ASSET_TYPE_MESH:		meshes.push_back(decl);		break;
+			default:					rawAssets.push_back(decl);	break;
+		}
+	}
+
+	uint64 startNs = GetLoadTimeNs();
+
+	JobCounter rawAssetsCounter, materialsCounter, meshesCounter;
+	Jobs::Run(rawAssets.data(), (uint32)rawAssets.size(), &rawAssetsCounter);
+	Jobs::Run(materials.data(), (uint32)materials.size(), &materialsCounter, &rawAssetsCounter);
+	Jobs::Run(meshes.data(), (uint32)meshes.size(), &meshesCounter, &materialsCounter);
+
+	Jobs::Wait(&rawAssetsCounter);
+	Jobs::Wait(&materialsCounter);
+	Jobs::Wait(&meshesCounter);
+
+	for (uint32 assetIndex : blueprints)
+	{
+		AssetLoadJob& job = jobs.emplace_back();
+		job.assetIndex = assetIndex;
+		LoadRegistryAsset(&job);
+	}
+
+	ReportAssetLoads(jobs, startNs, GetLoadTimeNs());
+}
+
 void AssetManager::Init()
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	// default assets
 	{
 		// default texture
@@ -92,9 +425,14 @@ void AssetManager::Init()
 				case RENDERER_API_D3D11:
 					shaderFile = "default_shader.hlsl";
 					break;
+				default:
+					break;
 			}
 
-			DEFAULT_SHADER = AssetLoader::LoadShader((std::filesystem::path("shaders") / shaderFile).string());
+			if (!shaderFile.empty())
+				DEFAULT_SHADER = AssetLoader::LoadShader((std::filesystem::path("shaders") / shaderFile).string());
+			else
+				DEFAULT_SHADER = Shader::Create(nullptr, 0, nullptr, 0); // gpu-free backends have no shader source to compile
 		}
 		// default material
 		{
@@ -129,6 +467,8 @@ void AssetManager::Init()
 			mats.push_back(DEFAULT_MATERIAL);
 
 			DEFAULT_CUBE = new Mesh(vBuffer, iBuffer, submeshes, mats);
+			// unit cube centered at the origin
+			DEFAULT_CUBE->__internal_SetBounds({ { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } }, { { 0.0f, 0.0f, 0.0f }, 0.8660254f });
 		}
 ;
 		AssetHandle tmpHandle;
@@ -139,8 +479,7 @@ void AssetManager::Init()
 		tmpHandle.instance = DEFAULT_TEXTURE;
 		tmpHandle.instance->__internal_SetUUID(1);
 
-		sAssets.push_back(tmpHandle);
-		sAssetRegistry[tmpHandle.uuid] = tmpHandle;
+		AddAsset(tmpHandle, true);
 
 		tmpHandle.name = "DEFAULT_SHADER";
 		tmpHandle.type = ASSET_TYPE_SHADER;
@@ -148,8 +487,7 @@ void AssetManager::Init()
 		tmpHandle.instance = DEFAULT_SHADER;
 		tmpHandle.instance->__internal_SetUUID(2);
 
-		sAssets.push_back(tmpHandle);
-		sAssetRegistry[tmpHandle.uuid] = tmpHandle;
+		AddAsset(tmpHandle, true);
 
 		tmpHandle.name = "DEFAULT_MATERIAL";
 		tmpHandle.type = ASSET_TYPE_MATERIAL;
@@ -157,8 +495,7 @@ void AssetManager::Init()
 		tmpHandle.instance = DEFAULT_MATERIAL;
 		tmpHandle.instance->__internal_SetUUID(3);
 
-		sAssets.push_back(tmpHandle);
-		sAssetRegistry[tmpHandle.uuid] = tmpHandle;
+		AddAsset(tmpHandle, true);
 
 		tmpHandle.name = "DEFAULT_CUBE";
 		tmpHandle.type = ASSET_TYPE_MESH;
@@ -166,12 +503,36 @@ void AssetManager::Init()
 		tmpHandle.instance = DEFAULT_CUBE;
 		tmpHandle.instance->__internal_SetUUID(4);
 
-		sAssets.push_back(tmpHandle);
-		sAssetRegistry[tmpHandle.uuid] = tmpHandle;
+		AddAsset(tmpHandle, true);
 
 		checkslowf((uint32)sAssetRegistry.size() == DEFAULT_ASSETS_COUNT, "Default assets count mismatch!");
 	}
 
+	if (AssetPak::IsMounted())
+	{
+		// the pak table of contents is the registry, every entry is there by construction
+		for (uint32 i = 0; i < AssetPak::GetEntriesCount(); i++)
+		{
+			const PakEntry& entry = AssetPak::GetEntry(i);
+			AssetHandle asset;
+			asset.name = AssetPak::GetEntryName(entry);
+			asset.uuid = entry.uuid;
+			asset.type = (EAssetType)entry.type;
+
+			if (!IsRawAsset(asset.type))
+			{
+				asset.instance = InstantiateAsset(asset);
+				asset.instance->__internal_SetUUID(asset.uuid);
+			}
+
+			AddAsset(asset, false);
+		}
+
+		if (sKeepEverythingLoaded)
+			LoadRegistryAssets();
+		return;
+	}
+
 	Buffer registryFile;
 	FileSystem::ReadFileBinary(gProj.GetAssetRegistryPath().string(), registryFile);
 
@@ -202,24 +563,191 @@ void AssetManager::Init()
 		}
 		else
 		{
-			AssetHandle& asset = sAssets.emplace_back(registry[i]);
-			asset.instance = InstantiateAsset(asset);
-			asset.instance->__internal_SetUUID(asset.uuid);
+			// textures and shaders are instantiated by their loader, the rest loads on first use
+			AssetHandle asset = registry[i];
+			if (!IsRawAsset(asset.type))
+			{
+				asset.instance = InstantiateAsset(asset);
+				asset.instance->__internal_SetUUID(asset.uuid);
+			}
 
-			sAssetRegistry[asset.uuid] = asset;
+			AddAsset(asset, false);
 		}
 	}
 
-	// load assets
-	for(uint32 i = DEFAULT_ASSETS_COUNT; i < sAssets.size(); i++)
-		if (sAssets[i].type != ASSET_TYPE_SCENE && !sAssets[i].instance->IsLoaded())
-			sAssets[i].instance->Load();
+	if (sKeepEverythingLoaded)
+		LoadRegistryAssets();
 }
 
 void AssetManager::Shutdown()
 {
+	// drop the references between assets first, destructors may still release handles
+	for (AssetHandle& handle : sAssets)
+		handle.__internal_entry->dependencies.clear();
+
 	for (AssetHandle& handle : sAssets)
 		delete handle.instance;
+
+	for (AssetHandle& handle : sAssets)
+		delete handle.__internal_entry;
+
+	sAssets.clear();
+	sAssetRegistry.clear();
+}
+
+void AssetManager::Update()
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	if (sKeepEverythingLoaded)
+		return;
+
+	uint64 now = GetLoadTimeNs();
+	AssetRefsScan candidates;
+	for (uint32 i = DEFAULT_ASSETS_COUNT; i < sAssets.size(); i++)
+	{
+		const AssetHandle& handle = sAssets[i];
+		AssetEntry* entry = handle.__internal_entry;
+
+		// scenes are loaded and unloaded explicitly
+		if (handle.type == ASSET_TYPE_SCENE || entry->permanent || entry->refs.load(std::memory_order_acquire))
+			continue;
+
+		if (!IsAssetLoaded(handle) || now - entry->idleSinceNs.load(std::memory_order_relaxed) < sUnloadGracePeriodNs)
+			continue;
+
+		candidates[handle.instance] = entry;
+	}
+
+	if (candidates.empty())
+		return;
+
+	/*
+		Handles only count what asked for them, objects got their asset pointers by deserialization or property copies
+		(actors spawned from blueprints) or straight from code. Asset ref properties of the live objects keep their assets loaded,
+		checked here once the rest is gone instead of counted on every write.
+	*/
+	std::vector<AssetEntry*> entries;
+	entries.reserve(candidates.size());
+	for (const auto& [instance, entry] : candidates)
+		entries.push_back(entry);
+
+	ObjectAllocator::ForEachLiveObject(ScanObjectAssetRefs, &candidates);
+
+	for (AssetEntry* entry : entries)
+	{
+		AssetInstance* instance = sAssets[entry->assetIndex].instance;
+		if (candidates[instance])
+			UnloadAsset(entry);
+		else
+			entry->idleSinceNs.store(now, std::memory_order_relaxed); // still pointed to, checked again after another grace period
+	}
+}
+
+AssetInstance* AssetManager::GetInstance(AssetUUID uuid)
+{
+	if (uuid == 0)
+		return nullptr;
+
+	auto it = sAssetRegistry.find(uuid);
+	if (it == sAssetRegistry.end())
+		return nullptr;
+
+	const AssetHandle& handle = it->second;
+	AssetEntry* entry = handle.__internal_entry;
+
+	std::lock_guard<std::recursive_mutex> lock(entry->lock);
+	if (handle.type != ASSET_TYPE_SCENE)
+	{
+		if (!IsAssetLoaded(handle))
+			LoadAsset(entry);
+
+		RecordDependency(entry, handle);
+	}
+
+	return handle.instance;
+}
+
+AssetHandle AssetManager::Load(AssetUUID uuid)
+{
+	if (uuid == 0)
+		return {};
+
+	auto it = sAssetRegistry.find(uuid);
+	if (it == sAssetRegistry.end())
+		return {};
+
+	AssetEntry* entry = it->second.__internal_entry;
+
+	// referenced before the lock goes away, the main thread can't unload it in between
+	std::lock_guard<std::recursive_mutex> lock(entry->lock);
+	GetInstance(uuid);
+
+	AssetHandle handle = it->second;
+	handle.__internal_counted = true;
+	__internal_AddRef(entry);
+	return handle;
+}
+
+void AssetManager::SetKeepEverythingLoaded(bool keep)
+{
+	sKeepEverythingLoaded = keep;
+}
+
+void AssetManager::SetUnloadGracePeriod(double seconds)
+{
+	sUnloadGracePeriodNs = (uint64)(seconds * 1000000000.0);
+}
+
+uint32 AssetManager::GetLoadedAssetsCount()
+{
+	uint32 count = 0;
+	for (const AssetHandle& handle : sAssets)
+		if (IsAssetLoaded(handle))
+			count++;
+	return count;
+}
+
+void AssetManager::__internal_AddRef(AssetEntry* entry)
+{
+	entry->refs.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void AssetManager::__internal_Release(AssetEntry* entry)
+{
+	if (entry->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		entry->idleSinceNs.store(GetLoadTimeNs(), std::memory_order_relaxed);
+}
+
+void AssetManager::__internal_BeginLoading(AssetUUID uuid)
+{
+	auto it = sAssetRegistry.find(uuid);
+	AssetEntry* entry = it != sAssetRegistry.end() ? it->second.__internal_entry : nullptr;
+
+	// a reload captures its references again
+	if (entry)
+		entry->dependencies.clear();
+
+	tLoadingAssets.push_back(entry);
+}
+
+void AssetManager::__internal_EndLoading()
+{
+	check(!tLoadingAssets.empty());
+	tLoadingAssets.pop_back();
+}
+
+void AssetManager::__internal_ReleaseDependencies(AssetUUID uuid)
+{
+	auto it = sAssetRegistry.find(uuid);
+	if (it == sAssetRegistry.end())
+		return;
+
+	std::vector<AssetHandle> dependencies;
+	{
+		std::lock_guard<std::recursive_mutex> lock(it->second.__internal_entry->lock);
+		dependencies.swap(it->second.__internal_entry->dependencies);
+	}
 }
 
 AssetHandle AssetManager::Get(AssetUUID uuid)
@@ -227,14 +755,18 @@ AssetHandle AssetManager::Get(AssetUUID uuid)
 	if (uuid == 0)
 		return {};
 
-	if(sAssetRegistry.find(uuid) != sAssetRegistry.end())
-		return sAssetRegistry[uuid];
-	
+	// read only, assets loading on the job threads resolve their references through here
+	auto it = sAssetRegistry.find(uuid);
+	if (it != sAssetRegistry.end())
+		return it->second;
+
 	return {};
 }
 
 void AssetManager::SaveRegistry()
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	DynamicBuffer registryFile;
 
 	registryFile.push<uint32>((uint32)sAssets.size() - DEFAULT_ASSETS_COUNT);
@@ -246,7 +778,7 @@ void AssetManager::SaveRegistry()
 		registryFile.push(sAssets[i].type);
 	}
 
-	FileSystem::WriteFileBinary(gProj.GetAssetRegistryPath().string(), registryFile);
+	AsyncIO::WriteAsync(gProj.GetAssetRegistryPath().string(), std::move(registryFile));
 }
 
 const std::map<AssetUUID, AssetHandle>& AssetManager::GetRegistry()
@@ -293,30 +825,41 @@ AssetHandle AssetManager::Editor_Add(const std::string& name, EAssetType type, A
 	newHandle.instance = instance ? instance : InstantiateAsset(newHandle);
 	newHandle.instance->__internal_SetUUID(newUUID);
 
-	sAssets.push_back(newHandle);
-	sAssetRegistry[newUUID] = newHandle;
+	AssetHandle& asset = AddAsset(newHandle, false);
 
 	if (!instance)
 		newHandle.instance->Load();
 
 	SaveRegistry();
 
-	return newHandle;
+	return asset;
 }
 
 void AssetManager::Editor_Remove(AssetHandle handle)
 {
 	checkslow(handle.uuid);
 
+	AssetEntry* entry = sAssetRegistry[handle.uuid].__internal_entry;
 	sAssetRegistry.erase(handle.uuid);
 
-	sAssets.erase(std::find_if(sAssets.begin(), sAssets.end(), [=](AssetHandle& h) { return h.uuid == handle.uuid; }));
+	sAssets.erase(sAssets.begin() + entry->assetIndex);
+	for (uint32 i = entry->assetIndex; i < sAssets.size(); i++)
+		sAssets[i].__internal_entry->assetIndex = i;
 
 	for (const AssetHandle& a : sAssets)
-		a.instance->Editor_FixDependencyDeletion(handle);
+	{
+		if (a.instance)
+			a.instance->Editor_FixDependencyDeletion(handle);
+
+		std::vector<AssetHandle>& dependencies = a.__internal_entry->dependencies;
+		dependencies.erase(std::remove_if(dependencies.begin(), dependencies.end(), [=](const AssetHandle& h) { return h.__internal_entry == entry; }), dependencies.end());
+	}
 
 	delete handle.instance;
 
+	// counted handles to it may still be around, the entry is leaked on purpose
+	entry->dependencies.clear();
+
 	SaveRegistry();
 }
 
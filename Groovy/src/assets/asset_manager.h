@@ -3,20 +3,44 @@
 #include "asset.h"
 #include <map>
 
+/*
+	Registry assets load on first use and unload once nothing references them for a while (see SetUnloadGracePeriod).
+	Load returns a counted handle that keeps the asset loaded, Get returns views only.
+	Assets referenced while another asset loads (Get<T> during Deserialize) stay loaded as long as that asset does.
+	Live objects pointing to an asset through an asset ref property keep it loaded too, whatever put the pointer there.
+
+	AssetHandle mesh = AssetManager::Load(meshUUID);
+	Texture* texture = AssetManager::Get<Texture>(textureUUID);	// loaded, not kept alive
+*/
 class CORE_API AssetManager
 {
 public:
 	static void Init();
 	static void Shutdown();
 
+	// once per frame on the main thread, unloads what has been unreferenced for longer than the grace period
+	static void Update();
+
+	// loads the asset if needed, the handle keeps it loaded
+	static AssetHandle Load(AssetUUID uuid);
+
+	// uncounted view, instance can be null or not loaded
 	static AssetHandle Get(AssetUUID uuid);
 
+	// loads the asset if needed (scenes are loaded explicitly)
+	static AssetInstance* GetInstance(AssetUUID uuid);
+
 	template<typename T>
 	static T* Get(AssetUUID uuid)
 	{
-		return (T*)Get(uuid).instance;
+		return (T*)GetInstance(uuid);
 	}
 
+	// the editor keeps everything, Init loads the whole registry and nothing is unloaded
+	static void SetKeepEverythingLoaded(bool keep);
+	static void SetUnloadGracePeriod(double seconds);
+	static uint32 GetLoadedAssetsCount();
+
 	static void SaveRegistry();
 
 	static const std::map<AssetUUID, AssetHandle>& GetRegistry();
@@ -32,4 +56,12 @@ public:
 	static void Editor_Rename(AssetHandle handle, const std::string& newName);
 
 #endif
+
+	// for internal use
+	static void __internal_AddRef(struct AssetEntry* entry);
+	static void __internal_Release(struct AssetEntry* entry);
+	// everything got with Get<T> in between becomes a dependency of uuid
+	static void __internal_BeginLoading(AssetUUID uuid);
+	static void __internal_EndLoading();
+	static void __internal_ReleaseDependencies(AssetUUID uuid);
 };
\ No newline at end of file
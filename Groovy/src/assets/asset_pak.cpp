@@ -0,0 +1,372 @@
+#include "asset_pak.h"
+#include "platform/filesystem.h"
+
+#include <algorithm>
+
+// mapped for as long as it's mounted, entries are views into it
+static MappedFile sPakFile;
+static const PakHeader* sHeader = nullptr;
+static const PakEntry* sEntries = nullptr;
+static const char* sNames = nullptr;
+
+// lz block format: sequences of [token][literals length][literals][offset][match length],
+// the token holds 4 bits of literals length and 4 bits of match length, 15 means more length bytes follow.
+// the last sequence only has literals
+
+#define LZ_MIN_MATCH	4
+// a compressed byte decodes to 255 bytes at most (a length byte of 255), bounds the sizes Mount accepts
+#define LZ_MAX_EXPANSION	255
+#define LZ_MAX_OFFSET	0xFFFF
+#define LZ_HASH_BITS	16
+
+static bool ReadLZLength(const byte*& in, const byte* inEnd, size_t& length)
+{
+	uint8 value;
+	do
+	{
+		if (in == inEnd)
+			return false;
+		value = *in++;
+		length += value;
+	} while (value == 255);
+	return true;
+}
+
+static bool DecompressLZ(const byte* src, size_t srcSize, byte* dst, size_t dstSize)
+{
+	const byte* in = src;
+	const byte* inEnd = src + srcSize;
+	byte* out = dst;
+	byte* outEnd = dst + dstSize;
+
+	while (in < inEnd)
+	{
+		uint8 token = *in++;
+
+		size_t literalsLength = token >> 4;
+		if (literalsLength == 15 && !ReadLZLength(in, inEnd, literalsLength))
+			return false;
+		if (literalsLength > (size_t)(inEnd - in) || literalsLength > (size_t)(outEnd - out))
+			return false;
+
+		memcpy(out, in, literalsLength);
+		in += literalsLength;
+		out += literalsLength;
+
+		// last sequence
+		if (in == inEnd)
+			break;
+
+		if (inEnd - in < 2)
+			return false;
+		size_t offset = in[0] | ((size_t)in[1] << 8);
+		in += 2;
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLZLength(in, inEnd, matchLength))
+			return false;
+		matchLength += LZ_MIN_MATCH;
+
+		if (!offset || offset > (size_t)(out - dst) || matchLength > (size_t)(outEnd - out))
+			return false;
+
+		const byte* match = out - offset;
+		if (offset >= matchLength)
+		{
+			memcpy(out, match, matchLength);
+		}
+		else
+		{
+			// overlapping, repeats the last offset bytes
+			for (size_t i = 0; i < matchLength; i++)
+				out[i] = match[i];
+		}
+		out += matchLength;
+	}
+
+	return out == outEnd;
+}
+
+bool AssetPak::Mount(const std::string& path)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	Unmount();
+
+	// entries are read in whatever order assets are needed
+	if (FileSystem::MapFileReadOnly(path, sPakFile, FILE_ACCESS_HINT_RANDOM) != FILE_OPEN_RESULT_OK)
+		return false;
+
+	const byte* pakData = sPakFile.GetData();
+	const PakHeader* header = (const PakHeader*)pakData;
+	uint64 pakSize = sPakFile.GetSize();
+
+	bool valid = pakSize >= sizeof(PakHeader) && header->magic == GROOVY_PAK_MAGIC && header->version == GROOVY_PAK_VERSION;
+	valid = valid && header->tocOffset <= pakSize && (pakSize - header->tocOffset) / sizeof(PakEntry) >= header->entriesCount;
+	valid = valid && header->namesOffset <= pakSize && pakSize - header->namesOffset >= header->namesSize;
+	valid = valid && header->namesSize && pakData[header->namesOffset + header->namesSize - 1] == '\0';
+
+	if (valid)
+	{
+		const PakEntry* entries = (const PakEntry*)(pakData + header->tocOffset);
+		for (uint32 i = 0; i < header->entriesCount && valid; i++)
+		{
+			const PakEntry& entry = entries[i];
+			valid = entry.offset <= pakSize && pakSize - entry.offset >= entry.size && entry.nameOffset < header->namesSize;
+			// the size Read allocates for, can't be more than the compressed data decodes to
+			valid = valid && (!(entry.flags & PAK_ENTRY_FLAG_COMPRESSED) || entry.uncompressedSize <= entry.size * LZ_MAX_EXPANSION);
+		}
+	}
+
+	if (!valid)
+	{
+		GROOVY_LOG_ERR("%s is not a valid asset pak", path.c_str());
+		sPakFile.Unmap();
+		return false;
+	}
+
+	sHeader = header;
+	sEntries = (const PakEntry*)(pakData + header->tocOffset);
+	sNames = (const char*)(pakData + header->namesOffset);
+
+	GROOVY_LOG_INFO("Mounted %s, %u assets", path.c_str(), sHeader->entriesCount);
+	return true;
+}
+
+void AssetPak::Unmount()
+{
+	sHeader = nullptr;
+	sEntries = nullptr;
+	sNames = nullptr;
+	sPakFile.Unmap();
+}
+
+bool AssetPak::IsMounted()
+{
+	return sHeader != nullptr;
+}
+
+uint32 AssetPak::GetEntriesCount()
+{
+	return sHeader ? sHeader->entriesCount : 0;
+}
+
+const PakEntry& AssetPak::GetEntry(uint32 index)
+{
+	check(sHeader && index < sHeader->entriesCount);
+	return sEntries[index];
+}
+
+const char* AssetPak::GetEntryName(const PakEntry& entry)
+{
+	return sNames + entry.nameOffset;
+}
+
+const PakEntry* AssetPak::Find(AssetUUID uuid)
+{
+	if (!sHeader)
+		return nullptr;
+
+	const PakEntry* end = sEntries + sHeader->entriesCount;
+	const PakEntry* entry = std::lower_bound(sEntries, end, uuid, [](const PakEntry& e, AssetUUID id) { return e.uuid < id; });
+	return entry != end && entry->uuid == uuid ? entry : nullptr;
+}
+
+BufferView AssetPak::Read(const PakEntry& entry, Buffer& storage)
+{
+	byte* data = (byte*)sPakFile.GetData() + entry.offset;
+
+	// the whole entry is about to be read, one read ahead instead of a fault per page
+	sPakFile.Prefetch(entry.offset, entry.size);
+
+	if (!(entry.flags & PAK_ENTRY_FLAG_COMPRESSED))
+		return BufferView(data, entry.size);
+
+	storage.resize(entry.uncompressedSize);
+	if (!DecompressLZ(data, entry.size, storage.data(), entry.uncompressedSize))
+	{
+		GROOVY_LOG_ERR("Pak entry '%s' is corrupted", GetEntryName(entry));
+		storage.free();
+		return BufferView(nullptr, 0);
+	}
+
+	return BufferView(storage);
+}
+
+#if !BUILD_SHIPPING
+
+// only cooking compresses
+static uint32 ReadUInt32(const byte* ptr)
+{
+	uint32 value;
+	memcpy(&value, ptr, sizeof(uint32));
+	return value;
+}
+
+static void PushLZLength(DynamicBuffer& out, size_t length)
+{
+	while (length >= 255)
+	{
+		out.push<uint8>(255);
+		length -= 255;
+	}
+	out.push<uint8>((uint8)length);
+}
+
+static void PushLZSequence(DynamicBuffer& out, const byte* literals, size_t literalsLength, size_t offset, size_t matchLength)
+{
+	size_t matchCode = matchLength ? matchLength - LZ_MIN_MATCH : 0;
+
+	uint8 token = (uint8)((std::min<size_t>(literalsLength, 15) << 4) | std::min<size_t>(matchCode, 15));
+	out.push<uint8>(token);
+
+	if (literalsLength >= 15)
+		PushLZLength(out, literalsLength - 15);
+	if (literalsLength)
+		out.push_bytes(literals, literalsLength);
+
+	if (!matchLength)
+		return;
+
+	out.push<uint8>((uint8)(offset & 0xFF));
+	out.push<uint8>((uint8)(offset >> 8));
+
+	if (matchCode >= 15)
+		PushLZLength(out, matchCode - 15);
+}
+
+static void CompressLZ(const byte* src, size_t srcSize, DynamicBuffer& out)
+{
+	std::vector<size_t> table((size_t)1 << LZ_HASH_BITS, SIZE_MAX);
+
+	size_t anchor = 0;
+	size_t pos = 0;
+	while (pos + LZ_MIN_MATCH <= srcSize)
+	{
+		uint32 sequence = ReadUInt32(src + pos);
+		uint32 hash = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+		size_t candidate = table[hash];
+		table[hash] = pos;
+
+		if (candidate == SIZE_MAX || pos - candidate > LZ_MAX_OFFSET || ReadUInt32(src + candidate) != sequence)
+		{
+			pos++;
+			continue;
+		}
+
+		size_t matchLength = LZ_MIN_MATCH;
+		while (pos + matchLength < srcSize && src[candidate + matchLength] == src[pos + matchLength])
+			matchLength++;
+
+		PushLZSequence(out, src + anchor, pos - anchor, pos - candidate, matchLength);
+		pos += matchLength;
+		anchor = pos;
+	}
+
+	PushLZSequence(out, src + anchor, srcSize - anchor, 0, 0);
+}
+
+bool AssetPak::Cook(const std::filesystem::path& registryPath, const std::filesystem::path& assetsPath, const std::string& outPath, bool compress)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	Buffer registryFile;
+	if (FileSystem::ReadFileBinary(registryPath.string(), registryFile) != FILE_OPEN_RESULT_OK || !registryFile.size())
+	{
+		GROOVY_LOG_ERR("Can't read asset registry %s", registryPath.string().c_str());
+		return false;
+	}
+
+	BufferView registryView(registryFile);
+	uint32 assetsCount = registryView.read<uint32>();
+
+	static const byte zeros[GROOVY_PAK_ALIGNMENT] = {};
+
+	DynamicBuffer pak(sizeof(PakHeader) + 1024 * 1024);
+	pak.push(PakHeader{});
+
+	std::vector<PakEntry> entries;
+	DynamicBuffer names;
+	uint64 rawBytes = 0;
+
+	for (uint32 i = 0; i < assetsCount; i++)
+	{
+		std::string name = registryView.read<std::string>();
+		AssetUUID uuid = registryView.read<AssetUUID>();
+		EAssetType type = registryView.read<EAssetType>();
+
+		MappedFile assetFile;
+		if (FileSystem::MapFileReadOnly((assetsPath / name).string(), assetFile, FILE_ACCESS_HINT_SEQUENTIAL) != FILE_OPEN_RESULT_OK)
+		{
+			GROOVY_LOG_ERR("Registry asset '%s' not found on disk, not cooked", name.c_str());
+			continue;
+		}
+
+		if (size_t misalignment = pak.used() % GROOVY_PAK_ALIGNMENT)
+			pak.push_bytes(zeros, GROOVY_PAK_ALIGNMENT - misalignment);
+
+		PakEntry& entry = entries.emplace_back();
+		entry.uuid = uuid;
+		entry.offset = pak.used();
+		entry.size = assetFile.GetSize();
+		entry.uncompressedSize = assetFile.GetSize();
+		entry.nameOffset = (uint32)names.used();
+		entry.type = (uint16)type;
+		entry.flags = PAK_ENTRY_FLAG_NONE;
+
+		names.push(name);
+		rawBytes += assetFile.GetSize();
+
+		if (!assetFile.GetSize())
+			continue;
+
+		DynamicBuffer compressed;
+		if (compress)
+			CompressLZ(assetFile.GetData(), assetFile.GetSize(), compressed);
+
+		if (compress && compressed.used() <= assetFile.GetSize() - assetFile.GetSize() / 8)
+		{
+			entry.size = compressed.used();
+			entry.flags |= PAK_ENTRY_FLAG_COMPRESSED;
+			pak.push_bytes(compressed.data(), compressed.used());
+		}
+		else
+		{
+			pak.push_bytes(assetFile.GetData(), assetFile.GetSize());
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const PakEntry& a, const PakEntry& b) { return a.uuid < b.uuid; });
+
+	if (size_t misalignment = pak.used() % alignof(PakEntry))
+		pak.push_bytes(zeros, alignof(PakEntry) - misalignment);
+
+	PakHeader header = {};
+	header.magic = GROOVY_PAK_MAGIC;
+	header.version = GROOVY_PAK_VERSION;
+	header.entriesCount = (uint32)entries.size();
+	header.tocOffset = pak.used();
+	if (entries.size())
+		pak.push(entries.data(), (uint32)entries.size());
+
+	// never empty, Mount checks the last name is terminated
+	if (!names.used())
+		names.push<uint8>(0);
+
+	header.namesOffset = pak.used();
+	header.namesSize = (uint32)names.used();
+	pak.push_bytes(names.data(), names.used());
+
+	memcpy(pak.data(), &header, sizeof(PakHeader));
+
+	if (FileSystem::WriteFileBinary(outPath, pak) != FILE_OPEN_RESULT_OK)
+	{
+		GROOVY_LOG_ERR("Can't write %s", outPath.c_str());
+		return false;
+	}
+
+	GROOVY_LOG_INFO("Cooked %u assets into %s, %llu bytes (%llu uncooked)", (uint32)entries.size(), outPath.c_str(), (unsigned long long)pak.used(), (unsigned long long)rawBytes);
+	return true;
+}
+
+#endif
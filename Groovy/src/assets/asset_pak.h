@@ -0,0 +1,72 @@
+#pragma once
+
+#include "asset.h"
+#include <filesystem>
+
+#define GROOVY_PAK_MAGIC		0x4B415047	// "GPAK"
+#define GROOVY_PAK_VERSION		1
+// asset data offsets are aligned to this, views into the pak keep it
+#define GROOVY_PAK_ALIGNMENT	64
+
+enum EPakEntryFlags
+{
+	PAK_ENTRY_FLAG_NONE = 0,
+	// lz compressed, read into a buffer instead of being served in place
+	PAK_ENTRY_FLAG_COMPRESSED = 1 << 0
+};
+
+/*
+	.groovypak layout:
+	PakHeader | asset data (each entry aligned to GROOVY_PAK_ALIGNMENT) | PakEntry table sorted by uuid | asset names
+*/
+struct PakHeader
+{
+	uint32 magic;
+	uint32 version;
+	uint32 entriesCount;
+	uint32 namesSize;
+	uint64 tocOffset;
+	uint64 namesOffset;
+};
+
+struct PakEntry
+{
+	AssetUUID uuid;
+	uint64 offset;
+	uint64 size;
+	uint64 uncompressedSize;
+	// in the names block
+	uint32 nameOffset;
+	uint16 type;
+	uint16 flags;
+};
+
+/*
+	Every registry asset packed in one file, the shipping runtime mounts (maps) it instead of reading loose .groovyasset files.
+	Uncompressed entries are served in place, the view stays valid until Unmount.
+
+	AssetPak::Mount(gProj.GetAssetPakPath().string());
+	Buffer storage;
+	BufferView data = AssetPak::Read(*AssetPak::Find(uuid), storage);
+*/
+class CORE_API AssetPak
+{
+public:
+	static bool Mount(const std::string& path);
+	static void Unmount();
+	static bool IsMounted();
+
+	static uint32 GetEntriesCount();
+	static const PakEntry& GetEntry(uint32 index);
+	static const char* GetEntryName(const PakEntry& entry);
+	// null if the pak doesn't have it
+	static const PakEntry* Find(AssetUUID uuid);
+
+	// compressed entries are decompressed into storage, an empty view means the entry is corrupted
+	static BufferView Read(const PakEntry& entry, Buffer& storage);
+
+#if !BUILD_SHIPPING
+	// packs every asset in the registry, compress keeps an entry compressed only when it saves at least 1/8
+	static bool Cook(const std::filesystem::path& registryPath, const std::filesystem::path& assetsPath, const std::string& outPath, bool compress);
+#endif
+};
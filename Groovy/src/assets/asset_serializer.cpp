@@ -1,5 +1,6 @@
 #include "asset_serializer.h"
 #include "platform/filesystem.h"
+#include "core/async_io.h"
 #include "asset_manager.h"
 #include "engine/project.h"
 
@@ -9,12 +10,15 @@ extern GroovyProject gProj;
 
 void AssetSerializer::SerializeGenericAsset(AssetInstance* asset, const std::string& filePath)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	check(asset);
 
 	DynamicBuffer fileData;
 	asset->Serialize(fileData);
 
-	FileSystem::WriteFileBinary(filePath, fileData);
+	// saves don't wait for the disk
+	AsyncIO::WriteAsync(filePath, std::move(fileData));
 }
 
 void AssetSerializer::SerializeGenericAsset(AssetInstance* asset)
@@ -28,12 +32,14 @@ void AssetSerializer::SerializeGenericAsset(AssetInstance* asset)
 
 void AssetSerializer::SerializeMesh(Mesh* mesh, const std::string& filePath)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	check(mesh);
 
 	DynamicBuffer fileData;
 	mesh->Serialize(fileData);
 
-	FileSystem::OverwriteFileBinary(filePath, fileData.data(), fileData.used(), mesh->GetAssetOffsetForSerialization());
+	AsyncIO::OverwriteAsync(filePath, std::move(fileData), mesh->GetAssetOffsetForSerialization());
 }
 
 void AssetSerializer::SerializeMesh(Mesh* mesh)
@@ -1,3 +1,5 @@
+#if PLATFORM_WIN32
+
 #include "audio.h"
 #include "fmod/include/fmod.h"
 
@@ -15,7 +17,11 @@ void Audio::Init()
 
 void Audio::Shutdown()
 {
+	if (!sFMODSystem)
+		return;
+
 	FMOD_System_Close(sFMODSystem);
+	sFMODSystem = nullptr;
 }
 
 void Audio::Update()
@@ -23,8 +29,17 @@ void Audio::Update()
 	FMOD_System_Update(sFMODSystem);
 }
 
+bool Audio::IsInitialized()
+{
+	return sFMODSystem;
+}
+
 AudioClipHandle Audio::CreateClip(BufferView& file)
 {
+	// headless runs don't start the audio system, clips exist without a sound behind them
+	if (!sFMODSystem)
+		return nullptr;
+
 	FMOD_SOUND* res = nullptr;
 	FMOD_CREATESOUNDEXINFO desc = {};
 	desc.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
@@ -42,6 +57,9 @@ AudioClipHandle Audio::CreateClip(BufferView& file)
 
 AudioClipHandle Audio::CreateClipFromFile(const char* file)
 {
+	if (!sFMODSystem)
+		return nullptr;
+
 	FMOD_SOUND* res = nullptr;
 	FMOD_ASSERT(FMOD_System_CreateSound
 	(
@@ -122,3 +140,5 @@ uint32 Audio::GetClipsCount()
 {
 	return (uint32)sClips.size();
 }
+
+#endif
@@ -29,6 +29,7 @@ public:
 	static void Init();
 	static void Shutdown();
 	static void Update();
+	static bool IsInitialized();
 
 	static AudioClipHandle CreateClip(BufferView& file);
 	static AudioClipHandle CreateClipFromFile(const char* file);
@@ -18,6 +18,16 @@ void AudioClip::Load()
 	mLoaded = true;
 }
 
+void AudioClip::Unload()
+{
+	if (mHandle)
+		Audio::DestroyClip(mHandle);
+
+	mHandle = nullptr;
+	mInfo = {};
+	mLoaded = false;
+}
+
 void AudioClip::Save()
 {
 }
@@ -28,15 +38,21 @@ void AudioClip::Serialize(DynamicBuffer& fileData) const
 
 void AudioClip::Deserialize(BufferView fileData)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	if (!fileData.empty())
 	{
 		mHandle = Audio::CreateClip(fileData);
-		mInfo = Audio::GetClipInfo(mHandle);
+		if (mHandle)
+			mInfo = Audio::GetClipInfo(mHandle);
 	}
 }
 
 void AudioClip::Play()
 {
+	if (!Audio::IsInitialized())
+		return;
+
 	check(mHandle);
 	Audio::PlayClip(mHandle);
 }
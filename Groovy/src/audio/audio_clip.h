@@ -16,6 +16,7 @@ public:
 
     virtual bool IsLoaded() const override { return mLoaded; }
     virtual void Load() override;
+    virtual void Unload() override;
     virtual void Save() override;
 
 #if WITH_EDITOR
@@ -0,0 +1,57 @@
+#if !PLATFORM_WIN32
+
+#include "audio.h"
+
+// there's no fmod library for this platform in vendor, audio never starts and clips have no sound behind them
+
+void Audio::Init()
+{
+	GROOVY_LOG_WARN("No audio backend on this platform, audio is disabled");
+}
+
+void Audio::Shutdown()
+{
+}
+
+void Audio::Update()
+{
+}
+
+bool Audio::IsInitialized()
+{
+	return false;
+}
+
+AudioClipHandle Audio::CreateClip(BufferView& file)
+{
+	return nullptr;
+}
+
+AudioClipHandle Audio::CreateClipFromFile(const char* file)
+{
+	return nullptr;
+}
+
+AudioClipInfo Audio::GetClipInfo(AudioClipHandle clip)
+{
+	return {};
+}
+
+void Audio::DestroyClip(AudioClipHandle clip)
+{
+}
+
+void Audio::PlayClip(AudioClipHandle clip)
+{
+}
+
+void Audio::StopEverything()
+{
+}
+
+uint32 Audio::GetClipsCount()
+{
+	return 0;
+}
+
+#endif
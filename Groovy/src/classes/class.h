@@ -190,6 +190,7 @@ typedef void(*GroovyDestructor)(void*);
 typedef void(*GroovyPropertiesGetter)(std::vector<GroovyProperty>&);
 
 class GroovyObject;
+struct ClassReflection;
 
 struct GroovyClass
 {
@@ -200,6 +201,8 @@ struct GroovyClass
 	GroovyClass* super;
 	GroovyPropertiesGetter propertiesGetter;
 	GroovyObject* cdo;
+	void* pool;	// owned by the ObjectAllocator
+	ClassReflection* reflection;	// owned by the ClassDB, set by Register
 };
 
 #define GROOVY_CLASS_NAME(Class)				__internal_groovyclass_##Class
@@ -227,6 +230,8 @@ private:
 	[](void* mem) { ((Class*)mem)->~Class(); },													\
 	Class::Super::StaticClass(),																\
 	&Class::GetClassProperties,																	\
+	nullptr,																					\
+	nullptr,																					\
 	nullptr																						\
 };																								\
 void Class::GetClassPropertiesRecursive(std::vector<GroovyProperty>& outProps) const			\
@@ -246,6 +251,8 @@ struct PropertyDesc
 {
 	const GroovyProperty* classProp;
 	uint32 arrayCount;
+	// where the property data starts in the pack data, packs read from v2 files have padding between properties
+	uint32 dataOffset;
 	size_t sizeBytes;
 };
 
@@ -254,17 +261,18 @@ struct PropertyPack
 	PropertyPack() {}
 
 	PropertyPack(const PropertyPack& copyPack)
-		: desc(copyPack.desc), data(copyPack.data)
+		: desc(copyPack.desc), data(copyPack.data), fileData(copyPack.fileData)
 	{}
 
 	PropertyPack(PropertyPack&& movePack)
-		: desc(std::move(movePack.desc)), data(std::move(movePack.data))
+		: desc(std::move(movePack.desc)), data(std::move(movePack.data)), fileData(movePack.fileData)
 	{}
 
 	PropertyPack& operator=(const PropertyPack& copyPack)
 	{
 		desc = copyPack.desc;
 		data = copyPack.data;
+		fileData = copyPack.fileData;
 		return *this;
 	}
 
@@ -272,11 +280,16 @@ struct PropertyPack
 	{
 		desc = std::move(movePack.desc);
 		data = std::move(movePack.data);
+		fileData = movePack.fileData;
 		return *this;
 	}
 
+	inline const byte* GetData() const { return fileData ? fileData : data.data(); }
+
 	std::vector<PropertyDesc> desc;
 	DynamicBuffer data;
+	// set when the pack was read in place, the properties data is in the file buffer (which has to outlive the pack) and data is empty
+	const byte* fileData = nullptr;
 };
 
 CORE_API size_t GroovyProperty_GetSize(EPropertyType type);
@@ -1,6 +1,34 @@
 #include "class_db.h"
 #include "runtime/object_allocator.h"
 #include "utils/reflection_utils.h"
+#include "utils/string_utils.h"
+
+void NameHashTable::Insert(uint32 hash, uint32 index)
+{
+	if ((mCount + 1) * 2 > mSlots.size())
+	{
+		std::vector<Slot> oldSlots = std::move(mSlots);
+		mSlots.assign(oldSlots.empty() ? 16 : oldSlots.size() * 2, { 0, NOT_FOUND });
+		mCount = 0;
+		for (const Slot& s : oldSlots)
+			if (s.index != NOT_FOUND)
+				Insert(s.hash, s.index);
+	}
+
+	uint32 mask = (uint32)mSlots.size() - 1;
+	uint32 slot = hash & mask;
+	while (mSlots[slot].index != NOT_FOUND)
+		slot = (slot + 1) & mask;
+
+	mSlots[slot] = { hash, index };
+	mCount++;
+}
+
+void NameHashTable::Clear()
+{
+	mSlots.clear();
+	mCount = 0;
+}
 
 ClassDB::ClassDB()
 {
@@ -9,12 +37,26 @@ ClassDB::ClassDB()
 void ClassDB::Register(GroovyClass* gClass)
 {
 	check(gClass);
-	std::vector<GroovyProperty> props;
-	reflectionUtils::GetClassPropertiesRecursiveSorted(gClass, props);
-	
+
+	// a name registered again points to the last class registered with it
+	uint32 classIndex = (uint32)mClasses.size();
 	mClasses.push_back(gClass);
-	mClassDB[gClass->name] = gClass;
-	mPropsDB[gClass] = props;
+	mClassesByName.InsertOrAssign(stringUtils::Hash32(gClass->name), classIndex, [&](uint32 i) { return mClasses[i]->name == gClass->name; });
+
+	// registered again, the reflection is rebuilt in place
+	if (!gClass->reflection)
+		gClass->reflection = mReflection.emplace_back(std::make_unique<ClassReflection>()).get();
+
+	ClassReflection& reflection = *gClass->reflection;
+	reflection.props.clear();
+	reflection.propsByName.Clear();
+	reflectionUtils::GetClassPropertiesRecursiveSorted(gClass, reflection.props);
+
+	for (uint32 i = 0; i < reflection.props.size(); i++)
+		reflection.propsByName.Insert(stringUtils::Hash32(reflection.props[i].name), i);
+
+	// points into the properties, built after they are in place
+	SerializationPlan_Build(reflection.props, reflection.serializationPlan);
 }
 
 void ClassDB::BuildCDOs()
@@ -37,21 +79,28 @@ void ClassDB::BuildCDO(GroovyClass* gClass)
 
 const std::vector<GroovyProperty>& ClassDB::operator[](GroovyClass* gClass)
 {
-	return mPropsDB[gClass];
+	static const std::vector<GroovyProperty> NO_PROPS;
+	return gClass->reflection ? gClass->reflection->props : NO_PROPS;
 }
 
 GroovyClass* ClassDB::operator[](const std::string& className)
 {
-	return mClassDB[className];
+	uint32 index = mClassesByName.Find(stringUtils::Hash32(className), [&](uint32 i) { return mClasses[i]->name == className; });
+	return index != NameHashTable::NOT_FOUND ? mClasses[index] : nullptr;
+}
+
+const SerializationPlan& ClassDB::GetSerializationPlan(GroovyClass* gClass)
+{
+	static const SerializationPlan NO_PLAN;
+	return gClass->reflection ? gClass->reflection->serializationPlan : NO_PLAN;
 }
 
 const GroovyProperty* ClassDB::FindProperty(GroovyClass* gClass, const std::string& propertyName)
 {
-	const std::vector<GroovyProperty>& props = (*this)[gClass];
-	
-	for (const GroovyProperty& prop : props)
-		if (prop.name == propertyName)
-			return &prop;
+	if (!gClass->reflection)
+		return nullptr;
 
-	return nullptr;
+	const std::vector<GroovyProperty>& props = gClass->reflection->props;
+	uint32 index = gClass->reflection->propsByName.Find(stringUtils::Hash32(propertyName), [&](uint32 i) { return props[i].name == propertyName; });
+	return index != NameHashTable::NOT_FOUND ? &props[index] : nullptr;
 }
@@ -1,7 +1,80 @@
 #pragma once
 
 #include "class.h"
-#include <map>
+#include "serialization_plan.h"
+#include <memory>
+
+/*
+	Open addressing (linear probing) table from a name hash to an index in an array the owner keeps,
+	the owner compares the names on a hash match so collisions are fine.
+
+	uint32 index = table.Find(hash, [&](uint32 i) { return items[i].name == name; });
+*/
+class CORE_API NameHashTable
+{
+public:
+	static constexpr uint32 NOT_FOUND = ~0u;
+
+	void Insert(uint32 hash, uint32 index);
+	void Clear();
+
+	// the entry match accepts points to index from now on, inserted if there's none
+	template<typename TMatch>
+	void InsertOrAssign(uint32 hash, uint32 index, TMatch match)
+	{
+		if (!mSlots.empty())
+		{
+			uint32 mask = (uint32)mSlots.size() - 1;
+			for (uint32 slot = hash & mask; mSlots[slot].index != NOT_FOUND; slot = (slot + 1) & mask)
+			{
+				Slot& s = mSlots[slot];
+				if (s.hash == hash && match(s.index))
+				{
+					s.index = index;
+					return;
+				}
+			}
+		}
+		Insert(hash, index);
+	}
+
+	template<typename TMatch>
+	uint32 Find(uint32 hash, TMatch match) const
+	{
+		if (mSlots.empty())
+			return NOT_FOUND;
+
+		uint32 mask = (uint32)mSlots.size() - 1;
+		for (uint32 slot = hash & mask;; slot = (slot + 1) & mask)
+		{
+			const Slot& s = mSlots[slot];
+			if (s.index == NOT_FOUND)
+				return NOT_FOUND;
+			if (s.hash == hash && match(s.index))
+				return s.index;
+		}
+	}
+
+private:
+	struct Slot
+	{
+		uint32 hash;
+		uint32 index;
+	};
+
+	// power of two, at most half full
+	std::vector<Slot> mSlots;
+	uint32 mCount = 0;
+};
+
+// what the ClassDB builds for a class when it's registered, GroovyClass::reflection points to it
+struct ClassReflection
+{
+	// super classes first
+	std::vector<GroovyProperty> props;
+	NameHashTable propsByName;
+	SerializationPlan serializationPlan;
+};
 
 class CORE_API ClassDB
 {
@@ -17,6 +90,7 @@ public:
 
 	void BuildCDO(GroovyClass* gClass);
 
+	// no lookup, reads GroovyClass::reflection. empty for classes that aren't registered
 	const std::vector<GroovyProperty>& operator[](GroovyClass* gClass);
 	GroovyClass* operator[](const std::string& className);
 
@@ -24,8 +98,14 @@ public:
 
 	const GroovyProperty* FindProperty(GroovyClass* gClass, const std::string& propertyName);
 
+	// built by Register, what ObjectSerializer runs for the class
+	const SerializationPlan& GetSerializationPlan(GroovyClass* gClass);
+
 private:
 	std::vector<GroovyClass*> mClasses;
-	std::map<std::string, GroovyClass*> mClassDB;
-	std::map<GroovyClass*, std::vector<GroovyProperty>> mPropsDB;
-};
\ No newline at end of file
+	NameHashTable mClassesByName;
+	std::vector<std::unique_ptr<ClassReflection>> mReflection;
+};
+
+// benchmark, hashed class and property lookups against the map and linear scans they replaced
+void BenchmarkReflection();
@@ -9,7 +9,9 @@ GroovyClass GROOVY_CLASS_NAME(GroovyObject) =
 	[](void* mem) { ((GroovyObject*)mem)->~GroovyObject(); },	// destructor
 	nullptr,													// super class
 	&GroovyObject::GetClassProperties,							// props getter
-	nullptr														// cdo
+	nullptr,													// cdo
+	nullptr,													// object pool
+	nullptr														// reflection
 };
 
 void GroovyObject::GetClassProperties(std::vector<GroovyProperty>& outProps)
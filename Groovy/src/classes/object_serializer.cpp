@@ -2,9 +2,186 @@
 #include "utils/reflection_utils.h"
 #include "class_db.h"
 #include "assets/asset_manager.h"
+#include "math/quat.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define SERIALIZER_SSE2 1
+#endif
+
+extern ClassDB gClassDB;
 
 namespace utils
 {
+	// memcmp(a, b, size) == 0, 16 bytes per compare. most properties still have the cdo's value
+	static inline bool BytesEqual(const byte* a, const byte* b, size_t size)
+	{
+		size_t i = 0;
+#if SERIALIZER_SSE2
+		for (; i + 16 <= size; i += 16)
+		{
+			__m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i)));
+			if (_mm_movemask_epi8(equal) != 0xFFFF)
+				return false;
+		}
+#endif
+		for (; i + 8 <= size; i += 8)
+		{
+			uint64 va, vb;
+			memcpy(&va, a + i, sizeof(uint64));
+			memcpy(&vb, b + i, sizeof(uint64));
+			if (va != vb)
+				return false;
+		}
+		for (; i < size; i++)
+		{
+			if (a[i] != b[i])
+				return false;
+		}
+		return true;
+	}
+
+	static inline void AddDesc(PropertyPack& pack, const GroovyProperty* prop, uint32 arrayCount, size_t dataOffset, size_t sizeBytes)
+	{
+		PropertyDesc& desc = pack.desc.emplace_back();
+		desc.classProp = prop;
+		desc.arrayCount = arrayCount;
+		desc.dataOffset = (uint32)dataOffset;
+		desc.sizeBytes = sizeBytes;
+	}
+
+	// elements of a fixed array or a std::vector
+	static inline byte* GetElements(const SerializedProperty& p, byte* obj, uint32& outCount)
+	{
+		byte* data = obj + p.prop->offset;
+		if (p.prop->flags & PROPERTY_FLAG_IS_DYNAMIC_ARRAY)
+		{
+			outCount = (uint32)p.dynamicArray.size(data);
+			return (byte*)p.dynamicArray.data(data);
+		}
+		outCount = p.prop->arrayCount;
+		return data;
+	}
+
+	static inline bool ValueIsEqual(const SerializedProperty& p, const byte* obj, const byte* cdo)
+	{
+		return BytesEqual(obj + p.prop->offset, cdo + p.prop->offset, p.size);
+	}
+
+	static void SerializeValueRun(PropertyPack& pack, const SerializationPlan& plan, const SerializationStep& step, byte* obj, byte* cdo)
+	{
+		// the whole run at once first, usually nothing changed. not worth it for one or two properties, they're compared below anyway
+		if (cdo && step.propCount > 2 && BytesEqual(obj + step.offset, cdo + step.offset, step.size))
+			return;
+
+		// a desc per property, the data pushed in spans of adjacent properties that differ from the cdo. each property is compared once
+		uint32 end = step.firstProp + step.propCount;
+		uint32 spanOffset = 0;
+		size_t spanSize = 0;
+		for (uint32 i = step.firstProp; i < end; i++)
+		{
+			const SerializedProperty& p = plan.props[i];
+			if (cdo && ValueIsEqual(p, obj, cdo))
+			{
+				if (spanSize)
+					pack.data.push_bytes(obj + spanOffset, spanSize);
+				spanSize = 0;
+				continue;
+			}
+
+			if (!spanSize)
+				spanOffset = p.prop->offset;
+			AddDesc(pack, p.prop, p.prop->arrayCount, pack.data.used() + spanSize, p.size);
+			spanSize += p.size;
+		}
+
+		if (spanSize)
+			pack.data.push_bytes(obj + spanOffset, spanSize);
+	}
+
+	static void SerializeValueDynamicArray(PropertyPack& pack, const SerializedProperty& p, byte* obj, byte* cdo)
+	{
+		uint32 count;
+		byte* elements = GetElements(p, obj, count);
+		size_t sizeBytes = (size_t)count * p.size;
+
+		if (cdo)
+		{
+			uint32 cdoCount;
+			byte* cdoElements = GetElements(p, cdo, cdoCount);
+			if (count == cdoCount && BytesEqual(elements, cdoElements, sizeBytes))
+				return;
+		}
+
+		AddDesc(pack, p.prop, count, pack.data.used(), sizeBytes);
+		if (sizeBytes)
+			pack.data.push_bytes(elements, sizeBytes);
+	}
+
+	static void SerializeStrings(PropertyPack& pack, const SerializedProperty& p, byte* obj, byte* cdo)
+	{
+		uint32 count;
+		const std::string* strings = (const std::string*)GetElements(p, obj, count);
+
+		if (cdo)
+		{
+			uint32 cdoCount;
+			const std::string* cdoStrings = (const std::string*)GetElements(p, cdo, cdoCount);
+			if (count == cdoCount && std::equal(strings, strings + count, cdoStrings))
+				return;
+		}
+
+		size_t dataOffset = pack.data.used();
+		for (uint32 i = 0; i < count; i++)
+			pack.data.push<std::string>(strings[i]);
+		AddDesc(pack, p.prop, count, dataOffset, pack.data.used() - dataOffset);
+	}
+
+	static void SerializeBuffers(PropertyPack& pack, const SerializedProperty& p, byte* obj, byte* cdo)
+	{
+		uint32 count;
+		const Buffer* buffers = (const Buffer*)GetElements(p, obj, count);
+
+		if (cdo)
+		{
+			uint32 cdoCount;
+			const Buffer* cdoBuffers = (const Buffer*)GetElements(p, cdo, cdoCount);
+			bool equal = count == cdoCount;
+			for (uint32 i = 0; equal && i < count; i++)
+				equal = buffers[i].size() == cdoBuffers[i].size() && BytesEqual(buffers[i].data(), cdoBuffers[i].data(), buffers[i].size());
+			if (equal)
+				return;
+		}
+
+		size_t dataOffset = pack.data.used();
+		for (uint32 i = 0; i < count; i++)
+		{
+			pack.data.push<size_t>(buffers[i].size());
+			if (buffers[i].size())
+				pack.data.push_bytes(buffers[i].data(), buffers[i].size());
+		}
+		AddDesc(pack, p.prop, count, dataOffset, pack.data.used() - dataOffset);
+	}
+
+	static void SerializeAssetRefs(PropertyPack& pack, const SerializedProperty& p, byte* obj, byte* cdo)
+	{
+		uint32 count;
+		AssetInstance** assets = (AssetInstance**)GetElements(p, obj, count);
+
+		// same pointers, same assets
+		if (cdo)
+		{
+			uint32 cdoCount;
+			byte* cdoAssets = GetElements(p, cdo, cdoCount);
+			if (count == cdoCount && BytesEqual((const byte*)assets, cdoAssets, count * sizeof(AssetInstance*)))
+				return;
+		}
+
+		AddDesc(pack, p.prop, count, pack.data.used(), sizeof(AssetUUID) * count);
+		for (uint32 i = 0; i < count; i++)
+			pack.data.push<AssetUUID>(assets[i] ? assets[i]->GetUUID() : 0);
+	}
+
 	static void SerializePropertyData(PropertyPack& pack, const GroovyProperty& prop, GroovyObject* obj)
 	{
 		void* objProp = (byte*)obj + prop.offset;
@@ -20,11 +197,14 @@ namespace utils
 		PropertyDesc& desc = pack.desc.emplace_back();
 		desc.arrayCount = objPropArrayCount;
 		desc.classProp = &prop;
+		desc.dataOffset = (uint32)pack.data.used();
 
 		if (!(prop.flags & PROPERTY_FLAG_IS_COMPLEX))
 		{
 			size_t dataWidth = GroovyProperty_GetSize(prop.type) * objPropArrayCount;
-			pack.data.push_bytes(objProp, dataWidth);
+			// empty std::vectors have no data to push
+			if (dataWidth)
+				pack.data.push_bytes(objProp, dataWidth);
 			desc.sizeBytes = dataWidth;
 		}
 		else
@@ -49,7 +229,8 @@ namespace utils
 					for (uint32 i = 0; i < objPropArrayCount; i++)
 					{
 						pack.data.push<size_t>(bufferPtr->size());
-						pack.data.push_bytes(bufferPtr->data(), bufferPtr->size());
+						if (bufferPtr->size())
+							pack.data.push_bytes(bufferPtr->data(), bufferPtr->size());
 						desc.sizeBytes += sizeof(size_t) + bufferPtr->size();
 						bufferPtr++;
 					}
@@ -95,6 +276,8 @@ namespace utils
 		}
 		else
 		{
+			// elements are read up to the size of the property in the pack, what's past it is corrupted
+			const byte* dataEnd = data + desc.sizeBytes;
 			switch (desc.classProp->type)
 			{
 				case PROPERTY_TYPE_STRING:
@@ -102,8 +285,14 @@ namespace utils
 					std::string* strPtr = (std::string*)objProp;
 					for (uint32 i = 0; i < desc.arrayCount; i++)
 					{
-						*strPtr = (char*)data;
-						data += strPtr->length() + 1;
+						const byte* terminator = (const byte*)memchr(data, '\0', dataEnd - data);
+						if (!terminator)
+						{
+							GROOVY_LOG_ERR("ObjectSerializer::DeserializePropertyPack string property '%s' runs past its data, the rest is skipped", desc.classProp->name.c_str());
+							break;
+						}
+						strPtr->assign((const char*)data, terminator - data);
+						data = terminator + 1;
 						strPtr++;
 					}
 				}
@@ -114,7 +303,14 @@ namespace utils
 					Buffer* bufferPtr = (Buffer*)objProp;
 					for (uint32 i = 0; i < desc.arrayCount; i++)
 					{
-						size_t bufferSize = *(size_t*)data;
+						size_t bufferSize = 0;
+						if ((size_t)(dataEnd - data) >= sizeof(size_t))
+							memcpy(&bufferSize, data, sizeof(size_t));
+						if ((size_t)(dataEnd - data) < sizeof(size_t) || bufferSize > (size_t)(dataEnd - data) - sizeof(size_t))
+						{
+							GROOVY_LOG_ERR("ObjectSerializer::DeserializePropertyPack buffer property '%s' runs past its data, the rest is skipped", desc.classProp->name.c_str());
+							break;
+						}
 						bufferPtr->resize(bufferSize);
 						data += sizeof(size_t);
 						memcpy(bufferPtr->data(), data, bufferSize);
@@ -126,6 +322,12 @@ namespace utils
 
 				case PROPERTY_TYPE_ASSET_REF:
 				{
+					if ((size_t)desc.arrayCount * sizeof(AssetUUID) > desc.sizeBytes)
+					{
+						GROOVY_LOG_ERR("ObjectSerializer::DeserializePropertyPack asset ref property '%s' runs past its data, skipped", desc.classProp->name.c_str());
+						break;
+					}
+
 					AssetInstance** assetPtr = (AssetInstance**)objProp;
 					for (uint32 i = 0; i < desc.arrayCount; i++)
 					{
@@ -142,59 +344,358 @@ namespace utils
 			}
 		}
 	}
+
+	static inline size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	// v2 payload alignment, the widest scalar in the property data
+	static size_t GetPayloadAlignment(EPropertyType type)
+	{
+		switch (type)
+		{
+			case PROPERTY_TYPE_BOOL:
+			case PROPERTY_TYPE_STRING:
+				return 1;
+			case PROPERTY_TYPE_INT64:
+			case PROPERTY_TYPE_UINT64:
+			case PROPERTY_TYPE_BUFFER:
+			case PROPERTY_TYPE_ASSET_REF:
+				return 8;
+			default:
+				return 4;
+		}
+	}
+
+	// value properties are exactly their elements, complex ones take at least a byte per element
+	static bool SizeMatchesSignature(const GroovyProperty& classProp, uint32 arrayCount, size_t sizeBytes)
+	{
+		if (classProp.flags & PROPERTY_FLAG_IS_COMPLEX)
+			return arrayCount <= sizeBytes;
+		return GroovyProperty_GetSize(classProp.type) * arrayCount == sizeBytes;
+	}
+
+	static void DeserializePropertyPackV1(GroovyClass* gClass, BufferView& fileData, uint32 propCount, PropertyPack& outPack)
+	{
+		for (uint32 i = 0; i < propCount; i++)
+		{
+			std::string name = fileData.read<std::string>();
+			EPropertyType type = fileData.read<EPropertyType>();
+			uint32 arrayCount = fileData.read<uint32>();
+			size_t sizeBytes = fileData.read<size_t>();
+
+			const GroovyProperty* classProp = gClassDB.FindProperty(gClass, name);
+
+			if (classProp)
+			{
+				// check property "signature"
+				bool compatiblePropSignature = classProp->type == type;
+				if (!(classProp->flags & PROPERTY_FLAG_IS_DYNAMIC_ARRAY))
+					compatiblePropSignature = compatiblePropSignature && classProp->arrayCount == arrayCount;
+				bool legacyTransform = type == PROPERTY_TYPE_TRANSFORM && arrayCount && sizeBytes == arrayCount * sizeof(EulerTransform);
+				compatiblePropSignature = compatiblePropSignature && (legacyTransform || SizeMatchesSignature(*classProp, arrayCount, sizeBytes));
+
+				if (compatiblePropSignature)
+				{
+					PropertyDesc& desc = outPack.desc.emplace_back();
+					desc.classProp = classProp;
+					desc.arrayCount = arrayCount;
+					desc.dataOffset = (uint32)outPack.data.used();
+					desc.sizeBytes = sizeBytes;
+
+					if (legacyTransform)
+					{
+						// saved before rotations were quaternions, converted once here and saved in the new layout next time
+						const byte* legacyData = fileData.seek();
+						for (uint32 j = 0; j < arrayCount; j++)
+						{
+							EulerTransform legacy;
+							memcpy(&legacy, legacyData + j * sizeof(EulerTransform), sizeof(EulerTransform));
+							outPack.data.push<Transform>(math::ToTransform(legacy));
+						}
+						desc.sizeBytes = arrayCount * sizeof(Transform);
+					}
+					else
+					{
+						outPack.data.push_bytes(fileData.seek(), sizeBytes);
+					}
+				}
+			}
+			else
+			{
+				GROOVY_LOG_WARN("ObjectSerializer::DeserializePropertyPack property '%s' not found in class '%s', please sanitize asset", name.c_str(), gClass->name.c_str());
+			}
+
+			fileData.advance(sizeBytes);
+		}
+	}
+
+	static void DeserializePropertyPackV2(GroovyClass* gClass, BufferView& fileData, PropertyPack& outPack, bool referenceFileData, PropertyNameTable* names)
+	{
+		uint16 version = fileData.read<uint16>();
+
+		PropertyNameTable packNames;
+		uint16 flags = fileData.read<uint16>();
+		if (flags & PROPERTY_PACK_FLAG_NAME_TABLE)
+		{
+			packNames.Deserialize(fileData);
+			names = &packNames;
+		}
+
+		uint32 propCount = fileData.read<uint32>();
+		uint32 payloadSize = fileData.read<uint32>();
+		const byte* entries = fileData.read(propCount * sizeof(PropertyPackEntry));
+		uint8 payloadPadding = fileData.read<uint8>();
+		fileData.advance(payloadPadding);
+		const byte* payload = fileData.read((size_t)payloadSize);
+
+		// packs of other versions are skipped whole, as long as they keep this header
+		if (version != GROOVY_PROPERTY_PACK_VERSION)
+		{
+			GROOVY_LOG_ERR("ObjectSerializer::DeserializePropertyPack pack of class '%s' is version %u, only %u is supported, skipping deserialization", gClass->name.c_str(), (uint32)version, (uint32)GROOVY_PROPERTY_PACK_VERSION);
+			return;
+		}
+
+		if (!names)
+		{
+			GROOVY_LOG_WARN("ObjectSerializer::DeserializePropertyPack pack of class '%s' uses a file name table that wasn't given, skipping deserialization", gClass->name.c_str());
+			return;
+		}
+
+		// one copy for the whole payload, or none
+		checkslowf(!outPack.fileData, "Packs read in place can't be appended to");
+		size_t dataBase = 0;
+		if (referenceFileData && outPack.desc.empty())
+		{
+			outPack.fileData = payload;
+		}
+		else
+		{
+			dataBase = outPack.data.used();
+			if (payloadSize)
+				outPack.data.push_bytes(payload, payloadSize);
+		}
+
+		const std::vector<const GroovyProperty*>& classProps = names->GetClassProperties(gClass);
+		outPack.desc.reserve(outPack.desc.size() + propCount);
+		size_t dataOffset = 0;
+		for (uint32 i = 0; i < propCount; i++)
+		{
+			// entries are only 2 bytes aligned
+			PropertyPackEntry entry;
+			memcpy(&entry, entries + i * sizeof(PropertyPackEntry), sizeof(PropertyPackEntry));
+
+			dataOffset = AlignUp(dataOffset, GetPayloadAlignment((EPropertyType)entry.type));
+			size_t entryOffset = dataOffset;
+			dataOffset += entry.sizeBytes;
+
+			if (dataOffset > payloadSize)
+			{
+				GROOVY_LOG_ERR("ObjectSerializer::DeserializePropertyPack pack of class '%s' has properties past its payload, the rest is skipped", gClass->name.c_str());
+				break;
+			}
+
+			const GroovyProperty* classProp = entry.nameId < classProps.size() ? classProps[entry.nameId] : nullptr;
+			if (!classProp)
+			{
+				GROOVY_LOG_WARN("ObjectSerializer::DeserializePropertyPack property '%s' not found in class '%s', please sanitize asset", entry.nameId < names->GetCount() ? names->GetName(entry.nameId).c_str() : "?", gClass->name.c_str());
+				continue;
+			}
+
+			// check property "signature"
+			bool compatiblePropSignature = classProp->type == entry.type;
+			if (!(classProp->flags & PROPERTY_FLAG_IS_DYNAMIC_ARRAY))
+				compatiblePropSignature = compatiblePropSignature && classProp->arrayCount == entry.arrayCount;
+			compatiblePropSignature = compatiblePropSignature && SizeMatchesSignature(*classProp, entry.arrayCount, entry.sizeBytes);
+
+			if (compatiblePropSignature)
+			{
+				PropertyDesc& desc = outPack.desc.emplace_back();
+				desc.classProp = classProp;
+				desc.arrayCount = entry.arrayCount;
+				desc.dataOffset = (uint32)(dataBase + entryOffset);
+				desc.sizeBytes = entry.sizeBytes;
+			}
+		}
+	}
 }
 
 void ObjectSerializer::CreatePropertyPack(GroovyObject* obj, GroovyObject* cdo, PropertyPack& outPack)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	checkslow(obj);
+	checkslow(!cdo || obj->GetClass() == cdo->GetClass());
+
+	const SerializationPlan& plan = gClassDB.GetSerializationPlan(obj->GetClass());
+	byte* objData = (byte*)obj;
+	byte* cdoData = (byte*)cdo;
+
+	for (const SerializationStep& step : plan.steps)
+	{
+		const SerializedProperty& p = plan.props[step.firstProp];
+		switch (step.type)
+		{
+			case SERIALIZATION_STEP_VALUE_RUN:				utils::SerializeValueRun(outPack, plan, step, objData, cdoData); break;
+			case SERIALIZATION_STEP_VALUE_DYNAMIC_ARRAY:	utils::SerializeValueDynamicArray(outPack, p, objData, cdoData); break;
+			case SERIALIZATION_STEP_STRING:					utils::SerializeStrings(outPack, p, objData, cdoData); break;
+			case SERIALIZATION_STEP_BUFFER:					utils::SerializeBuffers(outPack, p, objData, cdoData); break;
+			case SERIALIZATION_STEP_ASSET_REF:				utils::SerializeAssetRefs(outPack, p, objData, cdoData); break;
+		}
+	}
+}
+
+void ObjectSerializer::__internal_CreatePropertyPackPerProperty(GroovyObject* obj, GroovyObject* cdo, PropertyPack& outPack)
 {
 	checkslow(obj);
 
-	extern ClassDB gClassDB;
 	const std::vector<GroovyProperty>& props = gClassDB[obj->GetClass()];
 
-	if (cdo)
+	for (const GroovyProperty& p : props)
 	{
-		checkslow(obj->GetClass() == cdo->GetClass());
+		if (p.flags & PROPERTY_FLAG_NO_SERIALIZE)
+			continue;
 
-		for (const GroovyProperty& p : props)
-		{
-			if (p.flags & PROPERTY_FLAG_NO_SERIALIZE)
-				continue;
+		if (cdo && reflectionUtils::PropertyIsEqual(obj, cdo, &p))
+			continue;
 
-			if (reflectionUtils::PropertyIsEqual(obj, cdo, &p))
-				continue;
+		utils::SerializePropertyData(outPack, p, obj);
+	}
+}
+
+uint32 PropertyNameTable::AddName(const std::string& name)
+{
+	auto [it, added] = mIds.try_emplace(name, (uint32)mNames.size());
+	if (added)
+		mNames.push_back(name);
+	return it->second;
+}
+
+void PropertyNameTable::Serialize(DynamicBuffer& fileData) const
+{
+	fileData.push<uint32>((uint32)mNames.size());
+	for (const std::string& name : mNames)
+		fileData.push<std::string>(name);
+}
+
+void PropertyNameTable::Deserialize(BufferView& fileData)
+{
+	mNames.clear();
+	mIds.clear();
+	mClassProps.clear();
+
+	uint32 count = fileData.read<uint32>();
+	mNames.reserve(count);
+	for (uint32 i = 0; i < count; i++)
+		AddName(fileData.read<std::string>());
+}
 
-			utils::SerializePropertyData(outPack, p, obj);
+const std::vector<const GroovyProperty*>& PropertyNameTable::GetClassProperties(GroovyClass* gClass)
+{
+	std::vector<const GroovyProperty*>& classProps = mClassProps[gClass];
+	if (classProps.size() != mNames.size())
+	{
+		// once per class, no string compares per property after this
+		classProps.assign(mNames.size(), nullptr);
+		for (const GroovyProperty& prop : gClassDB[gClass])
+		{
+			auto it = mIds.find(prop.name);
+			if (it != mIds.end())
+				classProps[it->second] = &prop;
 		}
 	}
-	else
+	return classProps;
+}
+
+const GroovyProperty* PropertyNameTable::FindProperty(GroovyClass* gClass, uint32 id)
+{
+	const std::vector<const GroovyProperty*>& classProps = GetClassProperties(gClass);
+	return id < classProps.size() ? classProps[id] : nullptr;
+}
+
+void ObjectSerializer::SerializePropertyPack(const PropertyPack& pack, DynamicBuffer& fileData, PropertyNameTable* names)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	PropertyNameTable packNames;
+	uint16 flags = 0;
+	if (!names)
 	{
-		for (const GroovyProperty& p : props)
-		{
-			if (p.flags & PROPERTY_FLAG_NO_SERIALIZE)
-				continue;
+		names = &packNames;
+		flags |= PROPERTY_PACK_FLAG_NAME_TABLE;
+	}
 
-			utils::SerializePropertyData(outPack, p, obj);
-		}
+	uint32 propCount = (uint32)pack.desc.size();
+	std::vector<PropertyPackEntry> entries(propCount);
+	size_t payloadSize = 0;
+	for (uint32 i = 0; i < propCount; i++)
+	{
+		const PropertyDesc& desc = pack.desc[i];
+		checkf(desc.sizeBytes <= UINT32_MAX, "Property too big for a property pack");
+
+		PropertyPackEntry& entry = entries[i];
+		entry.nameId = names->AddName(desc.classProp->name);
+		entry.type = desc.classProp->type;
+		entry.arrayCount = desc.arrayCount;
+		entry.sizeBytes = (uint32)desc.sizeBytes;
+
+		payloadSize = utils::AlignUp(payloadSize, utils::GetPayloadAlignment(desc.classProp->type)) + desc.sizeBytes;
+	}
+
+	fileData.push<uint32>(GROOVY_PROPERTY_PACK_MAGIC);
+	fileData.push<uint16>(GROOVY_PROPERTY_PACK_VERSION);
+	fileData.push<uint16>(flags);
+	if (flags & PROPERTY_PACK_FLAG_NAME_TABLE)
+		packNames.Serialize(fileData);
+
+	fileData.push<uint32>(propCount);
+	fileData.push<uint32>((uint32)payloadSize);
+	if (propCount)
+		fileData.push(entries.data(), propCount);
+
+	// the payload starts 8 bytes aligned in the file
+	size_t headerEnd = fileData.used() + sizeof(uint8);
+	uint8 payloadPadding = (uint8)(utils::AlignUp(headerEnd, 8) - headerEnd);
+	fileData.push<uint8>(payloadPadding);
+
+	static const byte ZEROS[8] = {};
+	if (payloadPadding)
+		fileData.push_bytes(ZEROS, payloadPadding);
+
+	const byte* data = pack.GetData();
+	size_t payloadStart = fileData.used();
+	size_t dataOffset = 0;
+	for (uint32 i = 0; i < propCount; i++)
+	{
+		size_t alignedOffset = utils::AlignUp(dataOffset, utils::GetPayloadAlignment(pack.desc[i].classProp->type));
+		if (alignedOffset != dataOffset)
+			fileData.push_bytes(ZEROS, alignedOffset - dataOffset);
+		if (entries[i].sizeBytes)
+			fileData.push_bytes(data + pack.desc[i].dataOffset, entries[i].sizeBytes);
+		dataOffset = alignedOffset + entries[i].sizeBytes;
 	}
+	checkslow(fileData.used() - payloadStart == payloadSize);
 }
 
-void ObjectSerializer::SerializePropertyPack(const PropertyPack& pack, DynamicBuffer& fileData)
+void ObjectSerializer::__internal_SerializePropertyPackV1(const PropertyPack& pack, DynamicBuffer& fileData)
 {
-	fileData.push<uint32>((uint32)pack.desc.size());									// property count
-	size_t bufferOffset = 0;
+	fileData.push<uint32>((uint32)pack.desc.size());							// property count
 	for (const auto& desc : pack.desc)
 	{
 		fileData.push(desc.classProp->name);									// property name
 		fileData.push(desc.classProp->type);									// property type
 		fileData.push(desc.arrayCount);											// property array count
 		fileData.push(desc.sizeBytes);											// property data size
-		fileData.push_bytes(pack.data.data() + bufferOffset, desc.sizeBytes);	// binary data
-		bufferOffset += desc.sizeBytes;
+		if (desc.sizeBytes)
+			fileData.push_bytes(pack.GetData() + desc.dataOffset, desc.sizeBytes);	// binary data
 	}
 }
 
-void ObjectSerializer::DeserializePropertyPack(GroovyClass* gClass, BufferView& fileData, PropertyPack& outPack)
+void ObjectSerializer::DeserializePropertyPack(GroovyClass* gClass, BufferView& fileData, PropertyPack& outPack, bool referenceFileData, PropertyNameTable* names)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	checkslow(gClass);
 
 	if (!fileData.remaining())
@@ -203,54 +704,61 @@ void ObjectSerializer::DeserializePropertyPack(GroovyClass* gClass, BufferView&
 		return;
 	}
 
-	uint32 propCount = fileData.read<uint32>();
-
-	extern ClassDB gClassDB;
+	// v1 packs start with their property count
+	uint32 magicOrPropCount = fileData.read<uint32>();
+	if (magicOrPropCount == GROOVY_PROPERTY_PACK_MAGIC)
+		utils::DeserializePropertyPackV2(gClass, fileData, outPack, referenceFileData, names);
+	else
+		utils::DeserializePropertyPackV1(gClass, fileData, magicOrPropCount, outPack);
+}
 
-	for (uint32 i = 0; i < propCount; i++)
-	{
-		std::string name = fileData.read<std::string>();
-		EPropertyType type = fileData.read<EPropertyType>();
-		uint32 arrayCount = fileData.read<uint32>();
-		size_t sizeBytes = fileData.read<size_t>();
+void ObjectSerializer::DeserializePropertyPackData(const PropertyPack& pack, GroovyObject* obj)
+{
+	GROOVY_PROFILE_FUNCTION();
 
-		const GroovyProperty* classProp = gClassDB.FindProperty(gClass, name);
+	checkslow(obj);
 
-		if (classProp)
-		{
-			// check property "signature"
-			bool compatiblePropSignature = classProp->type == type;
-			if (!(classProp->flags & PROPERTY_FLAG_IS_DYNAMIC_ARRAY))
-				compatiblePropSignature = compatiblePropSignature && classProp->arrayCount == arrayCount;
+	constexpr uint32 NOT_FIXED_VALUE_FLAGS = PROPERTY_FLAG_IS_COMPLEX | PROPERTY_FLAG_IS_DYNAMIC_ARRAY;
 
-			if (classProp && compatiblePropSignature)
-			{
-				PropertyDesc& desc = outPack.desc.emplace_back();
-				desc.classProp = classProp;
-				desc.arrayCount = arrayCount;
-				desc.sizeBytes = sizeBytes;
+	const byte* data = pack.GetData();
 
-				outPack.data.push_bytes(fileData.seek(), sizeBytes);
-			}
+	// value properties one after the other in the pack and in the object too, one memcpy. each desc is looked at once
+	byte* runDst = nullptr;
+	const byte* runSrc = nullptr;
+	size_t runSize = 0;
+	for (const PropertyDesc& desc : pack.desc)
+	{
+		if (desc.classProp->flags & NOT_FIXED_VALUE_FLAGS)
+		{
+			utils::DeserializePropertyData(desc, data + desc.dataOffset, obj);
+			continue;
 		}
-		else
+
+		byte* dst = (byte*)obj + desc.classProp->offset;
+		const byte* src = data + desc.dataOffset;
+		if (dst == runDst + runSize && src == runSrc + runSize)
 		{
-			GROOVY_LOG_WARN("ObjectSerializer::DeserializePropertyPack property '%s' not found in class '%s', please sanitize asset", name.c_str(), gClass->name.c_str());
+			runSize += desc.sizeBytes;
+			continue;
 		}
 
-		fileData.advance(sizeBytes);
+		if (runSize)
+			memcpy(runDst, runSrc, runSize);
+		runDst = dst;
+		runSrc = src;
+		runSize = desc.sizeBytes;
 	}
+
+	if (runSize)
+		memcpy(runDst, runSrc, runSize);
 }
 
-void ObjectSerializer::DeserializePropertyPackData(const PropertyPack& pack, GroovyObject* obj)
+void ObjectSerializer::__internal_DeserializePropertyPackDataPerProperty(const PropertyPack& pack, GroovyObject* obj)
 {
 	checkslow(obj);
 
-	const byte* data = pack.data.data();
+	const byte* data = pack.GetData();
 
 	for (const PropertyDesc& desc : pack.desc)
-	{
-		utils::DeserializePropertyData(desc, data, obj);
-		data += desc.sizeBytes;
-	}
+		utils::DeserializePropertyData(desc, data + desc.dataOffset, obj);
 }
@@ -1,14 +1,83 @@
 #pragma once
 
 #include "object.h"
+#include <unordered_map>
+
+/*
+	property pack layout, little endian:
+	v2: uint32 magic | uint16 version | uint16 flags | [name table] | uint32 property count | uint32 payload size | entries | uint8 padding | padding | payload
+		entry: PropertyPackEntry, the payloads follow in the same order
+		the payload starts 8 bytes aligned from the start of the file buffer and each property is aligned to its type in it, so packs can be read in place
+	v1 (no magic): property count | per property: name | type | array count | size_t size | data
+*/
+#define GROOVY_PROPERTY_PACK_MAGIC		0x4B505047 // "GPPK", never a valid v1 property count
+#define GROOVY_PROPERTY_PACK_VERSION	2
+
+enum EPropertyPackFlags : uint16
+{
+	// the pack has its own name table, written when no file-wide one is given
+	PROPERTY_PACK_FLAG_NAME_TABLE = 1 << 0
+};
+
+struct PropertyPackEntry
+{
+	uint32 nameId;
+	uint32 type;
+	uint32 arrayCount;
+	uint32 sizeBytes;
+};
+
+/*
+	Property names of a whole file, written once instead of in front of every property of every object.
+	v2 packs refer to the names by index, resolved against a class once per file.
+
+	PropertyNameTable names;
+	ObjectSerializer::SerializePropertyPack(pack, body, &names);		// collects the names
+	names.Serialize(fileData);
+
+	names.Deserialize(fileData);
+	ObjectSerializer::DeserializePropertyPack(gClass, fileData, pack, true, &names);
+*/
+class CORE_API PropertyNameTable
+{
+public:
+	uint32 AddName(const std::string& name);
+
+	inline uint32 GetCount() const { return (uint32)mNames.size(); }
+	inline const std::string& GetName(uint32 id) const { return mNames[id]; }
+
+	void Serialize(DynamicBuffer& fileData) const;
+	void Deserialize(BufferView& fileData);
+
+	// property of every name id in the class, nullptr when the class has no property with that name (anymore)
+	const std::vector<const GroovyProperty*>& GetClassProperties(GroovyClass* gClass);
+	const GroovyProperty* FindProperty(GroovyClass* gClass, uint32 id);
+
+private:
+	std::vector<std::string> mNames;
+	std::unordered_map<std::string, uint32> mIds;
+	// property of every name, per class, filled the first time the class shows up
+	std::unordered_map<GroovyClass*, std::vector<const GroovyProperty*>> mClassProps;
+};
 
 class CORE_API ObjectSerializer
 {
 public:
 	static void CreatePropertyPack(GroovyObject* obj, GroovyObject* cdo, PropertyPack& outPack);
 
-	static void SerializePropertyPack(const PropertyPack& pack, DynamicBuffer& fileData);
-	static void DeserializePropertyPack(GroovyClass* gClass, BufferView& fileData, PropertyPack& outPack);
+	// names: file-wide name table, the pack gets its own when null
+	static void SerializePropertyPack(const PropertyPack& pack, DynamicBuffer& fileData, PropertyNameTable* names = nullptr);
+	// referenceFileData: v2 packs point into fileData instead of copying it, only for packs that don't outlive the file buffer
+	static void DeserializePropertyPack(GroovyClass* gClass, BufferView& fileData, PropertyPack& outPack, bool referenceFileData = false, PropertyNameTable* names = nullptr);
 
 	static void DeserializePropertyPackData(const PropertyPack& pack, GroovyObject* obj);
-};
\ No newline at end of file
+
+	// property by property versions of the above, same packs. the benchmark baseline
+	static void __internal_CreatePropertyPackPerProperty(GroovyObject* obj, GroovyObject* cdo, PropertyPack& outPack);
+	static void __internal_DeserializePropertyPackDataPerProperty(const PropertyPack& pack, GroovyObject* obj);
+	// v1 format, what files were before v2. the benchmark baseline
+	static void __internal_SerializePropertyPackV1(const PropertyPack& pack, DynamicBuffer& fileData);
+};
+
+// benchmark, property packs through the per-class plans against property by property, v2 files against v1
+void BenchmarkSerialization();
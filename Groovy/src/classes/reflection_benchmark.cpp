@@ -0,0 +1,125 @@
+#include "class_db.h"
+#include "engine/engine.h"
+#include "engine/benchmark_utils.h"
+
+#include <map>
+#include <stdio.h>
+
+static constexpr uint32 BENCHMARK_GAME_CLASSES = 256;
+static constexpr uint32 BENCHMARK_GAME_CLASS_PROPERTIES = 24;
+static constexpr uint32 BENCHMARK_ITERATIONS = 2000;
+
+// a game sized class db on top of the engine classes, wide gameplay classes
+static void GetGameClassProperties(std::vector<GroovyProperty>& outProps)
+{
+	static const char* NAMES[] = { "mHealth", "mMaxHealth", "mArmor", "mSpeed", "mJumpHeight", "mTeam", "mScore", "mLevel" };
+	for (uint32 i = 0; i < BENCHMARK_GAME_CLASS_PROPERTIES; i++)
+	{
+		std::string name = std::string(NAMES[i % 8]) + std::to_string(i / 8);
+		outProps.push_back({ name, PROPERTY_TYPE_FLOAT, 0, 8 + i * 4, 1, 0, 0 });
+	}
+}
+
+void BenchmarkReflection()
+{
+	static std::vector<GroovyClass> gameClasses;
+	gameClasses.reserve(BENCHMARK_GAME_CLASSES);
+	for (uint32 i = 0; i < BENCHMARK_GAME_CLASSES; i++)
+		gameClasses.push_back({ "BenchmarkGameClass" + std::to_string(i), 128, nullptr, nullptr, nullptr, &GetGameClassProperties, nullptr, nullptr, nullptr });
+
+	std::vector<GroovyClass*> classes = ENGINE_CLASSES;
+	for (GroovyClass& gClass : gameClasses)
+		classes.push_back(&gClass);
+	for (GroovyClass* gClass : classes)
+		gClassDB.Register(gClass);
+
+	// what ClassDB used to be
+	std::map<std::string, GroovyClass*> classMap;
+	std::map<GroovyClass*, std::vector<GroovyProperty>> propsMap;
+	for (GroovyClass* gClass : classes)
+	{
+		classMap[gClass->name] = gClass;
+		propsMap[gClass] = gClassDB[gClass];
+	}
+
+	// every class and every property, plus names that aren't there
+	std::vector<std::string> classNames;
+	std::vector<std::pair<GroovyClass*, std::string>> propQueries;
+	for (GroovyClass* gClass : classes)
+	{
+		classNames.push_back(gClass->name);
+		for (const GroovyProperty& prop : gClassDB[gClass])
+			propQueries.push_back({ gClass, prop.name });
+		propQueries.push_back({ gClass, "mRemovedProperty" });
+	}
+	classNames.push_back("RemovedClass");
+
+	fprintf(stdout, "Reflection lookups, %u classes, %u property queries, %u iterations\n", (uint32)classes.size(), (uint32)propQueries.size(), BENCHMARK_ITERATIONS);
+	benchmark::PrintColumns("lookup");
+
+	double classByNameMap = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		size_t found = 0;
+		for (const std::string& name : classNames)
+		{
+			auto it = classMap.find(name);
+			found += it != classMap.end() ? (size_t)it->second : 0;
+		}
+		benchmark::KeepResult(found);
+	});
+	double classByNameHashed = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		size_t found = 0;
+		for (const std::string& name : classNames)
+			found += (size_t)gClassDB[name];
+		benchmark::KeepResult(found);
+	});
+	benchmark::PrintCase("class by name, std::map", classByNameMap, classByNameMap, (double)classNames.size() * BENCHMARK_ITERATIONS);
+	benchmark::PrintCase("class by name, hashed", classByNameHashed, classByNameMap, (double)classNames.size() * BENCHMARK_ITERATIONS);
+
+	double propsOfClassMap = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		size_t count = 0;
+		for (GroovyClass* gClass : classes)
+			count += propsMap[gClass].size();
+		benchmark::KeepResult(count);
+	});
+	double propsOfClassCached = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		size_t count = 0;
+		for (GroovyClass* gClass : classes)
+			count += gClassDB[gClass].size();
+		benchmark::KeepResult(count);
+	});
+	benchmark::PrintCase("properties of class, std::map", propsOfClassMap, propsOfClassMap, (double)classes.size() * BENCHMARK_ITERATIONS);
+	benchmark::PrintCase("properties of class, cached", propsOfClassCached, propsOfClassMap, (double)classes.size() * BENCHMARK_ITERATIONS);
+
+	double propByNameLinear = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		size_t found = 0;
+		for (const auto& [gClass, name] : propQueries)
+		{
+			for (const GroovyProperty& prop : propsMap[gClass])
+			{
+				if (prop.name == name)
+				{
+					found += prop.offset;
+					break;
+				}
+			}
+		}
+		benchmark::KeepResult(found);
+	});
+	double propByNameHashed = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		size_t found = 0;
+		for (const auto& [gClass, name] : propQueries)
+		{
+			const GroovyProperty* prop = gClassDB.FindProperty(gClass, name);
+			found += prop ? prop->offset : 0;
+		}
+		benchmark::KeepResult(found);
+	});
+	benchmark::PrintCase("property by name, map + linear", propByNameLinear, propByNameLinear, (double)propQueries.size() * BENCHMARK_ITERATIONS);
+	benchmark::PrintCase("property by name, hashed", propByNameHashed, propByNameLinear, (double)propQueries.size() * BENCHMARK_ITERATIONS);
+}
@@ -0,0 +1,274 @@
+#include "object_serializer.h"
+#include "class_db.h"
+#include "runtime/object_allocator.h"
+#include "math/quat.h"
+#include "engine/benchmark_utils.h"
+
+#include <stdio.h>
+
+extern ClassDB gClassDB;
+
+static constexpr uint32 BENCHMARK_OBJECTS = 1024;
+static constexpr uint32 BENCHMARK_ITERATIONS = 200;
+static constexpr double BENCHMARK_ITEMS = (double)BENCHMARK_OBJECTS * BENCHMARK_ITERATIONS;
+
+// what a gameplay actor and its components usually reflect, mostly values with a few strings, arrays and asset refs
+
+GROOVY_CLASS_DECL(BenchmarkPawn)
+class BenchmarkPawn : public GroovyObject
+{
+	GROOVY_CLASS_BODY(BenchmarkPawn, GroovyObject)
+public:
+	bool mShouldTick = true;
+	bool mCanJump = true;
+	bool mIsAI = false;
+	Transform mTransform = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f } };
+	float mHealth = 100.0f;
+	float mMaxHealth = 100.0f;
+	float mMovementSpeed = 4.0f;
+	float mJumpHeight = 1.5f;
+	int32 mTeam = 0;
+	uint32 mScore = 0;
+	Vec3 mVelocity = { 0.0f, 0.0f, 0.0f };
+	Vec4 mTint = { 1.0f, 1.0f, 1.0f, 1.0f };
+	float mDamageMultipliers[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+	std::string mDisplayName = "Pawn";
+	Mesh* mMesh = nullptr;
+	Material* mMaterials[2] = {};
+	std::vector<float> mWaypointDelays;
+};
+
+GROOVY_CLASS_IMPL(BenchmarkPawn)
+	GROOVY_REFLECT(mShouldTick)
+	GROOVY_REFLECT(mCanJump)
+	GROOVY_REFLECT(mIsAI)
+	GROOVY_REFLECT(mTransform)
+	GROOVY_REFLECT(mHealth)
+	GROOVY_REFLECT(mMaxHealth)
+	GROOVY_REFLECT(mMovementSpeed)
+	GROOVY_REFLECT(mJumpHeight)
+	GROOVY_REFLECT(mTeam)
+	GROOVY_REFLECT(mScore)
+	GROOVY_REFLECT(mVelocity)
+	GROOVY_REFLECT(mTint)
+	GROOVY_REFLECT(mDamageMultipliers)
+	GROOVY_REFLECT(mDisplayName)
+	GROOVY_REFLECT(mMesh)
+	GROOVY_REFLECT(mMaterials)
+	GROOVY_REFLECT(mWaypointDelays)
+GROOVY_CLASS_END()
+
+GROOVY_CLASS_DECL(BenchmarkLightComponent)
+class BenchmarkLightComponent : public GroovyObject
+{
+	GROOVY_CLASS_BODY(BenchmarkLightComponent, GroovyObject)
+public:
+	Transform mTransform = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f } };
+	Vec3 mColor = { 1.0f, 1.0f, 1.0f };
+	float mIntensity = 1.0f;
+	float mRadius = 10.0f;
+	float mInnerAngle = 30.0f;
+	float mOuterAngle = 45.0f;
+	uint32 mShadowResolution = 1024;
+	bool mCastShadows = true;
+	Texture* mCookie = nullptr;
+};
+
+GROOVY_CLASS_IMPL(BenchmarkLightComponent)
+	GROOVY_REFLECT(mTransform)
+	GROOVY_REFLECT(mColor)
+	GROOVY_REFLECT(mIntensity)
+	GROOVY_REFLECT(mRadius)
+	GROOVY_REFLECT(mInnerAngle)
+	GROOVY_REFLECT(mOuterAngle)
+	GROOVY_REFLECT(mShadowResolution)
+	GROOVY_REFLECT(mCastShadows)
+	GROOVY_REFLECT(mCookie)
+GROOVY_CLASS_END()
+
+// a few properties changed per object, like a placed instance in a scene
+static void RandomizePawn(BenchmarkPawn* pawn, uint32 i)
+{
+	pawn->mTransform.location = { (float)(i % 64), 0.0f, (float)(i / 64) };
+	pawn->mTransform.rotation = math::QuatFromEuler({ 0.0f, (float)(i * 37 % 360), 0.0f });
+	if (i % 2)
+		pawn->mHealth = 50.0f + (float)(i % 50);
+	if (i % 3 == 0)
+		pawn->mTeam = i % 4;
+	if (i % 5 == 0)
+		pawn->mDisplayName = "Pawn_" + std::to_string(i);
+	if (i % 7 == 0)
+		pawn->mDamageMultipliers[i % 8] = 2.0f;
+	if (i % 4 == 0)
+		pawn->mWaypointDelays.assign(i % 16, 0.5f);
+}
+
+static void RandomizeLight(BenchmarkLightComponent* light, uint32 i)
+{
+	light->mTransform.location = { (float)(i % 32), 5.0f, (float)(i / 32) };
+	if (i % 2)
+		light->mColor = { 1.0f, 0.8f, 0.6f };
+	if (i % 3 == 0)
+		light->mIntensity = 2.0f;
+}
+
+static bool PacksEqual(const PropertyPack& a, const PropertyPack& b)
+{
+	if (a.desc.size() != b.desc.size() || a.data.used() != b.data.used())
+		return false;
+
+	for (size_t i = 0; i < a.desc.size(); i++)
+		if (a.desc[i].classProp != b.desc[i].classProp || a.desc[i].arrayCount != b.desc[i].arrayCount || a.desc[i].dataOffset != b.desc[i].dataOffset || a.desc[i].sizeBytes != b.desc[i].sizeBytes)
+			return false;
+
+	return memcmp(a.data.data(), b.data.data(), a.data.used()) == 0;
+}
+
+static void BenchmarkClass(const char* title, GroovyClass* gClass, void(*randomize)(GroovyObject*, uint32))
+{
+	std::vector<GroovyObject*> objects(BENCHMARK_OBJECTS);
+	std::vector<GroovyObject*> loadedObjects(BENCHMARK_OBJECTS);
+	for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+	{
+		objects[i] = ObjectAllocator::Instantiate(gClass);
+		randomize(objects[i], i);
+		loadedObjects[i] = ObjectAllocator::Instantiate(gClass);
+	}
+
+	const SerializationPlan& plan = gClassDB.GetSerializationPlan(gClass);
+	fprintf(stdout, "\n%s, %u properties in %u plan steps\n", title, (uint32)plan.props.size(), (uint32)plan.steps.size());
+	benchmark::PrintColumns("object");
+
+	std::vector<PropertyPack> packs(BENCHMARK_OBJECTS);
+	std::vector<PropertyPack> referencePacks(BENCHMARK_OBJECTS);
+
+	for (GroovyObject* cdo : { (GroovyObject*)nullptr, gClass->cdo })
+	{
+		const char* suffix = cdo ? " (cdo diff)" : " (full)";
+
+		double perProperty = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+		{
+			for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+			{
+				referencePacks[i] = PropertyPack();
+				ObjectSerializer::__internal_CreatePropertyPackPerProperty(objects[i], cdo, referencePacks[i]);
+			}
+		});
+		double planned = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+		{
+			for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+			{
+				packs[i] = PropertyPack();
+				ObjectSerializer::CreatePropertyPack(objects[i], cdo, packs[i]);
+			}
+		});
+
+		uint32 mismatches = 0;
+		for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+			mismatches += PacksEqual(packs[i], referencePacks[i]) ? 0 : 1;
+
+		benchmark::PrintCase((std::string("serialize, per property") + suffix).c_str(), perProperty, perProperty, BENCHMARK_ITEMS);
+		benchmark::PrintCase((std::string("serialize, plan") + suffix).c_str(), planned, perProperty, BENCHMARK_ITEMS);
+
+		double perPropertyLoad = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+		{
+			for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+				ObjectSerializer::__internal_DeserializePropertyPackDataPerProperty(packs[i], loadedObjects[i]);
+		});
+		double mergedLoad = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+		{
+			for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+				ObjectSerializer::DeserializePropertyPackData(packs[i], loadedObjects[i]);
+		});
+
+		// the loaded objects have to serialize back to the same packs
+		for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+		{
+			PropertyPack reloaded;
+			ObjectSerializer::CreatePropertyPack(loadedObjects[i], cdo, reloaded);
+			mismatches += PacksEqual(reloaded, packs[i]) ? 0 : 1;
+		}
+
+		benchmark::PrintCase((std::string("deserialize, per property") + suffix).c_str(), perPropertyLoad, perPropertyLoad, BENCHMARK_ITEMS);
+		benchmark::PrintCase((std::string("deserialize, merged") + suffix).c_str(), mergedLoad, perPropertyLoad, BENCHMARK_ITEMS);
+
+		// every pack in one file like a scene, v1 names every property, v2 has a name table for the file
+		DynamicBuffer fileV1;
+		DynamicBuffer fileV2;
+		DynamicBuffer namesV2;
+		PropertyNameTable names;
+		for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+		{
+			ObjectSerializer::__internal_SerializePropertyPackV1(packs[i], fileV1);
+			ObjectSerializer::SerializePropertyPack(packs[i], fileV2, &names);
+		}
+		names.Serialize(namesV2);
+
+		double loadV1 = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+		{
+			BufferView fileData(fileV1);
+			for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+			{
+				PropertyPack pack;
+				ObjectSerializer::DeserializePropertyPack(gClass, fileData, pack);
+				ObjectSerializer::DeserializePropertyPackData(pack, loadedObjects[i]);
+			}
+		});
+		double loadV2 = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+		{
+			PropertyNameTable fileNames;
+			BufferView namesData(namesV2);
+			fileNames.Deserialize(namesData);
+
+			BufferView fileData(fileV2);
+			for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+			{
+				PropertyPack pack;
+				ObjectSerializer::DeserializePropertyPack(gClass, fileData, pack, true, &fileNames);
+				ObjectSerializer::DeserializePropertyPackData(pack, loadedObjects[i]);
+			}
+		});
+
+		for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+		{
+			PropertyPack reloaded;
+			ObjectSerializer::CreatePropertyPack(loadedObjects[i], cdo, reloaded);
+			mismatches += PacksEqual(reloaded, packs[i]) ? 0 : 1;
+		}
+
+		benchmark::PrintCase((std::string("load file, v1") + suffix).c_str(), loadV1, loadV1, BENCHMARK_ITEMS);
+		benchmark::PrintCase((std::string("load file, v2 in place") + suffix).c_str(), loadV2, loadV1, BENCHMARK_ITEMS);
+		size_t sizeV2 = fileV2.used() + namesV2.used();
+		fprintf(stdout, "%-36s %10zu bytes, v2 %zu bytes (%.1f%%)\n", (std::string("file size, v1") + suffix).c_str(), fileV1.used(), sizeV2, 100.0 * sizeV2 / (fileV1.used() ? fileV1.used() : 1));
+
+		if (mismatches)
+			fprintf(stdout, "%u packs differ from the per property path\n", mismatches);
+	}
+
+	for (uint32 i = 0; i < BENCHMARK_OBJECTS; i++)
+	{
+		ObjectAllocator::Destroy(objects[i]);
+		ObjectAllocator::Destroy(loadedObjects[i]);
+	}
+}
+
+void BenchmarkSerialization()
+{
+	GroovyClass* classes[] = { BenchmarkPawn::StaticClass(), BenchmarkLightComponent::StaticClass() };
+	for (GroovyClass* gClass : classes)
+	{
+		gClassDB.Register(gClass);
+		gClassDB.BuildCDO(gClass);
+	}
+
+	fprintf(stdout, "Property packs of %u objects, %u iterations\n", BENCHMARK_OBJECTS, BENCHMARK_ITERATIONS);
+
+	BenchmarkClass("BenchmarkPawn", BenchmarkPawn::StaticClass(), [](GroovyObject* obj, uint32 i) { RandomizePawn((BenchmarkPawn*)obj, i); });
+	BenchmarkClass("BenchmarkLightComponent", BenchmarkLightComponent::StaticClass(), [](GroovyObject* obj, uint32 i) { RandomizeLight((BenchmarkLightComponent*)obj, i); });
+
+	for (GroovyClass* gClass : classes)
+	{
+		ObjectAllocator::Destroy(gClass->cdo);
+		gClass->cdo = nullptr;
+	}
+}
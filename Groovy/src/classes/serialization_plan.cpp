@@ -0,0 +1,57 @@
+#include "serialization_plan.h"
+
+void SerializationPlan_Build(const std::vector<GroovyProperty>& props, SerializationPlan& outPlan)
+{
+	outPlan.props.clear();
+	outPlan.steps.clear();
+
+	for (const GroovyProperty& prop : props)
+	{
+		if (prop.flags & PROPERTY_FLAG_NO_SERIALIZE)
+			continue;
+
+		bool dynamicArray = prop.flags & PROPERTY_FLAG_IS_DYNAMIC_ARRAY;
+		bool complex = prop.flags & PROPERTY_FLAG_IS_COMPLEX;
+
+		uint32 propIndex = (uint32)outPlan.props.size();
+		SerializedProperty& serializedProp = outPlan.props.emplace_back();
+		serializedProp.prop = &prop;
+		serializedProp.size = (uint32)GroovyProperty_GetSize(prop.type) * (dynamicArray ? 1 : prop.arrayCount);
+		serializedProp.dynamicArray = dynamicArray ? GroovyProperty_GetDynamicArrayPtr(prop.type) : DynamicArrayPtr{};
+
+		if (!complex && !dynamicArray)
+		{
+			// joins the previous run when it ends right where this property starts
+			if (!outPlan.steps.empty())
+			{
+				SerializationStep& last = outPlan.steps.back();
+				if (last.type == SERIALIZATION_STEP_VALUE_RUN && last.offset + last.size == prop.offset)
+				{
+					last.propCount++;
+					last.size += serializedProp.size;
+					continue;
+				}
+			}
+
+			outPlan.steps.push_back({ SERIALIZATION_STEP_VALUE_RUN, propIndex, 1, prop.offset, serializedProp.size });
+			continue;
+		}
+
+		ESerializationStepType type = SERIALIZATION_STEP_VALUE_DYNAMIC_ARRAY;
+		if (complex)
+		{
+			switch (prop.type)
+			{
+				case PROPERTY_TYPE_STRING:		type = SERIALIZATION_STEP_STRING; break;
+				case PROPERTY_TYPE_BUFFER:		type = SERIALIZATION_STEP_BUFFER; break;
+				case PROPERTY_TYPE_ASSET_REF:	type = SERIALIZATION_STEP_ASSET_REF; break;
+				default:
+					checkslowf(0, "Property serialization for this type not implemented");
+					outPlan.props.pop_back();
+					continue;
+			}
+		}
+
+		outPlan.steps.push_back({ type, propIndex, 1, prop.offset, serializedProp.size });
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "class.h"
+
+enum ESerializationStepType : uint32
+{
+	// adjacent value type properties (numbers, vectors, transforms, fixed arrays of them), one memcpy
+	SERIALIZATION_STEP_VALUE_RUN = 0,
+	// std::vector of a value type
+	SERIALIZATION_STEP_VALUE_DYNAMIC_ARRAY = 1,
+	SERIALIZATION_STEP_STRING = 2,
+	SERIALIZATION_STEP_BUFFER = 3,
+	SERIALIZATION_STEP_ASSET_REF = 4
+};
+
+struct SerializedProperty
+{
+	const GroovyProperty* prop;
+	// bytes in the object for fixed size properties, bytes of one element for dynamic arrays
+	uint32 size;
+	// dynamic arrays only, looked up once here instead of per object
+	DynamicArrayPtr dynamicArray;
+};
+
+struct SerializationStep
+{
+	ESerializationStepType type;
+	// in SerializationPlan::props, only value runs cover more than one
+	uint32 firstProp;
+	uint32 propCount;
+	// in the object, size is the whole run for value runs and SerializedProperty::size otherwise
+	uint32 offset;
+	uint32 size;
+};
+
+/*
+	What ObjectSerializer runs for a class instead of going through every property, built once by ClassDB::Register.
+	Properties keep their order (and PROPERTY_FLAG_NO_SERIALIZE ones are left out), so packs are the same as
+	serializing them one by one.
+
+	const SerializationPlan& plan = gClassDB.GetSerializationPlan(obj->GetClass());
+	for (const SerializationStep& step : plan.steps) ...
+*/
+struct SerializationPlan
+{
+	std::vector<SerializedProperty> props;
+	std::vector<SerializationStep> steps;
+};
+
+// props must outlive the plan, it points to them
+CORE_API void SerializationPlan_Build(const std::vector<GroovyProperty>& props, SerializationPlan& outPlan);
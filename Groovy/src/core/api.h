@@ -1,7 +1,12 @@
 #pragma once
 
-#define DLL_EXPORT __declspec(dllexport)
-#define DLL_IMPORT __declspec(dllimport)
+#if _MSC_VER
+	#define DLL_EXPORT __declspec(dllexport)
+	#define DLL_IMPORT __declspec(dllimport)
+#else
+	#define DLL_EXPORT __attribute__((visibility("default")))
+	#define DLL_IMPORT
+#endif
 
 #if !BUILD_MONOLITHIC
 	#if BUILD_GROOVY_CORE
@@ -24,9 +24,9 @@ void DisplayAssertError(const char* condition, const char* file, int line, const
 	memset(errorMsg, 0, 512);
 	
 	if(msg)
-		sprintf_s(errorMsg, 512, ASSERT_ERROR_MESSAGE, condition, file, line, proc, msg);
+		snprintf(errorMsg, 512, ASSERT_ERROR_MESSAGE, condition, file, line, proc, msg);
 	else
-		sprintf_s(errorMsg, 512, ASSERT_ERROR_NOMSG, condition, file, line, proc);
+		snprintf(errorMsg, 512, ASSERT_ERROR_NOMSG, condition, file, line, proc);
 
 	SysMessageBox::Show("Fatal error!", errorMsg, MESSAGE_BOX_TYPE_ERROR, MESSAGE_BOX_OPTIONS_OK);
 }
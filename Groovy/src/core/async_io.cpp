@@ -0,0 +1,319 @@
+#include "async_io.h"
+#include "core.h"
+#include "profiler.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_set>
+#include <algorithm>
+
+static std::vector<std::thread> sIOThreads;
+static bool sInitialized = false;
+static bool sQuit = false;
+
+// guards everything below and the status of queued requests
+static std::mutex sLock;
+static std::condition_variable sWakeIOThreads;
+static std::condition_variable sRequestDone;
+
+// submission order
+static std::vector<AsyncIORequest*> sPending;
+static std::unordered_set<std::string> sBusyPaths;
+static uint32 sInFlight = 0;
+// done, waiting for their callback (or to be deleted)
+static std::vector<AsyncIORequest*> sCompleted;
+
+AsyncIORequest::AsyncIORequest()
+	: mOperation(ASYNC_IO_OPERATION_READ), mPriority(ASYNC_IO_PRIORITY_NORMAL), mOffset(0),
+	mCallback(nullptr), mUserData(nullptr), mStatus(ASYNC_IO_STATUS_IDLE), mResult(FILE_OPEN_RESULT_OK), mOwnedByService(false)
+{
+}
+
+AsyncIORequest::~AsyncIORequest()
+{
+	if (GetStatus() == ASYNC_IO_STATUS_IDLE)
+		return;
+
+	AsyncIO::Cancel(this);
+	AsyncIO::Wait(this);
+
+	std::lock_guard<std::mutex> lock(sLock);
+	sCompleted.erase(std::remove(sCompleted.begin(), sCompleted.end(), this), sCompleted.end());
+}
+
+// request internals, touched by the io threads
+struct AsyncIOQueue
+{
+	static void ExecuteRequest(EAsyncIOOperation operation, const std::string& path, DynamicBuffer& writeData, size_t offset, Buffer& outData, EFileOpenResult& outResult)
+	{
+		GROOVY_PROFILE_SCOPE("Async IO request");
+
+		switch (operation)
+		{
+			case ASYNC_IO_OPERATION_READ:
+				outResult = FileSystem::ReadFileBinary(path, outData);
+				break;
+
+			case ASYNC_IO_OPERATION_WRITE:
+				outResult = FileSystem::WriteFileBinary(path, writeData);
+				break;
+
+			case ASYNC_IO_OPERATION_OVERWRITE:
+				outResult = FileSystem::OverwriteFileBinary(path, writeData.data(), writeData.used(), offset);
+				break;
+		}
+
+		// written data isn't needed anymore
+		writeData.free();
+	}
+
+	// lock held, the highest priority request whose path is free, oldest first
+	static int32 FindNextRequest()
+	{
+		int32 best = -1;
+		std::unordered_set<std::string> blockedPaths;
+
+		for (uint32 i = 0; i < sPending.size(); i++)
+		{
+			AsyncIORequest* request = sPending[i];
+			const std::string& path = request->GetPath();
+
+			// an older request on the same path goes first
+			if (sBusyPaths.count(path) || !blockedPaths.insert(path).second)
+				continue;
+
+			if (best == -1 || request->mPriority > sPending[best]->mPriority)
+				best = (int32)i;
+		}
+
+		return best;
+	}
+
+	// fire and forget requests, nothing can be waiting on them
+	static void DeleteOwnedRequest(AsyncIORequest* request)
+	{
+		request->mStatus.store(ASYNC_IO_STATUS_IDLE, std::memory_order_relaxed);
+		delete request;
+	}
+
+	static void FinishRequest(AsyncIORequest* request)
+	{
+		request->mStatus.store(ASYNC_IO_STATUS_DONE, std::memory_order_release);
+
+		if (request->mCallback)
+			sCompleted.push_back(request);
+		else if (request->mOwnedByService)
+			DeleteOwnedRequest(request);
+	}
+
+	static void IOThreadMain(uint32 threadIndex)
+	{
+		std::string threadName = "IO thread " + std::to_string(threadIndex);
+		Profiler::SetThreadName(threadName.c_str());
+
+		std::unique_lock<std::mutex> lock(sLock);
+		while (true)
+		{
+			int32 next = FindNextRequest();
+			if (next == -1)
+			{
+				if (sQuit && sPending.empty())
+					break;
+
+				sWakeIOThreads.wait(lock);
+				continue;
+			}
+
+			AsyncIORequest* request = sPending[next];
+			sPending.erase(sPending.begin() + next);
+			sBusyPaths.insert(request->mPath);
+			sInFlight++;
+			request->mStatus.store(ASYNC_IO_STATUS_IN_FLIGHT, std::memory_order_release);
+
+			lock.unlock();
+			ExecuteRequest(request->mOperation, request->mPath, request->mWriteData, request->mOffset, request->mData, request->mResult);
+			lock.lock();
+
+			sBusyPaths.erase(request->mPath);
+			sInFlight--;
+			FinishRequest(request);
+
+			// the path is free again, a request waiting on it may be able to run
+			sWakeIOThreads.notify_all();
+			sRequestDone.notify_all();
+		}
+	}
+
+	static void Submit(AsyncIORequest* request, const std::string& path, EAsyncIOOperation operation, DynamicBuffer&& data, size_t offset, EAsyncIOPriority priority, AsyncIOCallback callback, void* userData)
+	{
+		bool ownedByService = !request;
+		if (ownedByService)
+			request = new AsyncIORequest();
+
+		checkf(request->GetStatus() != ASYNC_IO_STATUS_PENDING && request->GetStatus() != ASYNC_IO_STATUS_IN_FLIGHT, "Async io request submitted while still running");
+
+		request->mPath = path;
+		request->mOperation = operation;
+		request->mPriority = priority;
+		request->mWriteData = std::move(data);
+		request->mOffset = offset;
+		request->mData.free();
+		request->mCallback = callback;
+		request->mUserData = userData;
+		request->mResult = FILE_OPEN_RESULT_OK;
+		request->mOwnedByService = ownedByService;
+
+		if (!sInitialized)
+		{
+			ExecuteRequest(operation, request->mPath, request->mWriteData, offset, request->mData, request->mResult);
+			request->mStatus.store(ASYNC_IO_STATUS_DONE, std::memory_order_release);
+			if (callback)
+				callback(request, userData);
+			if (ownedByService)
+				DeleteOwnedRequest(request);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(sLock);
+			request->mStatus.store(ASYNC_IO_STATUS_PENDING, std::memory_order_release);
+			sPending.push_back(request);
+		}
+		sWakeIOThreads.notify_one();
+	}
+};
+
+void AsyncIO::Init(uint32 threadCount)
+{
+	checkf(!sInitialized, "AsyncIO already initialized");
+
+	if (!threadCount)
+		threadCount = 1;
+
+	sQuit = false;
+	sInitialized = true;
+
+	for (uint32 i = 0; i < threadCount; i++)
+		sIOThreads.emplace_back(AsyncIOQueue::IOThreadMain, i);
+}
+
+void AsyncIO::Shutdown()
+{
+	if (!sInitialized)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(sLock);
+		sQuit = true;
+	}
+	sWakeIOThreads.notify_all();
+
+	for (std::thread& thread : sIOThreads)
+		thread.join();
+	sIOThreads.clear();
+
+	sInitialized = false;
+
+	// last callbacks
+	Update();
+}
+
+bool AsyncIO::IsInitialized()
+{
+	return sInitialized;
+}
+
+void AsyncIO::ReadAsync(const std::string& path, AsyncIORequest* request, EAsyncIOPriority priority, AsyncIOCallback callback, void* userData)
+{
+	checkf(request, "Async reads need a request to hold the data");
+	AsyncIOQueue::Submit(request, path, ASYNC_IO_OPERATION_READ, DynamicBuffer(), 0, priority, callback, userData);
+}
+
+void AsyncIO::WriteAsync(const std::string& path, DynamicBuffer&& data, AsyncIORequest* request, EAsyncIOPriority priority, AsyncIOCallback callback, void* userData)
+{
+	AsyncIOQueue::Submit(request, path, ASYNC_IO_OPERATION_WRITE, std::move(data), 0, priority, callback, userData);
+}
+
+void AsyncIO::OverwriteAsync(const std::string& path, DynamicBuffer&& data, size_t offset, AsyncIORequest* request, EAsyncIOPriority priority, AsyncIOCallback callback, void* userData)
+{
+	AsyncIOQueue::Submit(request, path, ASYNC_IO_OPERATION_OVERWRITE, std::move(data), offset, priority, callback, userData);
+}
+
+bool AsyncIO::Cancel(AsyncIORequest* request)
+{
+	std::lock_guard<std::mutex> lock(sLock);
+
+	auto it = std::find(sPending.begin(), sPending.end(), request);
+	if (it == sPending.end())
+		return false;
+
+	sPending.erase(it);
+	request->mStatus.store(ASYNC_IO_STATUS_CANCELED, std::memory_order_release);
+	if (request->mOwnedByService)
+		AsyncIOQueue::DeleteOwnedRequest(request);
+
+	sRequestDone.notify_all();
+	return true;
+}
+
+void AsyncIO::Wait(AsyncIORequest* request)
+{
+	if (request->GetStatus() == ASYNC_IO_STATUS_IDLE)
+		return;
+
+	GROOVY_PROFILE_FUNCTION();
+
+	std::unique_lock<std::mutex> lock(sLock);
+	sRequestDone.wait(lock, [=]() { return request->IsDone(); });
+}
+
+void AsyncIO::WaitForPath(const std::string& path)
+{
+	if (!sInitialized)
+		return;
+
+	std::unique_lock<std::mutex> lock(sLock);
+	sRequestDone.wait(lock, [&]()
+	{
+		if (sBusyPaths.count(path))
+			return false;
+		for (AsyncIORequest* request : sPending)
+			if (request->mPath == path)
+				return false;
+		return true;
+	});
+}
+
+void AsyncIO::Flush()
+{
+	if (!sInitialized)
+		return;
+
+	GROOVY_PROFILE_FUNCTION();
+
+	std::unique_lock<std::mutex> lock(sLock);
+	sRequestDone.wait(lock, []() { return sPending.empty() && !sInFlight; });
+}
+
+void AsyncIO::Update()
+{
+	std::vector<AsyncIORequest*> completed;
+	{
+		std::lock_guard<std::mutex> lock(sLock);
+		completed.swap(sCompleted);
+	}
+
+	for (AsyncIORequest* request : completed)
+	{
+		request->mCallback(request, request->mUserData);
+		if (request->mOwnedByService)
+			AsyncIOQueue::DeleteOwnedRequest(request);
+	}
+}
+
+uint32 AsyncIO::GetPendingCount()
+{
+	std::lock_guard<std::mutex> lock(sLock);
+	return (uint32)sPending.size() + sInFlight;
+}
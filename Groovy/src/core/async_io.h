@@ -0,0 +1,115 @@
+#pragma once
+
+#include "coreminimal.h"
+#include "platform/filesystem.h"
+
+#include <atomic>
+
+enum EAsyncIOPriority
+{
+	ASYNC_IO_PRIORITY_LOW,
+	ASYNC_IO_PRIORITY_NORMAL,
+	ASYNC_IO_PRIORITY_HIGH
+};
+
+enum EAsyncIOStatus
+{
+	ASYNC_IO_STATUS_IDLE,
+	ASYNC_IO_STATUS_PENDING,
+	ASYNC_IO_STATUS_IN_FLIGHT,
+	ASYNC_IO_STATUS_DONE,
+	ASYNC_IO_STATUS_CANCELED
+};
+
+enum EAsyncIOOperation
+{
+	ASYNC_IO_OPERATION_READ,
+	ASYNC_IO_OPERATION_WRITE,
+	ASYNC_IO_OPERATION_OVERWRITE
+};
+
+class AsyncIORequest;
+
+// runs on the main thread (see AsyncIO::Update)
+typedef void(*AsyncIOCallback)(AsyncIORequest* request, void* userData);
+
+/*
+	One file operation, owned by the caller (or by AsyncIO for fire and forget requests).
+	Destroying a request cancels it if it hasn't started yet, or waits for it.
+	A request with a callback must be destroyed on the main thread.
+*/
+class CORE_API AsyncIORequest
+{
+public:
+	AsyncIORequest();
+	AsyncIORequest(const AsyncIORequest&) = delete;
+	AsyncIORequest& operator=(const AsyncIORequest&) = delete;
+	~AsyncIORequest();
+
+	inline EAsyncIOStatus GetStatus() const { return (EAsyncIOStatus)mStatus.load(std::memory_order_acquire); }
+	inline bool IsDone() const { EAsyncIOStatus status = GetStatus(); return status == ASYNC_IO_STATUS_DONE || status == ASYNC_IO_STATUS_CANCELED; }
+	inline EFileOpenResult GetResult() const { return mResult; }
+	inline const std::string& GetPath() const { return mPath; }
+
+	// file content for reads, valid once done
+	inline Buffer& GetData() { return mData; }
+
+private:
+	std::string mPath;
+	EAsyncIOOperation mOperation;
+	EAsyncIOPriority mPriority;
+	DynamicBuffer mWriteData;
+	size_t mOffset;
+	Buffer mData;
+
+	AsyncIOCallback mCallback;
+	void* mUserData;
+
+	std::atomic<int32> mStatus;
+	EFileOpenResult mResult;
+	bool mOwnedByService;
+
+	friend class AsyncIO;
+	friend struct AsyncIOQueue;
+};
+
+/*
+	File reads and writes on dedicated io threads, the caller never blocks on the disk.
+	Requests run by priority, at most one per io thread at a time. Requests on the same path run in submission order,
+	so a read queued after a write sees the written data.
+	Without Init requests run right away on the calling thread.
+
+	AsyncIORequest request;
+	AsyncIO::ReadAsync(path, &request);
+	...
+	if (request.IsDone()) Parse(request.GetData());
+
+	AsyncIO::WriteAsync(path, std::move(fileData));	// fire and forget
+*/
+class CORE_API AsyncIO
+{
+public:
+	// threadCount = requests in flight at once
+	static void Init(uint32 threadCount = 2);
+	// runs every queued request first, writes are never dropped
+	static void Shutdown();
+	static bool IsInitialized();
+
+	// request is optional for writes, without it AsyncIO owns the request. callback (optional) runs on the main thread once done
+	static void ReadAsync(const std::string& path, AsyncIORequest* request, EAsyncIOPriority priority = ASYNC_IO_PRIORITY_NORMAL, AsyncIOCallback callback = nullptr, void* userData = nullptr);
+	static void WriteAsync(const std::string& path, DynamicBuffer&& data, AsyncIORequest* request = nullptr, EAsyncIOPriority priority = ASYNC_IO_PRIORITY_NORMAL, AsyncIOCallback callback = nullptr, void* userData = nullptr);
+	static void OverwriteAsync(const std::string& path, DynamicBuffer&& data, size_t offset, AsyncIORequest* request = nullptr, EAsyncIOPriority priority = ASYNC_IO_PRIORITY_NORMAL, AsyncIOCallback callback = nullptr, void* userData = nullptr);
+
+	// drops a request that hasn't started yet (no callback), false if it's already running or done
+	static bool Cancel(AsyncIORequest* request);
+	static void Wait(AsyncIORequest* request);
+	// waits for every request on path, call it before touching the file synchronously
+	static void WaitForPath(const std::string& path);
+	// waits for every request
+	static void Flush();
+
+	// main thread, once per frame, runs the callbacks of the finished requests
+	static void Update();
+
+	static uint32 GetPendingCount();
+};
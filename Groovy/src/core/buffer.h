@@ -234,12 +234,6 @@ public:
 		return push_bytes(data, (sizeof(T) * count));
 	}
 
-	template<>
-	void* push(const std::string& str)
-	{
-		return push_bytes(str.c_str(), str.length() + 1);
-	}
-
 	inline void pop(size_t size)
 	{
 		check(mCurrentPtr - size >= mData);
@@ -290,6 +284,12 @@ private:
 	byte* mCurrentPtr;
 };
 
+template<>
+inline void* DynamicBuffer::push(const std::string& str)
+{
+	return push_bytes(str.c_str(), str.length() + 1);
+}
+
 // Warning: push a size_t before tracking
 #define DYNAMIC_BUFFER_TRACK(TrackerName, BufferVar) size_t TrackerName = BufferVar.used()
 #define DYNAMIC_BUFFER_TRACK_WRITE_RESULT(TrackerName, BufferVar) *(size_t*)(BufferVar.current() - (BufferVar.used() - TrackerName) - sizeof(size_t)) = BufferVar.used() - TrackerName
@@ -337,14 +337,6 @@ public:
 		return ptr;
 	}
 
-	template<>
-	std::string read<std::string>()
-	{
-		std::string str((char*)mCurrentPtr);
-		advance(str.length() + 1);
-		return str;
-	}
-
 	byte* read_to_end()
 	{
 		byte* ptr = mCurrentPtr;
@@ -365,4 +357,12 @@ public:
 private:
 	byte* mCurrentPtr;
 	size_t mBytesLeft;
-};
\ No newline at end of file
+};
+
+template<>
+inline std::string BufferView::read<std::string>()
+{
+	std::string str((char*)mCurrentPtr);
+	advance(str.length() + 1);
+	return str;
+}
\ No newline at end of file
@@ -4,7 +4,9 @@
 
 #include <vector>
 #include <string>
+#include <algorithm>
 
 #include "assert.h"
 #include "buffer.h"
-#include "log.h"
\ No newline at end of file
+#include "log.h"
+#include "profiler.h"
\ No newline at end of file
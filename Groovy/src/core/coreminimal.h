@@ -1,6 +1,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
 
 typedef int8_t		int8;
 typedef int16_t		int16;
@@ -0,0 +1,446 @@
+#include "jobs.h"
+#include "core.h"
+
+#include <thread>
+#include <condition_variable>
+#include <deque>
+
+// per thread, a full deque runs the job inline instead
+static constexpr int64 JOB_QUEUE_CAPACITY = 4096;
+// how many times an idle worker looks for work before going to sleep
+static constexpr uint32 JOB_IDLE_SPINS = 64;
+
+struct Job
+{
+	JobDecl decl;
+	JobCounter* counter;
+};
+
+/*
+	Chase-Lev deque: the owner pushes and pops at the bottom, thieves take from the top.
+	Fixed capacity, indices only grow.
+*/
+class JobQueue
+{
+public:
+	JobQueue() : mTop(0), mBottom(0) {}
+
+	// owner only
+	bool Push(const Job& job)
+	{
+		int64 bottom = mBottom.load(std::memory_order_relaxed);
+		int64 top = mTop.load(std::memory_order_acquire);
+		if (bottom - top >= JOB_QUEUE_CAPACITY)
+			return false;
+
+		mJobs[bottom & (JOB_QUEUE_CAPACITY - 1)].Store(job);
+		mBottom.store(bottom + 1, std::memory_order_release);
+		return true;
+	}
+
+	// owner only
+	bool Pop(Job& outJob)
+	{
+		int64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+		mBottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64 top = mTop.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		outJob = mJobs[bottom & (JOB_QUEUE_CAPACITY - 1)].Load();
+		if (top == bottom)
+		{
+			// last job, race the thieves for it
+			bool won = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	// any thread
+	bool Steal(Job& outJob)
+	{
+		int64 top = mTop.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64 bottom = mBottom.load(std::memory_order_acquire);
+		if (top >= bottom)
+			return false;
+
+		// the owner may be overwriting this slot already, the compare exchange fails in that case
+		outJob = mJobs[top & (JOB_QUEUE_CAPACITY - 1)].Load();
+		return mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	bool IsEmpty() const
+	{
+		return mTop.load(std::memory_order_seq_cst) >= mBottom.load(std::memory_order_seq_cst);
+	}
+
+private:
+	// slots are read by thieves while the owner may write them, hence relaxed atomics
+	struct Slot
+	{
+		std::atomic<JobFunc> func;
+		std::atomic<void*> data;
+		std::atomic<JobCounter*> counter;
+
+		void Store(const Job& job)
+		{
+			func.store(job.decl.func, std::memory_order_relaxed);
+			data.store(job.decl.data, std::memory_order_relaxed);
+			counter.store(job.counter, std::memory_order_relaxed);
+		}
+
+		Job Load() const
+		{
+			return { { func.load(std::memory_order_relaxed), data.load(std::memory_order_relaxed) }, counter.load(std::memory_order_relaxed) };
+		}
+	};
+
+	// top and bottom on their own cache lines, thieves hammer top
+	alignas(64) std::atomic<int64> mTop;
+	alignas(64) std::atomic<int64> mBottom;
+	alignas(64) Slot mJobs[JOB_QUEUE_CAPACITY];
+};
+
+static bool sInitialized = false;
+static uint32 sThreadCount = 1;
+static JobQueue* sQueues = nullptr;
+static std::vector<std::thread> sWorkers;
+
+// jobs queued by threads outside the system
+static std::mutex sSharedQueueLock;
+static std::deque<Job> sSharedQueue;
+static std::atomic<uint32> sSharedQueueSize = 0;
+
+// jobs that only the main thread can run
+static std::mutex sMainThreadQueueLock;
+static std::vector<Job> sMainThreadQueue;
+static std::atomic<uint32> sMainThreadQueueSize = 0;
+
+static std::mutex sSleepLock;
+static std::condition_variable sWakeWorkers;
+static std::atomic<uint32> sSleepingWorkers = 0;
+static std::atomic<bool> sQuit = false;
+
+static thread_local uint32 tThreadIndex = JOBS_INVALID_THREAD_INDEX;
+
+JobCounter::~JobCounter()
+{
+	checkf(IsDone(), "JobCounter destroyed while its jobs are still running");
+
+	// the last job may still be releasing the deferred jobs
+	std::lock_guard<std::mutex> lock(mDeferredLock);
+}
+
+static void WakeWorkers(uint32 jobsCount)
+{
+	if (!sSleepingWorkers.load(std::memory_order_seq_cst))
+		return;
+
+	// taking the lock makes sure a worker going to sleep either sees the new jobs or gets the notification
+	std::lock_guard<std::mutex> lock(sSleepLock);
+	if (jobsCount == 1)
+		sWakeWorkers.notify_one();
+	else
+		sWakeWorkers.notify_all();
+}
+
+static void PushJobs(const Job* jobs, uint32 count)
+{
+	uint32 threadIndex = tThreadIndex;
+	if (threadIndex != JOBS_INVALID_THREAD_INDEX)
+	{
+		for (uint32 i = 0; i < count; i++)
+		{
+			if (!sQueues[threadIndex].Push(jobs[i]))
+			{
+				// queue is full, run it here (jobs must not rely on running in parallel with the caller)
+				jobs[i].decl.func(jobs[i].decl.data);
+				if (jobs[i].counter)
+					Jobs::__internal_FinishJob(jobs[i].counter);
+			}
+		}
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(sSharedQueueLock);
+		sSharedQueue.insert(sSharedQueue.end(), jobs, jobs + count);
+		sSharedQueueSize.store((uint32)sSharedQueue.size(), std::memory_order_seq_cst);
+	}
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	WakeWorkers(count);
+}
+
+static bool FindJob(uint32 threadIndex, Job& outJob)
+{
+	if (threadIndex != JOBS_INVALID_THREAD_INDEX && sQueues[threadIndex].Pop(outJob))
+		return true;
+
+	// steal, starting from the next thread so thieves spread over the queues
+	uint32 first = threadIndex != JOBS_INVALID_THREAD_INDEX ? threadIndex + 1 : 0;
+	for (uint32 i = 0; i < sThreadCount; i++)
+	{
+		uint32 victim = (first + i) % sThreadCount;
+		if (victim != threadIndex && sQueues[victim].Steal(outJob))
+			return true;
+	}
+
+	if (sSharedQueueSize.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> lock(sSharedQueueLock);
+		if (sSharedQueue.size())
+		{
+			outJob = sSharedQueue.front();
+			sSharedQueue.pop_front();
+			sSharedQueueSize.store((uint32)sSharedQueue.size(), std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool HasQueuedJobs()
+{
+	for (uint32 i = 0; i < sThreadCount; i++)
+		if (!sQueues[i].IsEmpty())
+			return true;
+
+	return sSharedQueueSize.load(std::memory_order_seq_cst) != 0;
+}
+
+static void RunJob(const Job& job)
+{
+	job.decl.func(job.decl.data);
+	if (job.counter)
+		Jobs::__internal_FinishJob(job.counter);
+}
+
+static void WorkerMain(uint32 threadIndex)
+{
+	tThreadIndex = threadIndex;
+
+	std::string threadName = "Job worker " + std::to_string(threadIndex);
+	Profiler::SetThreadName(threadName.c_str());
+
+	uint32 idleSpins = 0;
+	while (true)
+	{
+		Job job;
+		if (FindJob(threadIndex, job))
+		{
+			RunJob(job);
+			idleSpins = 0;
+			continue;
+		}
+
+		if (++idleSpins < JOB_IDLE_SPINS)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sSleepLock);
+		sSleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+		// jobs pushed before the increment are visible here, the ones pushed after will notify
+		if (!HasQueuedJobs() && !sQuit.load(std::memory_order_seq_cst))
+			sWakeWorkers.wait(lock);
+		sSleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+		idleSpins = 0;
+
+		if (sQuit.load(std::memory_order_acquire) && !HasQueuedJobs())
+			break;
+	}
+
+	tThreadIndex = JOBS_INVALID_THREAD_INDEX;
+}
+
+void Jobs::Init(uint32 threadCount)
+{
+	checkf(!sInitialized, "Jobs already initialized");
+
+	if (!threadCount)
+		threadCount = std::thread::hardware_concurrency();
+	if (!threadCount)
+		threadCount = 1;
+
+	sThreadCount = threadCount;
+	sQueues = new JobQueue[threadCount];
+	sQuit = false;
+	tThreadIndex = 0;
+	sInitialized = true;
+
+	for (uint32 i = 1; i < threadCount; i++)
+		sWorkers.emplace_back(WorkerMain, i);
+
+	GROOVY_LOG_INFO("Job system started with %u threads", threadCount);
+}
+
+void Jobs::Shutdown()
+{
+	if (!sInitialized)
+		return;
+
+	// drain, then let the workers go
+	PumpMainThreadJobs();
+	Job job;
+	while (FindJob(tThreadIndex, job))
+		RunJob(job);
+
+	{
+		std::lock_guard<std::mutex> lock(sSleepLock);
+		sQuit = true;
+		sWakeWorkers.notify_all();
+	}
+
+	for (std::thread& worker : sWorkers)
+		worker.join();
+	sWorkers.clear();
+
+	delete[] sQueues;
+	sQueues = nullptr;
+	sThreadCount = 1;
+	tThreadIndex = JOBS_INVALID_THREAD_INDEX;
+	sInitialized = false;
+}
+
+bool Jobs::IsInitialized()
+{
+	return sInitialized;
+}
+
+uint32 Jobs::GetThreadCount()
+{
+	return sThreadCount;
+}
+
+uint32 Jobs::GetCurrentThreadIndex()
+{
+	return tThreadIndex;
+}
+
+void Jobs::Run(const JobDecl* jobs, uint32 count, JobCounter* counter, JobCounter* dependency)
+{
+	if (!count)
+		return;
+
+	if (counter)
+		counter->mValue.fetch_add((int32)count, std::memory_order_acq_rel);
+
+	if (!sInitialized)
+	{
+		checkf(!dependency || dependency->IsDone(), "Job dependency can't be waited on without the job system");
+		for (uint32 i = 0; i < count; i++)
+			RunJob({ jobs[i], counter });
+		return;
+	}
+
+	if (dependency)
+	{
+		std::lock_guard<std::mutex> lock(dependency->mDeferredLock);
+		// the last job of the dependency takes the same lock after reaching zero, so jobs added here are never missed
+		if (!dependency->IsDone())
+		{
+			for (uint32 i = 0; i < count; i++)
+				dependency->mDeferred.push_back({ jobs[i], counter });
+			return;
+		}
+	}
+
+	Job queued[64];
+	for (uint32 first = 0; first < count; first += 64)
+	{
+		uint32 batchCount = count - first < 64 ? count - first : 64;
+		for (uint32 i = 0; i < batchCount; i++)
+			queued[i] = { jobs[first + i], counter };
+		PushJobs(queued, batchCount);
+	}
+}
+
+void Jobs::Wait(const JobCounter* counter)
+{
+	if (!counter)
+		return;
+
+	uint32 threadIndex = tThreadIndex;
+	while (!counter->IsDone())
+	{
+		if (threadIndex == 0 && sMainThreadQueueSize.load(std::memory_order_acquire))
+		{
+			PumpMainThreadJobs();
+			continue;
+		}
+
+		Job job;
+		if (sInitialized && FindJob(threadIndex, job))
+			RunJob(job);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void Jobs::RunOnMainThread(JobDecl job, JobCounter* counter)
+{
+	if (counter)
+		counter->mValue.fetch_add(1, std::memory_order_acq_rel);
+
+	if (!sInitialized || tThreadIndex == 0)
+	{
+		RunJob({ job, counter });
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(sMainThreadQueueLock);
+	sMainThreadQueue.push_back({ job, counter });
+	sMainThreadQueueSize.store((uint32)sMainThreadQueue.size(), std::memory_order_release);
+}
+
+void Jobs::PumpMainThreadJobs()
+{
+	checkf(!sInitialized || tThreadIndex == 0, "PumpMainThreadJobs called outside of the main thread");
+
+	while (sMainThreadQueueSize.load(std::memory_order_acquire))
+	{
+		// taken out of the queue, jobs can queue more main thread work (or pump again) while running
+		std::vector<Job> jobs;
+		{
+			std::lock_guard<std::mutex> lock(sMainThreadQueueLock);
+			jobs.swap(sMainThreadQueue);
+			sMainThreadQueueSize.store(0, std::memory_order_release);
+		}
+
+		for (const Job& job : jobs)
+			RunJob(job);
+	}
+}
+
+void Jobs::__internal_FinishJob(JobCounter* counter)
+{
+	int32 value = counter->mValue.load(std::memory_order_relaxed);
+	while (value > 1)
+		if (counter->mValue.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+			return;
+
+	// possibly the last one, reaching zero happens under the lock so Run can't miss it
+	// and the counter can't be destroyed before we are done with it
+	std::vector<JobCounter::DeferredJob> deferred;
+	{
+		std::lock_guard<std::mutex> lock(counter->mDeferredLock);
+		if (counter->mValue.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			deferred.swap(counter->mDeferred);
+	}
+
+	for (const JobCounter::DeferredJob& deferredJob : deferred)
+	{
+		Job job = { deferredJob.decl, deferredJob.counter };
+		PushJobs(&job, 1);
+	}
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "coreminimal.h"
+#include "assert.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+#define JOBS_INVALID_THREAD_INDEX 0xFFFFFFFF
+// ParallelFor never splits a range in more batches than this, the batches live on the caller stack
+#define JOBS_MAX_PARALLEL_FOR_BATCHES 256
+
+typedef void(*JobFunc)(void* data);
+
+struct JobDecl
+{
+	JobFunc func;
+	// must stay alive until the job has run
+	void* data;
+};
+
+/*
+	Counts the jobs that still have to finish, Jobs::Run adds to it and every finished job takes one away.
+	Jobs waiting on a counter (see Jobs::Run dependency) are queued as soon as it reaches zero.
+	A counter must outlive every job that references it.
+*/
+class CORE_API JobCounter
+{
+public:
+	JobCounter() : mValue(0) {}
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+	~JobCounter();
+
+	bool IsDone() const { return mValue.load(std::memory_order_acquire) == 0; }
+	uint32 GetValue() const { return (uint32)mValue.load(std::memory_order_acquire); }
+
+private:
+	struct DeferredJob
+	{
+		JobDecl decl;
+		JobCounter* counter;
+	};
+
+	std::atomic<int32> mValue;
+	std::mutex mDeferredLock;
+	std::vector<DeferredJob> mDeferred;
+
+	friend class Jobs;
+};
+
+/*
+	Job system: one thread per hardware thread (the thread calling Init is thread 0 and only runs jobs while waiting),
+	every thread owns a work-stealing deque, idle threads steal from the others and sleep when there's nothing left.
+	Jobs queued from threads that don't belong to the system go through a shared queue.
+	Usable from game code, it's exported with the core.
+
+	JobCounter counter;
+	Jobs::Run({ MyJob, &myData }, &counter);
+	Jobs::ParallelFor(count, 64, [&](uint32 begin, uint32 end) { ... });
+	Jobs::Wait(&counter);	// runs other jobs in the meantime
+*/
+class CORE_API Jobs
+{
+public:
+	// threadCount includes the calling thread, 0 = one per hardware thread
+	static void Init(uint32 threadCount = 0);
+	// waits for every queued job, then joins the workers
+	static void Shutdown();
+	static bool IsInitialized();
+
+	// threads running jobs, main thread included (1 when not initialized)
+	static uint32 GetThreadCount();
+	// 0 = main thread, 1..GetThreadCount() - 1 = workers, JOBS_INVALID_THREAD_INDEX = any other thread
+	static uint32 GetCurrentThreadIndex();
+
+	// counter (optional) is increased by count, jobs don't start before dependency (optional) reaches zero.
+	// without Init jobs run right away on the calling thread
+	static void Run(const JobDecl* jobs, uint32 count, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+	static void Run(JobDecl job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr) { Run(&job, 1, counter, dependency); }
+
+	// callable is copied to the heap and freed after it runs
+	template<typename Func>
+	static void RunFunc(Func&& func, JobCounter* counter = nullptr, JobCounter* dependency = nullptr)
+	{
+		typedef typename std::decay<Func>::type FuncType;
+		JobDecl decl = { [](void* data) { FuncType* f = (FuncType*)data; (*f)(); delete f; }, new FuncType(std::forward<Func>(func)) };
+		Run(&decl, 1, counter, dependency);
+	}
+
+	// runs queued jobs on the calling thread until counter reaches zero, the main thread also runs its own jobs (see RunOnMainThread)
+	static void Wait(const JobCounter* counter);
+
+	// for work that must happen on the main thread (gpu objects creation), it runs in Wait or PumpMainThreadJobs.
+	// called from the main thread (or without Init) the job runs right away
+	static void RunOnMainThread(JobDecl job, JobCounter* counter = nullptr);
+	// main thread only, runs the jobs queued with RunOnMainThread
+	static void PumpMainThreadJobs();
+
+	// runs func on the main thread and returns once it's done, the calling thread runs other jobs in the meantime.
+	// the main thread must end up in Wait or PumpMainThreadJobs
+	template<typename Func>
+	static void CallOnMainThread(const Func& func)
+	{
+		JobCounter counter;
+		RunOnMainThread({ [](void* data) { (*(const Func*)data)(); }, (void*)&func }, &counter);
+		Wait(&counter);
+	}
+
+	// func(begin, end) over [0, count) in batches of grainSize (0 = picked from count and thread count), returns when every batch is done
+	template<typename Func>
+	static void ParallelFor(uint32 count, uint32 grainSize, const Func& func)
+	{
+		if (!count)
+			return;
+
+		uint32 threadCount = GetThreadCount();
+		if (!grainSize)
+			grainSize = (count + threadCount * 4 - 1) / (threadCount * 4);
+
+		uint32 batchCount = (count + grainSize - 1) / grainSize;
+		if (batchCount <= 1 || threadCount <= 1)
+		{
+			func(0u, count);
+			return;
+		}
+
+		if (batchCount > JOBS_MAX_PARALLEL_FOR_BATCHES)
+		{
+			grainSize = (count + JOBS_MAX_PARALLEL_FOR_BATCHES - 1) / JOBS_MAX_PARALLEL_FOR_BATCHES;
+			batchCount = (count + grainSize - 1) / grainSize;
+		}
+
+		struct Batch
+		{
+			const Func* func;
+			uint32 begin, end;
+		};
+
+		Batch batches[JOBS_MAX_PARALLEL_FOR_BATCHES];
+		JobDecl decls[JOBS_MAX_PARALLEL_FOR_BATCHES];
+
+		// the caller takes the first batch itself
+		for (uint32 i = 1; i < batchCount; i++)
+		{
+			batches[i] = { &func, i * grainSize, (i + 1) * grainSize < count ? (i + 1) * grainSize : count };
+			decls[i - 1] = { [](void* data) { Batch* batch = (Batch*)data; (*batch->func)(batch->begin, batch->end); }, &batches[i] };
+		}
+
+		JobCounter counter;
+		Run(decls, batchCount - 1, &counter);
+		func(0u, grainSize);
+		Wait(&counter);
+	}
+
+	// for internal use
+	static void __internal_FinishJob(JobCounter* counter);
+};
+
+// benchmark, job overhead and ParallelFor scaling from 1 to N threads
+void BenchmarkJobs();
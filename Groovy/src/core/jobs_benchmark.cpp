@@ -0,0 +1,101 @@
+#include "jobs.h"
+#include "core.h"
+
+#include <chrono>
+#include <thread>
+#include <math.h>
+#include <stdio.h>
+
+static constexpr uint32 BENCHMARK_ELEMENTS = 1 << 22;
+// queued in rounds that fit in a job queue
+static constexpr uint32 BENCHMARK_EMPTY_JOBS = 2048;
+static constexpr uint32 BENCHMARK_EMPTY_JOBS_ROUNDS = 32;
+static constexpr uint32 BENCHMARK_RUNS = 5;
+
+static void EmptyJob(void* data)
+{
+}
+
+// some math per element, enough to be compute bound
+static void ProcessElements(float* elements, uint32 begin, uint32 end)
+{
+	for (uint32 i = begin; i < end; i++)
+	{
+		float v = elements[i];
+		for (uint32 k = 0; k < 16; k++)
+			v = sqrtf(v * v + 1.0f) * 0.5f;
+		elements[i] = v;
+	}
+}
+
+static double Seconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void BenchmarkJobs()
+{
+	uint32 previousThreadCount = Jobs::IsInitialized() ? Jobs::GetThreadCount() : 0;
+	Jobs::Shutdown();
+
+	std::vector<uint32> threadCounts;
+	uint32 hardwareThreads = std::thread::hardware_concurrency();
+	for (uint32 threads = 1; threads < hardwareThreads; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(hardwareThreads ? hardwareThreads : 1);
+
+	std::vector<float> elements(BENCHMARK_ELEMENTS);
+	std::vector<JobDecl> emptyJobs(BENCHMARK_EMPTY_JOBS, { EmptyJob, nullptr });
+
+	fprintf(stdout, "Job system, best of %u runs\n", BENCHMARK_RUNS);
+	fprintf(stdout, "%8s %18s %9s %18s %18s\n", "threads", "ParallelFor ms", "speedup", "ParallelFor/64 ms", "empty jobs/s");
+
+	double singleThreadTime = 0.0;
+	for (uint32 threads : threadCounts)
+	{
+		Jobs::Init(threads);
+
+		double parallelFor = 1e30, parallelForFine = 1e30, emptyJobsTime = 1e30;
+		for (uint32 run = 0; run < BENCHMARK_RUNS; run++)
+		{
+			std::fill(elements.begin(), elements.end(), (float)run);
+
+			// automatic grain
+			auto start = std::chrono::steady_clock::now();
+			Jobs::ParallelFor(BENCHMARK_ELEMENTS, 0, [&](uint32 begin, uint32 end) { ProcessElements(elements.data(), begin, end); });
+			parallelFor = std::min(parallelFor, Seconds(start));
+
+			// many small batches, shows the scheduling overhead
+			start = std::chrono::steady_clock::now();
+			for (uint32 first = 0; first < BENCHMARK_ELEMENTS; first += 64 * JOBS_MAX_PARALLEL_FOR_BATCHES)
+			{
+				uint32 count = std::min(64u * JOBS_MAX_PARALLEL_FOR_BATCHES, BENCHMARK_ELEMENTS - first);
+				Jobs::ParallelFor(count, 64, [&](uint32 begin, uint32 end) { ProcessElements(elements.data(), first + begin, first + end); });
+			}
+			parallelForFine = std::min(parallelForFine, Seconds(start));
+
+			start = std::chrono::steady_clock::now();
+			for (uint32 round = 0; round < BENCHMARK_EMPTY_JOBS_ROUNDS; round++)
+			{
+				JobCounter counter;
+				Jobs::Run(emptyJobs.data(), BENCHMARK_EMPTY_JOBS, &counter);
+				Jobs::Wait(&counter);
+			}
+			emptyJobsTime = std::min(emptyJobsTime, Seconds(start));
+		}
+
+		if (threads == 1)
+			singleThreadTime = parallelFor;
+
+		fprintf
+		(
+			stdout, "%8u %18.3f %8.2fx %18.3f %18.0f\n",
+			threads, parallelFor * 1000.0, singleThreadTime / parallelFor, parallelForFine * 1000.0, BENCHMARK_EMPTY_JOBS * BENCHMARK_EMPTY_JOBS_ROUNDS / emptyJobsTime
+		);
+
+		Jobs::Shutdown();
+	}
+
+	if (previousThreadCount)
+		Jobs::Init(previousThreadCount);
+}
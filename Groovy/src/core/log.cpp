@@ -1,9 +1,12 @@
 #include "log.h"
 #include "core.h"
 #include <cstdarg>
+#include <mutex>
 
 static GroovyLoggerProc gLogger = nullptr;
-static char gTempLogBuffer[512];
+// jobs log from any thread, loggers don't have to be thread safe
+static thread_local char gTempLogBuffer[512];
+static std::mutex gLoggerLock;
 
 void GroovyLog(ELogSeverity severity, const char* msg, ...)
 {
@@ -15,6 +18,7 @@ void GroovyLog(ELogSeverity severity, const char* msg, ...)
 	vsnprintf(gTempLogBuffer, 512, msg, args);
 	va_end(args);
 
+	std::lock_guard<std::mutex> lock(gLoggerLock);
 	gLogger(severity, gTempLogBuffer);
 }
 
@@ -15,11 +15,11 @@ CORE_API void GroovyLog(ELogSeverity severity, const char* msg, ...);
 CORE_API void SetGroovyLogger(GroovyLoggerProc proc);
 
 #if !BUILD_SHIPPING
-	#define GROOVY_LOG(Severity, Message, ...)	{ GroovyLog(Severity, Message, __VA_ARGS__); }
+	#define GROOVY_LOG(Severity, Message, ...)	{ GroovyLog(Severity, Message, ##__VA_ARGS__); }
 #else
 	#define GROOVY_LOG(Severity, Message, ...)
 #endif
 
-#define GROOVY_LOG_INFO(Message, ...)		GROOVY_LOG(LOG_SEVERITY_INFO, Message, __VA_ARGS__)
-#define GROOVY_LOG_WARN(Message, ...)		GROOVY_LOG(LOG_SEVERITY_WARNING, Message, __VA_ARGS__)
-#define GROOVY_LOG_ERR(Message, ...)		GROOVY_LOG(LOG_SEVERITY_ERROR, Message, __VA_ARGS__)
\ No newline at end of file
+#define GROOVY_LOG_INFO(Message, ...)		GROOVY_LOG(LOG_SEVERITY_INFO, Message, ##__VA_ARGS__)
+#define GROOVY_LOG_WARN(Message, ...)		GROOVY_LOG(LOG_SEVERITY_WARNING, Message, ##__VA_ARGS__)
+#define GROOVY_LOG_ERR(Message, ...)		GROOVY_LOG(LOG_SEVERITY_ERROR, Message, ##__VA_ARGS__)
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "profiler.h"
+#include "core.h"
+#include "platform/filesystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+static constexpr uint32 PROFILER_EVENTS_PER_BLOCK = 4096;
+
+struct ProfileEvent
+{
+	const char* name;
+	uint64 startNs;
+	uint64 endNs;
+};
+
+struct ProfileEventBlock
+{
+	ProfileEvent events[PROFILER_EVENTS_PER_BLOCK];
+	// written only by the owner thread, published with release so EndCapture can read it from another thread
+	std::atomic<uint32> count = 0;
+	std::atomic<ProfileEventBlock*> next = nullptr;
+};
+
+struct ProfileThreadBuffer
+{
+	uint32 threadId;
+	std::string threadName;
+	// written by the owner thread, read by EndCapture
+	std::atomic<uint32> captureId;
+	ProfileEventBlock* head;
+	ProfileEventBlock* tail;
+};
+
+static std::atomic<bool> sCapturing = false;
+static std::atomic<uint32> sCaptureId = 0;
+static uint64 sCaptureStartNs = 0;
+static bool sStartupCaptureRequested = false;
+
+static std::mutex sThreadBuffersLock;
+static std::vector<ProfileThreadBuffer*> sThreadBuffers;
+
+static thread_local ProfileThreadBuffer* tThreadBuffer = nullptr;
+
+static ProfileThreadBuffer* GetThreadBuffer()
+{
+	if (!tThreadBuffer)
+	{
+		ProfileThreadBuffer* buffer = new ProfileThreadBuffer();
+		buffer->captureId.store(sCaptureId.load(std::memory_order_acquire), std::memory_order_relaxed);
+		buffer->head = buffer->tail = new ProfileEventBlock();
+
+		std::lock_guard<std::mutex> lock(sThreadBuffersLock);
+		buffer->threadId = (uint32)sThreadBuffers.size() + 1;
+		sThreadBuffers.push_back(buffer);
+
+		tThreadBuffer = buffer;
+	}
+	return tThreadBuffer;
+}
+
+// called by the owner thread when it records the first event of a new capture
+static void ResetThreadBuffer(ProfileThreadBuffer* buffer)
+{
+	ProfileEventBlock* block = buffer->head->next;
+	while (block)
+	{
+		ProfileEventBlock* next = block->next;
+		delete block;
+		block = next;
+	}
+	buffer->head->next.store(nullptr, std::memory_order_relaxed);
+	buffer->head->count.store(0, std::memory_order_release);
+	buffer->tail = buffer->head;
+}
+
+uint64 Profiler::__internal_GetTimeNs()
+{
+	return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::__internal_RecordEvent(const char* name, uint64 startNs, uint64 endNs)
+{
+	// scope started before the capture or ended after it
+	if (!sCapturing.load(std::memory_order_relaxed) || startNs < sCaptureStartNs)
+		return;
+
+	ProfileThreadBuffer* buffer = GetThreadBuffer();
+
+	uint32 captureId = sCaptureId.load(std::memory_order_acquire);
+	if (buffer->captureId.load(std::memory_order_relaxed) != captureId)
+	{
+		ResetThreadBuffer(buffer);
+		buffer->captureId.store(captureId, std::memory_order_release);
+	}
+
+	ProfileEventBlock* block = buffer->tail;
+	uint32 count = block->count.load(std::memory_order_relaxed);
+	if (count == PROFILER_EVENTS_PER_BLOCK)
+	{
+		ProfileEventBlock* newBlock = new ProfileEventBlock();
+		block->next.store(newBlock, std::memory_order_release);
+		buffer->tail = block = newBlock;
+		count = 0;
+	}
+
+	block->events[count] = { name, startNs, endNs };
+	block->count.store(count + 1, std::memory_order_release);
+}
+
+void Profiler::BeginCapture()
+{
+	if (sCapturing)
+		return;
+
+	sCaptureStartNs = __internal_GetTimeNs();
+	sCaptureId.fetch_add(1, std::memory_order_release);
+	sCapturing.store(true, std::memory_order_release);
+}
+
+bool Profiler::IsCapturing()
+{
+	return sCapturing.load(std::memory_order_relaxed);
+}
+
+void Profiler::RequestStartupCapture()
+{
+	sStartupCaptureRequested = true;
+}
+
+bool Profiler::IsStartupCaptureRequested()
+{
+	const char* env = getenv("GROOVY_PROFILE_STARTUP");
+	return sStartupCaptureRequested || (env && env[0] && strcmp(env, "0") != 0);
+}
+
+std::string Profiler::GetCaptureDirectory()
+{
+	std::error_code error;
+	std::filesystem::path tempPath = std::filesystem::temp_directory_path(error);
+	if (error)
+		tempPath = ".";
+	return (tempPath / "Groovy" / "profiling").string();
+}
+
+static void AppendJsonString(std::string& json, const char* str)
+{
+	json += '"';
+	for (const char* c = str; *c; c++)
+	{
+		if (*c == '"' || *c == '\\')
+			json += '\\';
+		json += *c;
+	}
+	json += '"';
+}
+
+bool Profiler::EndCapture(const std::string& filePath)
+{
+	if (!sCapturing)
+		return false;
+
+	sCapturing.store(false, std::memory_order_release);
+
+	uint32 captureId = sCaptureId.load(std::memory_order_acquire);
+
+	std::string json;
+	json.reserve(1024 * 1024);
+	json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	bool firstEvent = true;
+	char tmp[128];
+
+	std::lock_guard<std::mutex> lock(sThreadBuffersLock);
+
+	for (ProfileThreadBuffer* buffer : sThreadBuffers)
+	{
+		// this thread didn't record anything during the capture
+		if (buffer->captureId.load(std::memory_order_acquire) != captureId)
+			continue;
+
+		if (!firstEvent)
+			json += ',';
+		firstEvent = false;
+
+		snprintf(tmp, sizeof(tmp), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", buffer->threadId);
+		json += tmp;
+		AppendJsonString(json, buffer->threadName.empty() ? "Thread" : buffer->threadName.c_str());
+		json += "}}";
+
+		for (ProfileEventBlock* block = buffer->head; block; block = block->next.load(std::memory_order_acquire))
+		{
+			uint32 count = block->count.load(std::memory_order_acquire);
+			for (uint32 i = 0; i < count; i++)
+			{
+				const ProfileEvent& e = block->events[i];
+
+				// chrome wants microseconds
+				double ts = (double)(e.startNs - sCaptureStartNs) / 1000.0;
+				double dur = (double)(e.endNs - e.startNs) / 1000.0;
+
+				json += ",{\"ph\":\"X\",\"pid\":1,\"name\":";
+				AppendJsonString(json, e.name);
+				snprintf(tmp, sizeof(tmp), ",\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->threadId, ts, dur);
+				json += tmp;
+			}
+		}
+	}
+
+	json += "]}";
+
+	std::filesystem::path outPath(filePath);
+	if (outPath.has_parent_path())
+		std::filesystem::create_directories(outPath.parent_path());
+
+	EFileOpenResult result = FileSystem::WriteFileBinary(filePath, json.data(), json.size());
+	if (result != FILE_OPEN_RESULT_OK)
+	{
+		GROOVY_LOG_ERR("Unable to write profiler capture to '%s'", filePath.c_str());
+		return false;
+	}
+
+	GROOVY_LOG_INFO("Profiler capture written to '%s'", filePath.c_str());
+	return true;
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+	ProfileThreadBuffer* buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(sThreadBuffersLock);
+	buffer->threadName = name;
+}
+
+void Profiler::Shutdown()
+{
+	sCapturing = false;
+
+	std::lock_guard<std::mutex> lock(sThreadBuffersLock);
+
+	for (ProfileThreadBuffer* buffer : sThreadBuffers)
+	{
+		ProfileEventBlock* block = buffer->head;
+		while (block)
+		{
+			ProfileEventBlock* next = block->next;
+			delete block;
+			block = next;
+		}
+		delete buffer;
+	}
+	sThreadBuffers.clear();
+
+	// only the calling thread can clear its own pointer, other threads must be gone by now
+	tThreadBuffer = nullptr;
+}
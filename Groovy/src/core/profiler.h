@@ -0,0 +1,78 @@
+#pragma once
+
+#include "coreminimal.h"
+#include "assert.h"
+
+#include <string>
+
+#if !BUILD_SHIPPING
+	#define GROOVY_PROFILER_ENABLED 1
+#else
+	#define GROOVY_PROFILER_ENABLED 0
+#endif
+
+/*
+	Hierarchical cpu profiler.
+	Every thread records into its own buffer (no locks after the first event of the thread),
+	a capture is dumped in the chrome trace_event json format (open it with chrome://tracing or ui.perfetto.dev).
+	Scopes are compiled out in shipping.
+*/
+class CORE_API Profiler
+{
+public:
+	static void BeginCapture();
+	// stops the capture and writes it to filePath, returns false if nothing could be written
+	static bool EndCapture(const std::string& filePath);
+	static bool IsCapturing();
+
+	// startup captures only happen when asked for, GROOVY_PROFILE_STARTUP=1 in the environment or RequestStartupCapture
+	static void RequestStartupCapture();
+	static bool IsStartupCaptureRequested();
+
+	// captures and reports go in the temp directory, never inside the project
+	static std::string GetCaptureDirectory();
+
+	// names the calling thread inside the trace
+	static void SetThreadName(const char* name);
+
+	// frees every thread buffer, no scope can be open when this is called
+	static void Shutdown();
+
+	// for internal use
+	static uint64 __internal_GetTimeNs();
+	static void __internal_RecordEvent(const char* name, uint64 startNs, uint64 endNs);
+};
+
+#if GROOVY_PROFILER_ENABLED
+
+class ProfileScope
+{
+public:
+	ProfileScope(const char* name)
+		: mName(name), mStartNs(Profiler::IsCapturing() ? Profiler::__internal_GetTimeNs() : 0)
+	{}
+
+	~ProfileScope()
+	{
+		if (mStartNs)
+			Profiler::__internal_RecordEvent(mName, mStartNs, Profiler::__internal_GetTimeNs());
+	}
+
+private:
+	const char* mName;
+	uint64 mStartNs;
+};
+
+	#define GVY_PROFILE_CONCAT_IMPL(a, b) a##b
+	#define GVY_PROFILE_CONCAT(a, b) GVY_PROFILE_CONCAT_IMPL(a, b)
+
+	// name must outlive the capture (string literal)
+	#define GROOVY_PROFILE_SCOPE(Name)		ProfileScope GVY_PROFILE_CONCAT(__profileScope, __LINE__)(Name)
+	#define GROOVY_PROFILE_FUNCTION()		GROOVY_PROFILE_SCOPE(__FUNCTION__)
+
+#else
+
+	#define GROOVY_PROFILE_SCOPE(Name)
+	#define GROOVY_PROFILE_FUNCTION()
+
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "core/core.h"
+
+#include <chrono>
+#include <stdio.h>
+
+/*
+	Timing and result printing shared by the benchmarks in benchmarks.cpp.
+	Cases are printed as time and throughput per item, plus the speedup against a baseline case.
+*/
+namespace benchmark
+{
+	// seconds taken by iterations runs of func, after one untimed run for the caches
+	template<typename TFunc>
+	double TimeCase(uint32 iterations, TFunc func)
+	{
+		func();
+
+		auto start = std::chrono::steady_clock::now();
+		for (uint32 i = 0; i < iterations; i++)
+			func();
+		auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double>(end - start).count();
+	}
+
+	// results are stored here so the work can't be optimized away
+	template<typename T>
+	inline volatile T gSink;
+
+	template<typename T>
+	void KeepResult(T result)
+	{
+		gSink<T> = result;
+	}
+
+	// column headers for PrintCase, item is what's counted (e.g. "object" gives ns/object and Mobjects/s)
+	inline void PrintColumns(const char* item)
+	{
+		char perItem[32];
+		char throughput[32];
+		snprintf(perItem, sizeof(perItem), "ns/%s", item);
+		snprintf(throughput, sizeof(throughput), "M%ss/s", item);
+		fprintf(stdout, "%-36s %10s %12s %9s\n", "path", perItem, throughput, "speedup");
+	}
+
+	// items is the total over all the timed iterations
+	inline void PrintCase(const char* name, double seconds, double baseline, double items)
+	{
+		fprintf(stdout, "%-36s %10.2f %12.2f %8.2fx\n", name, seconds * 1e9 / items, items / seconds / 1e6, baseline / seconds);
+	}
+}
@@ -0,0 +1,45 @@
+#include "benchmarks.h"
+#include "core/jobs.h"
+#include "renderer/api/software/software_rasterizer.h"
+#include "math/matrix.h"
+#include "classes/object_serializer.h"
+#include "classes/class_db.h"
+
+#include <stdio.h>
+
+struct BenchmarkEntry
+{
+	const char* name;
+	const char* description;
+	void(*run)();
+};
+
+static const BenchmarkEntry BENCHMARKS[] =
+{
+	{ "jobs", "job system overhead and ParallelFor scaling across thread counts", BenchmarkJobs },
+	{ "software_rasterizer", "software rasterizer throughput across thread counts and simd kernels", BenchmarkSoftwareRasterizer },
+	{ "math", "matrix, point and quaternion math: scalar, simd and batch paths (and directxmath on windows)", BenchmarkMath },
+	{ "serialization", "property packs: per-class plans against property by property, v2 files against v1", BenchmarkSerialization },
+	{ "reflection", "class and property lookups by name and by class, hashed against std::map and linear scans", BenchmarkReflection },
+};
+
+bool Benchmarks::Run(const std::string& name)
+{
+	for (const BenchmarkEntry& benchmark : BENCHMARKS)
+	{
+		if (name == benchmark.name)
+		{
+			benchmark.run();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void Benchmarks::PrintList()
+{
+	fprintf(stdout, "Available benchmarks:\n");
+	for (const BenchmarkEntry& benchmark : BENCHMARKS)
+		fprintf(stdout, "  %-24s %s\n", benchmark.name, benchmark.description);
+}
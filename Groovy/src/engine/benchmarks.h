@@ -0,0 +1,16 @@
+#pragma once
+
+#include "core/core.h"
+
+/*
+	Named micro benchmarks, run from the headless launcher with --benchmark=<name>.
+	Results are printed to stdout. They run before the engine is initialized, so the class db is empty
+	and each benchmark registers the classes it uses. Shared timing helpers are in benchmark_utils.h.
+*/
+class CORE_API Benchmarks
+{
+public:
+	// false if there's no benchmark with that name
+	static bool Run(const std::string& name);
+	static void PrintList();
+};
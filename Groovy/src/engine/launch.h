@@ -4,12 +4,16 @@
 #include "renderer/api/framebuffer.h"
 #include "application.h"
 #include "assets/asset_manager.h"
+#include "assets/asset_pak.h"
 #include "engine/project.h"
 #include "classes/class_db.h"
 #include "renderer/renderer.h"
 #include "gameframework/scene.h"
 #include "runtime/object_allocator.h"
 #include "audio/audio.h"
+#include "core/profiler.h"
+#include "core/jobs.h"
+#include "core/async_io.h"
 
 void OnWndResizeCallback(uint32 width, uint32 height)
 {
@@ -26,6 +30,10 @@ int32 GroovyEntryPoint(const char* args)
 {
 	Application::PreInit();
 
+	Profiler::SetThreadName("Main thread");
+	if (Profiler::IsStartupCaptureRequested())
+		Profiler::BeginCapture();
+
 	if (!args[0])
 	{
 		SysMessageBox::Show_Error("Can't launch without a project!", "Can't launch without a project!");
@@ -40,15 +48,25 @@ int32 GroovyEntryPoint(const char* args)
 		return -1;
 	}
 
-	for (GroovyClass* c : ENGINE_CLASSES)
-		gClassDB.Register(c);
+	Jobs::Init();
+	AsyncIO::Init();
+
+	{
+		GROOVY_PROFILE_SCOPE("Register engine classes");
+		for (GroovyClass* c : ENGINE_CLASSES)
+			gClassDB.Register(c);
+	}
 
 #if !BUILD_MONOLITHIC
 
 	// load game dll and fill GAME_CLASSES
 	std::string gameDllPath = (gProj.GetProjectFilePath().parent_path() / "bin" / LINKER_OUTPUT_DIR / gProj.GetProjectName() / (gProj.GetProjectName() + ".dll")).string();
 	
-	void* gameDll = Lib::LoadDll(gameDllPath);
+	void* gameDll = nullptr;
+	{
+		GROOVY_PROFILE_SCOPE("Load game dll");
+		gameDll = Lib::LoadDll(gameDllPath);
+	}
 
 	if (!gameDll)
 	{
@@ -70,10 +88,16 @@ int32 GroovyEntryPoint(const char* args)
 
 #endif
 
-	for (GroovyClass* c : GAME_CLASSES)
-		gClassDB.Register(c);
+	{
+		GROOVY_PROFILE_SCOPE("Register game classes");
+		for (GroovyClass* c : GAME_CLASSES)
+			gClassDB.Register(c);
+	}
 	
-	gClassDB.BuildCDOs();
+	{
+		GROOVY_PROFILE_SCOPE("Build CDOs");
+		gClassDB.BuildCDOs();
+	}
 
 	// windowing system
 	WindowProps wndProps =
@@ -86,15 +110,21 @@ int32 GroovyEntryPoint(const char* args)
 	Window::InitSystem();
 	Window wnd(wndProps);
 	gWindow = &wnd;
-	wnd.Spawn();
-	wnd.Show();
+	{
+		GROOVY_PROFILE_SCOPE("Spawn window");
+		wnd.Spawn();
+		wnd.Show();
+	}
 
 	// startup renderering
 	RendererAPISpec rendererAPISpec;
 	rendererAPISpec.refreshrate = 0;	// max monitor refreshrate
 	rendererAPISpec.vsync = 1;			// v-sync enabled
 
-	RendererAPI::Create(RENDERER_API_D3D11, rendererAPISpec, &wnd);
+	{
+		GROOVY_PROFILE_SCOPE("RendererAPI::Create");
+		RendererAPI::Create(RENDERER_API_D3D11, rendererAPISpec, &wnd);
+	}
 
 	FrameBufferSpec screenBufferSpec;
 	screenBufferSpec.swapchainTarget = true;
@@ -108,13 +138,28 @@ int32 GroovyEntryPoint(const char* args)
 
 	wnd.SubmitToWndResizeCallback(OnWndResizeCallback);
 
-	Audio::Init();
+	{
+		GROOVY_PROFILE_SCOPE("Audio::Init");
+		Audio::Init();
+	}
+
+#if BUILD_SHIPPING
+	// cooked builds read every asset from the pak next to the project
+	if (!AssetPak::Mount(gProj.GetAssetPakPath().string()))
+		SysMessageBox::Show_Warning("Asset pak not found!", "Unable to mount " + gProj.GetAssetPakPath().string() + ", loading loose asset files...");
+#endif
 
 	AssetManager::Init();
 
-	gProj.Load(); // we need to initalize the assetManager in order to deserialize the startup scene
+	{
+		GROOVY_PROFILE_SCOPE("GroovyProject::Load");
+		gProj.Load(); // we need to initalize the assetManager in order to deserialize the startup scene
+	}
 
-	Application::Init();
+	{
+		GROOVY_PROFILE_SCOPE("Application::Init");
+		Application::Init();
+	}
 
 	gScreenFrameBuffer->Bind();
 	Renderer::Init();
@@ -123,26 +168,48 @@ int32 GroovyEntryPoint(const char* args)
 
 	TickTimer::Init();
 
+#if GROOVY_PROFILER_ENABLED
+	if (Profiler::IsCapturing())
+		Profiler::EndCapture((std::filesystem::path(Profiler::GetCaptureDirectory()) / "startup.json").string());
+#endif
+
 	while (gEngineShouldRun)
 	{
+		GROOVY_PROFILE_SCOPE("Frame");
+
 		wnd.ProcessEvents();
 
 		double currentTime = TickTimer::GetTimeSeconds();
 		gDeltaTime = currentTime - gTime;
 		gTime = currentTime;
 
-		Audio::Update();
+		{
+			GROOVY_PROFILE_SCOPE("Audio::Update");
+			Audio::Update();
+		}
+
+		{
+			GROOVY_PROFILE_SCOPE("Application::Update");
+			Application::Update((float)gDeltaTime);
+		}
 
-		Application::Update((float)gDeltaTime);
+		AssetManager::Update();
+		AsyncIO::Update();
 
 		Input::Clear();
 
 		gScreenFrameBuffer->ClearColorAttachment(0, gScreenClearColor);
 		gScreenFrameBuffer->ClearDepthAttachment();
 
-		Application::Render();
+		{
+			GROOVY_PROFILE_SCOPE("Application::Render");
+			Application::Render();
+		}
 
-		RendererAPI::Get().Present();
+		{
+			GROOVY_PROFILE_SCOPE("Present");
+			Renderer::Present();
+		}
 	}
 
 	Input::Shutdown();
@@ -153,28 +220,46 @@ int32 GroovyEntryPoint(const char* args)
 	gProj.Save();
 
 	AssetManager::Shutdown();
+	AssetPak::Unmount();
 
 	gClassDB.DestroyCDOs();
 	
 	delete gScreenFrameBuffer;
 	RendererAPI::Destroy();
 
-#if !BUILD_MONOLITHIC
-
-	if(gameDll)
-		Lib::UnloadDll(gameDll);
-
-#endif
-
 #if BUILD_DEBUG
-	if (ObjectAllocator::Debug_GetLiveObjectsCount())
+	if (ObjectAllocator::GetLiveObjectsCount())
 	{
+		std::vector<ObjectPoolStats> poolStats;
+		ObjectAllocator::GetPoolStats(poolStats);
+		for (const ObjectPoolStats& stats : poolStats)
+			if (stats.liveObjects)
+				GROOVY_LOG_WARN("%u %s objects still alive after shutdown", stats.liveObjects, stats.className.c_str());
+
 		SysMessageBox::Show_Warning
 		(
 			"Dear engine programmer",
 			"Some groovy objects are still alive after shutdown, how is that?"
 		);
 	}
+#endif
+
+	// pending saves reach the disk before anything goes away
+	AsyncIO::Shutdown();
+
+	// game jobs are done by now, workers go before the game dll
+	Jobs::Shutdown();
+
+	// must happen before the game dll goes away, pools point back to the game classes
+	ObjectAllocator::Shutdown();
+
+	Profiler::Shutdown();
+
+#if !BUILD_MONOLITHIC
+
+	if(gameDll)
+		Lib::UnloadDll(gameDll);
+
 #endif
 	
 	return 0;
@@ -0,0 +1,538 @@
+#include "engine/engine.h"
+#include "platform/platform.h"
+#include "renderer/api/renderer_api.h"
+#include "renderer/api/null/null_renderer_api.h"
+#include "renderer/api/software/software_renderer_api.h"
+#include "renderer/api/software/software_framebuffer.h"
+#include "renderer/api/framebuffer.h"
+#include "renderer/renderer.h"
+#include "renderer/scene_renderer.h"
+#include "renderer/frame_allocator.h"
+#include "assets/asset_manager.h"
+#include "assets/asset_pak.h"
+#include "engine/project.h"
+#include "classes/class_db.h"
+#include "gameframework/scene.h"
+#include "runtime/object_allocator.h"
+#include "core/profiler.h"
+#include "core/jobs.h"
+#include "core/async_io.h"
+#include "engine/benchmarks.h"
+
+#include <stdio.h>
+
+/*
+	Headless launch: no window, no gpu, no audio, no input.
+	Assets that would live on the gpu are created through the null (or software) renderer api,
+	the startup scene is loaded and ticked until gEngineShouldRun goes false or the frame cap is reached.
+
+	usage: <project file> [--frames=N] [--timestep=SECONDS] [--free-running] [--render] [--renderer=null|software] [--output=FILE.ppm] [--pak]
+	       <project file> --cook[=FILE.groovypak] [--compress]
+	       --benchmark=NAME
+		--frames		stop after N frames (0 = run forever, default)
+		--timestep		fixed delta time fed to the scene (default 1/60)
+		--free-running	feed the measured frame time to the scene instead of a fixed timestep
+		--render		run the scene renderer every frame and report its stats
+		--renderer		null (default) only counts draws, software rasterizes them on the cpu into a 1280x720 offscreen target
+		--output		with --renderer=software, write the last frame to a ppm image
+		--pak			read assets from the cooked pak next to the project instead of the loose files (always on in shipping)
+		--cook			pack the project assets into FILE (default <project>.groovypak next to the project) and exit
+		--compress		with --cook, compress the assets that shrink enough (they're no longer served in place)
+		--benchmark		run a benchmark and exit, no project needed (--benchmark=list prints them)
+*/
+
+#define HEADLESS_RENDER_WIDTH 1280
+#define HEADLESS_RENDER_HEIGHT 720
+
+struct HeadlessLaunchOptions
+{
+	std::string projectFile;
+	uint64 frameCap = 0;
+	double fixedTimestep = 1.0 / 60.0;
+	bool freeRunning = false;
+	bool render = false;
+	ERendererAPI rendererAPI = RENDERER_API_NULL;
+	std::string outputImage;
+	std::string benchmark;
+#if BUILD_SHIPPING
+	bool mountPak = true;
+#else
+	bool mountPak = false;
+#endif
+	bool cook = false;
+	bool cookCompress = false;
+	std::string cookOutput;
+	bool profileStartup = false;
+};
+
+static void HeadlessLogger(ELogSeverity severity, const char* msg)
+{
+	switch (severity)
+	{
+		case LOG_SEVERITY_INFO:		fprintf(stdout, "[Info] %s\n", msg);	break;
+		case LOG_SEVERITY_WARNING:	fprintf(stderr, "[Warn] %s\n", msg);	break;
+		case LOG_SEVERITY_ERROR:	fprintf(stderr, "[Error] %s\n", msg);	break;
+	}
+}
+
+static bool ParseHeadlessOptions(int32 argc, char** argv, HeadlessLaunchOptions& outOptions)
+{
+	for (int32 i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+
+		if (arg.rfind("--frames=", 0) == 0)
+			outOptions.frameCap = strtoull(arg.c_str() + strlen("--frames="), nullptr, 10);
+		else if (arg.rfind("--timestep=", 0) == 0)
+			outOptions.fixedTimestep = strtod(arg.c_str() + strlen("--timestep="), nullptr);
+		else if (arg == "--free-running")
+			outOptions.freeRunning = true;
+		else if (arg == "--render")
+			outOptions.render = true;
+		else if (arg == "--renderer=null")
+			outOptions.rendererAPI = RENDERER_API_NULL;
+		else if (arg == "--renderer=software")
+			outOptions.rendererAPI = RENDERER_API_SOFTWARE;
+		else if (arg.rfind("--output=", 0) == 0)
+			outOptions.outputImage = arg.substr(strlen("--output="));
+		else if (arg.rfind("--benchmark=", 0) == 0)
+			outOptions.benchmark = arg.substr(strlen("--benchmark="));
+		else if (arg == "--pak")
+			outOptions.mountPak = true;
+		else if (arg == "--cook")
+			outOptions.cook = true;
+		else if (arg.rfind("--cook=", 0) == 0)
+		{
+			outOptions.cook = true;
+			outOptions.cookOutput = arg.substr(strlen("--cook="));
+		}
+		else if (arg == "--compress")
+			outOptions.cookCompress = true;
+		else if (arg == "--profile-startup")
+			outOptions.profileStartup = true;
+		else if (arg.rfind("--", 0) != 0 && outOptions.projectFile.empty())
+			outOptions.projectFile = arg;
+		else
+		{
+			fprintf(stderr, "Unknown argument '%s'\n", arg.c_str());
+			return false;
+		}
+	}
+
+	if (outOptions.fixedTimestep <= 0.0)
+	{
+		fprintf(stderr, "Timestep must be greater than 0\n");
+		return false;
+	}
+
+	if (!outOptions.outputImage.empty() && outOptions.rendererAPI != RENDERER_API_SOFTWARE)
+	{
+		fprintf(stderr, "--output needs --renderer=software\n");
+		return false;
+	}
+
+	if (outOptions.cookCompress && !outOptions.cook)
+	{
+		fprintf(stderr, "--compress needs --cook\n");
+		return false;
+	}
+
+	return !outOptions.projectFile.empty() || !outOptions.benchmark.empty();
+}
+
+// binary ppm, alpha is dropped
+static bool WriteHeadlessFrame(const std::string& path, FrameBuffer* frameBuffer)
+{
+	SoftwareFrameBuffer* softwareFrameBuffer = (SoftwareFrameBuffer*)frameBuffer;
+	const FrameBufferSpec& spec = softwareFrameBuffer->GetSpecs();
+	const uint32* pixels = (const uint32*)softwareFrameBuffer->GetRendererID(0);
+
+	FILE* file = fopen(path.c_str(), "wb");
+	if (!file)
+		return false;
+
+	fprintf(file, "P6\n%u %u\n255\n", spec.width, spec.height);
+
+	std::vector<uint8> row(spec.width * 3);
+	for (uint32 y = 0; y < spec.height; y++)
+	{
+		const uint32* src = pixels + (size_t)y * softwareFrameBuffer->GetPitch();
+		for (uint32 x = 0; x < spec.width; x++)
+		{
+			row[x * 3 + 0] = (uint8)(src[x]);
+			row[x * 3 + 1] = (uint8)(src[x] >> 8);
+			row[x * 3 + 2] = (uint8)(src[x] >> 16);
+		}
+		fwrite(row.data(), 1, row.size(), file);
+	}
+
+	fclose(file);
+	return true;
+}
+
+int32 GroovyHeadlessEntryPoint(int32 argc, char** argv)
+{
+	SetGroovyLogger(HeadlessLogger);
+
+	HeadlessLaunchOptions options;
+	if (!ParseHeadlessOptions(argc, argv, options))
+	{
+		fprintf
+		(
+			stderr, "usage: %s <project file> [--frames=N] [--timestep=SECONDS] [--free-running] [--render] [--renderer=null|software] [--output=FILE.ppm] [--pak] [--profile-startup]\n"
+			"       %s <project file> --cook[=FILE.groovypak] [--compress]\n"
+			"       %s --benchmark=NAME\n", argc ? argv[0] : "GroovyHeadless", argc ? argv[0] : "GroovyHeadless", argc ? argv[0] : "GroovyHeadless"
+		);
+		return -1;
+	}
+
+	if (!options.benchmark.empty())
+	{
+		if (options.benchmark == "list")
+		{
+			Benchmarks::PrintList();
+			return 0;
+		}
+
+		if (!Benchmarks::Run(options.benchmark))
+		{
+			fprintf(stderr, "Unknown benchmark '%s'\n", options.benchmark.c_str());
+			Benchmarks::PrintList();
+			return -1;
+		}
+
+		return 0;
+	}
+
+	Profiler::SetThreadName("Main thread");
+	if (options.profileStartup)
+		Profiler::RequestStartupCapture();
+	if (Profiler::IsStartupCaptureRequested())
+		Profiler::BeginCapture();
+
+	gProj.BuildPaths(options.projectFile.c_str());
+
+	if (!FileSystem::FileExists(gProj.GetProjectFilePath().string()))
+	{
+		fprintf(stderr, "Can't find project %s\n", options.projectFile.c_str());
+		return -1;
+	}
+
+#if !BUILD_SHIPPING
+	// cooking only reads the registry and the asset files, no engine needed
+	if (options.cook)
+	{
+		std::string pakPath = options.cookOutput.empty() ? gProj.GetAssetPakPath().string() : options.cookOutput;
+		return AssetPak::Cook(gProj.GetAssetRegistryPath(), gProj.GetAssetsPath(), pakPath, options.cookCompress) ? 0 : -1;
+	}
+#endif
+
+	Jobs::Init();
+	AsyncIO::Init();
+
+	{
+		GROOVY_PROFILE_SCOPE("Register engine classes");
+		for (GroovyClass* c : ENGINE_CLASSES)
+			gClassDB.Register(c);
+	}
+
+#if !BUILD_MONOLITHIC
+
+	// load game dll and fill GAME_CLASSES
+#if PLATFORM_WIN32
+	std::string gameDllName = gProj.GetProjectName() + ".dll";
+#else
+	std::string gameDllName = "lib" + gProj.GetProjectName() + ".so";
+#endif
+	std::string gameDllPath = (gProj.GetProjectFilePath().parent_path() / "bin" / LINKER_OUTPUT_DIR / gProj.GetProjectName() / gameDllName).string();
+
+	void* gameDll = nullptr;
+	{
+		GROOVY_PROFILE_SCOPE("Load game dll");
+		gameDll = Lib::LoadDll(gameDllPath);
+	}
+
+	if (!gameDll)
+	{
+		GROOVY_LOG_WARN("Unable to load game code: %s, starting without game code...", gameDllPath.c_str());
+	}
+	else
+	{
+		void* gameClassesList = Lib::GetSymbol(gameDll, "GAME_CLASSES_LIST");
+		checkslowf(gameClassesList, "Game classes list not found in game dll");
+
+		std::vector<GroovyClass*>* gameClassesListVec = (std::vector<GroovyClass*>*)gameClassesList;
+		GAME_CLASSES = *gameClassesListVec;
+	}
+
+#else
+
+	extern std::vector<GroovyClass*> GAME_CLASSES_LIST;
+	GAME_CLASSES = GAME_CLASSES_LIST;
+
+#endif
+
+	{
+		GROOVY_PROFILE_SCOPE("Register game classes");
+		for (GroovyClass* c : GAME_CLASSES)
+			gClassDB.Register(c);
+	}
+
+	{
+		GROOVY_PROFILE_SCOPE("Build CDOs");
+		gClassDB.BuildCDOs();
+	}
+
+	// gpu-free stand-ins for textures, shaders and mesh buffers
+	RendererAPISpec rendererAPISpec = {};
+	RendererAPI::Create(options.rendererAPI, rendererAPISpec, nullptr);
+
+	if (options.mountPak && !AssetPak::Mount(gProj.GetAssetPakPath().string()))
+		GROOVY_LOG_WARN("Unable to mount %s, loading loose asset files...", gProj.GetAssetPakPath().string().c_str());
+
+	AssetManager::Init();
+
+	Renderer::Init();
+
+	// the software renderer needs somewhere to draw, there's no swapchain
+	FrameBuffer* renderTarget = nullptr;
+	if (options.rendererAPI == RENDERER_API_SOFTWARE)
+	{
+		FrameBufferSpec renderTargetSpec;
+		renderTargetSpec.width = HEADLESS_RENDER_WIDTH;
+		renderTargetSpec.height = HEADLESS_RENDER_HEIGHT;
+		renderTargetSpec.colorAttachments = { COLOR_FORMAT_R8G8B8A8_UNORM };
+		renderTargetSpec.hasDepthAttachment = true;
+		renderTargetSpec.swapchainTarget = false;
+		renderTarget = FrameBuffer::Create(renderTargetSpec);
+	}
+
+	{
+		GROOVY_PROFILE_SCOPE("GroovyProject::Load");
+		gProj.Load();
+	}
+
+	Scene* scene = gProj.GetStartupScene();
+	if (!scene)
+	{
+		std::vector<AssetHandle> scenes = AssetManager::GetAssets(ASSET_TYPE_SCENE);
+		if (scenes.size())
+			scene = (Scene*)scenes[0].instance;
+	}
+
+	int32 exitCode = 0;
+
+	if (!scene)
+	{
+		GROOVY_LOG_ERR("No startup scene!");
+		gEngineShouldRun = false;
+		exitCode = -1;
+	}
+	else
+	{
+		scene->Load();
+		scene->BeginPlay();
+	}
+
+	TickTimer::Init();
+
+	// uploads done while loading assets are not part of any frame
+	NullRendererAPI::ResetStats();
+	SceneRenderer::ResetStats();
+	if (scene)
+		scene->ResetTransformStats();
+	Renderer::ResetBindStats();
+	uint32 frameAllocatorHeapAllocations = FrameAllocator::GetHeapAllocationsCount();
+	if (SoftwareRendererAPI* softwareRendererAPI = SoftwareRendererAPI::GetInstance())
+		softwareRendererAPI->GetRasterizer().ResetStats();
+
+#if GROOVY_PROFILER_ENABLED
+	if (Profiler::IsCapturing())
+		Profiler::EndCapture((std::filesystem::path(Profiler::GetCaptureDirectory()) / "headless_startup.json").string());
+#endif
+
+	uint64 frames = 0;
+#if FRAME_ALLOCATOR_COUNT_SUBMISSION_ALLOCATIONS
+	uint32 firstFrameSubmissionAllocations = 0;
+#endif
+	double simulatedTime = 0.0;
+	double loopStartTime = TickTimer::GetTimeSeconds();
+	gTime = loopStartTime;
+
+	// no frames without a scene, gEngineShouldRun went false above
+	while (gEngineShouldRun && (!options.frameCap || frames < options.frameCap))
+	{
+		GROOVY_PROFILE_SCOPE("Frame");
+
+		double currentTime = TickTimer::GetTimeSeconds();
+		gDeltaTime = options.freeRunning ? currentTime - gTime : options.fixedTimestep;
+		gTime = currentTime;
+
+		scene->Tick((float)gDeltaTime);
+
+		AssetManager::Update();
+		AsyncIO::Update();
+
+		if (options.render)
+		{
+			GROOVY_PROFILE_SCOPE("Render");
+
+			if (renderTarget)
+			{
+				renderTarget->Bind();
+				renderTarget->ClearColorAttachments(gScreenClearColor);
+				renderTarget->ClearDepthAttachment();
+			}
+
+			// same aspect ratio for every run, so draw stats are comparable between machines
+			if (scene->mCamera)
+				SceneRenderer::BeginScene(scene->mCamera, 16.0f / 9.0f);
+			else
+				SceneRenderer::BeginScene({ 0.0f, 0.0f, 0.0f }, math::GetIdentityQuat(), 60.0f, 16.0f / 9.0f);
+
+			SceneRenderer::RenderScene(scene);
+		}
+		else
+		{
+			// RenderScene does it otherwise
+			scene->UpdateTransforms();
+		}
+
+		Renderer::Present();
+
+		simulatedTime += gDeltaTime;
+		frames++;
+
+#if FRAME_ALLOCATOR_COUNT_SUBMISSION_ALLOCATIONS
+		// the first frame fills the renderer's caches
+		if (frames == 1)
+			firstFrameSubmissionAllocations = FrameAllocator::GetSubmissionHeapAllocationsCount();
+#endif
+	}
+
+	double wallTime = TickTimer::GetTimeSeconds() - loopStartTime;
+
+	// printed in every configuration, this is what benchmark jobs parse
+	if (frames)
+	{
+		fprintf
+		(
+			stdout, "Headless run: %llu frames, %.3fs simulated, %.3fs wall, %.4fms/frame, %.1f frames/s\n",
+			(unsigned long long)frames, simulatedTime, wallTime, wallTime * 1000.0 / (double)frames, (double)frames / wallTime
+		);
+
+		fprintf(stdout, "Assets loaded at exit: %u of %u\n", AssetManager::GetLoadedAssetsCount(), (uint32)AssetManager::GetAssets().size());
+
+		if (scene)
+		{
+			const SceneTransformStats& transforms = scene->GetTransformStats();
+			fprintf(stdout, "Transforms recomputed per frame: %.1f actors, %.1f components\n", transforms.actors / (double)frames, transforms.components / (double)frames);
+		}
+
+		if (options.render)
+		{
+			const SceneRenderStats& culling = SceneRenderer::GetTotalStats();
+			fprintf(stdout, "Culling per frame: %.1f meshes visible, %.1f culled\n", culling.visible / (double)frames, culling.culled / (double)frames);
+
+			// skipped binds are the ones the renderer would have issued without state tracking
+			const RendererBindStats& binds = Renderer::GetBindStats();
+			fprintf(stdout, "Renderer binds per frame: %.1f issued, %.1f skipped\n", binds.issued / (double)frames, binds.skipped / (double)frames);
+
+			// heap allocations after the first frames mean something in render submission is allocating again
+			fprintf
+			(
+				stdout, "Frame allocator: %.1f KB peak, %.1f KB capacity, %u heap allocations (%u during the run)\n",
+				FrameAllocator::GetPeak() / 1024.0, FrameAllocator::GetCapacity() / 1024.0,
+				FrameAllocator::GetHeapAllocationsCount(), FrameAllocator::GetHeapAllocationsCount() - frameAllocatorHeapAllocations
+			);
+
+#if FRAME_ALLOCATOR_COUNT_SUBMISSION_ALLOCATIONS
+			// any operator new between BeginScene and Present, render submission shouldn't make any after the first frame
+			uint32 submissionAllocations = FrameAllocator::GetSubmissionHeapAllocationsCount() - firstFrameSubmissionAllocations;
+			fprintf(stdout, "Render submission: %u heap allocations after the first frame\n", submissionAllocations);
+			if (submissionAllocations)
+			{
+				GROOVY_LOG_ERR("Render submission allocated from the heap %u times after the first frame", submissionAllocations);
+				exitCode = -1;
+			}
+#endif
+		}
+
+		if (options.render && options.rendererAPI == RENDERER_API_SOFTWARE)
+		{
+			const SoftwareRasterizerStats& stats = SoftwareRendererAPI::GetInstance()->GetRasterizer().GetStats();
+			fprintf
+			(
+				stdout, "Software rasterizer per frame: %.1f triangles submitted, %.1f rasterized, %.1f pixels written\n",
+				stats.trianglesSubmitted / (double)frames, stats.trianglesRasterized / (double)frames, stats.pixelsWritten / (double)frames
+			);
+		}
+		else if (options.render)
+		{
+			const RendererFrameStats& total = NullRendererAPI::GetTotalStats();
+			double rendererFrames = (double)NullRendererAPI::GetFramesCount();
+			fprintf
+			(
+				stdout, "Render stats per frame: %.1f draw calls, %.1f instances, %.1f indices, %.1f state changes, %.1f redundant binds, %.1f buffer uploads, %.1f bytes uploaded\n",
+				total.drawCalls / rendererFrames, total.instances / rendererFrames, total.indices / rendererFrames, total.stateChanges / rendererFrames,
+				total.redundantBinds / rendererFrames, total.bufferUploads / rendererFrames, total.bytesUploaded / rendererFrames
+			);
+		}
+	}
+
+	if (renderTarget)
+	{
+		if (!options.outputImage.empty() && frames)
+		{
+			if (WriteHeadlessFrame(options.outputImage, renderTarget))
+				fprintf(stdout, "Last frame written to %s\n", options.outputImage.c_str());
+			else
+				GROOVY_LOG_ERR("Can't write %s", options.outputImage.c_str());
+		}
+
+		delete renderTarget;
+	}
+
+	if (scene)
+		scene->Unload();
+
+	Renderer::Shutdown();
+
+	AssetManager::Shutdown();
+	AssetPak::Unmount();
+
+	gClassDB.DestroyCDOs();
+
+	RendererAPI::Destroy();
+
+#if BUILD_DEBUG
+	if (ObjectAllocator::GetLiveObjectsCount())
+	{
+		std::vector<ObjectPoolStats> poolStats;
+		ObjectAllocator::GetPoolStats(poolStats);
+		for (const ObjectPoolStats& stats : poolStats)
+			if (stats.liveObjects)
+				GROOVY_LOG_WARN("%u %s objects still alive after shutdown", stats.liveObjects, stats.className.c_str());
+	}
+#endif
+
+	// pending saves reach the disk before anything goes away
+	AsyncIO::Shutdown();
+
+	// game jobs are done by now, workers go before the game dll
+	Jobs::Shutdown();
+
+	// must happen before the game dll goes away, pools point back to the game classes
+	ObjectAllocator::Shutdown();
+
+	Profiler::Shutdown();
+
+#if !BUILD_MONOLITHIC
+
+	if (gameDll)
+		Lib::UnloadDll(gameDll);
+
+#endif
+
+	return exitCode;
+}
@@ -1,6 +1,7 @@
 #include "project.h"
 #include "classes/object_serializer.h"
 #include "platform/filesystem.h"
+#include "assets/asset.h"
 
 GROOVY_CLASS_IMPL(GroovyProject)
 	GROOVY_REFLECT(mStartupScene)
@@ -12,6 +13,7 @@ void GroovyProject::BuildPaths(const char* projectFilePath)
 	mProjName = mProjFilePath.filename().replace_extension().string();
 	mAssetsPath = mProjFilePath.parent_path() / "assets";
 	mAssetRegistryPath = mAssetsPath / "assetregistry";
+	mAssetPakPath = mProjFilePath.parent_path() / (mProjName + GROOVY_PAK_EXT);
 }
 
 void GroovyProject::Load()
@@ -23,7 +25,7 @@ void GroovyProject::Load()
 	{
 		PropertyPack pack;
 		BufferView fileDataView(fileData);
-		ObjectSerializer::DeserializePropertyPack(GroovyProject::StaticClass(), fileDataView, pack);
+		ObjectSerializer::DeserializePropertyPack(GroovyProject::StaticClass(), fileDataView, pack, true);
 		ObjectSerializer::DeserializePropertyPackData(pack, this);
 	}
 }
@@ -20,6 +20,7 @@ private:
 	std::filesystem::path mProjFilePath;
 	std::filesystem::path mAssetRegistryPath;
 	std::filesystem::path mAssetsPath;
+	std::filesystem::path mAssetPakPath;
 
 public:
 	inline Scene* GetStartupScene() const { return mStartupScene; }
@@ -30,6 +31,7 @@ public:
 	inline const std::filesystem::path& GetProjectFilePath() const { return mProjFilePath; }
 	inline const std::filesystem::path& GetAssetRegistryPath() const { return mAssetRegistryPath; }
 	inline const std::filesystem::path& GetAssetsPath() const { return mAssetsPath; }
+	inline const std::filesystem::path& GetAssetPakPath() const { return mAssetPakPath; }
 
 	void Load();
 	void Save();
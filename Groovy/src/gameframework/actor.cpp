@@ -1,6 +1,8 @@
 #include "actor.h"
 #include "actor_component.h"
 #include "blueprint.h"
+#include "scene.h"
+#include "math/math.h"
 #include "runtime/object_allocator.h"
 
 GROOVY_CLASS_IMPL(Actor)
@@ -8,7 +10,8 @@ GROOVY_CLASS_IMPL(Actor)
 GROOVY_CLASS_END()
 
 Actor::Actor()
-	: mTransform{{ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }},
+	: mTransform{{ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f }},
+	mWorldMatrix(), mWorldMatrixDirty(true), mTransformChanged(false), mTransformQueued(false),
 	mName("Actor"), mShouldTick(true), mScene(nullptr), mTemplate(nullptr)
 {
 }
@@ -112,22 +115,67 @@ void Actor::TickComponents(float deltaTime)
 void Actor::SetLocation(Vec3 location)
 {
 	mTransform.location = location;
+	MarkTransformDirty();
 }
 
-void Actor::SetRotation(Vec3 rotation)
+void Actor::SetRotation(Quat rotation)
 {
 	mTransform.rotation = rotation;
+	MarkTransformDirty();
+}
+
+void Actor::SetRotationEuler(Vec3 rotation)
+{
+	SetRotation(math::QuatFromEuler(rotation));
 }
 
 void Actor::SetScale(Vec3 scale)
 {
 	mTransform.scale = scale;
+	MarkTransformDirty();
+}
+
+const Mat4& Actor::GetWorldMatrix() const
+{
+	if (mWorldMatrixDirty)
+	{
+		mWorldMatrix = math::GetModelMatrix(mTransform.location, mTransform.rotation, mTransform.scale);
+		mWorldMatrixDirty = false;
+
+		if (mScene)
+			mScene->mTransformStats.actors++;
+	}
+	return mWorldMatrix;
+}
+
+void Actor::MarkTransformDirty()
+{
+	mWorldMatrixDirty = true;
+	mTransformChanged = true;
+
+	// scene components are relative to the actor
+	for (ActorComponent* comp : mComponents)
+		if (SceneComponent* sceneComp = Cast<SceneComponent>(comp))
+			sceneComp->mWorldTransformDirty = true;
+
+	QueueTransformUpdate();
+}
+
+void Actor::QueueTransformUpdate()
+{
+	// templates and actors being constructed have no scene, their caches are refreshed when read
+	if (mScene && !mTransformQueued)
+	{
+		mTransformQueued = true;
+		mScene->mTransformUpdateQueue.push_back(this);
+	}
 }
 
 void Actor::Clone(Actor* to)
 {
 	CopyProperties(to);
 	to->mTransform = mTransform;
+	to->MarkTransformDirty();
 	to->mName = mName;
 
 	for (ActorComponent* comp : mComponents)
@@ -227,7 +275,7 @@ void Actor::__internal_Editor_RenameEditorComponent(ActorComponent* component, c
 	mComponentsDB[newName] = component;
 
 	// update component's name
-	(*it._Ptr)->mName = newName;
+	(*it)->mName = newName;
 }
 
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "classes/object.h"
+#include "math/quat.h"
 #include <map>
 
 class ActorComponent;
@@ -69,13 +70,25 @@ public:
 
 	inline const Transform& GetTransform() const { return mTransform; }
 	inline Vec3 GetLocation() const { return mTransform.location; }
-	inline Vec3 GetRotation() const { return mTransform.rotation; }
+	inline Quat GetRotation() const { return mTransform.rotation; }
+	// degrees, converted from the quaternion
+	inline Vec3 GetRotationEuler() const { return math::QuatToEuler(mTransform.rotation); }
 	inline Vec3 GetScale() const { return mTransform.scale; }
 
 	void SetLocation(Vec3 location);
-	void SetRotation(Vec3 rotation);
+	void SetRotation(Quat rotation);
+	// degrees
+	void SetRotationEuler(Vec3 rotation);
 	void SetScale(Vec3 scale);
 
+	// model matrix of the transform, cached. recomputed when read after a change or by Scene::UpdateTransforms
+	const Mat4& GetWorldMatrix() const;
+
+	// for code that writes the transform directly, the setters already do it. components are marked as well
+	void MarkTransformDirty();
+	// adds the actor to the scene's transform updates, once per frame
+	void QueueTransformUpdate();
+
 	inline const std::string& GetName() const { return mName; }
 	inline ActorBlueprint* GetTemplate() const { return mTemplate; }
 	inline Scene* GetScene() const { return mScene; }
@@ -95,7 +108,9 @@ public:
 	void __internal_Editor_RemoveEditorComponent(ActorComponent* component);
 	void __internal_Editor_RenameEditorComponent(ActorComponent* component, const std::string& newName);
 
+	// call Editor_OnTransformChanged after editing it
 	Transform& Editor_TransformRef() { return mTransform; }
+	void Editor_OnTransformChanged() { MarkTransformDirty(); }
 	std::string& Editor_NameRef() { return mName; }
 	ActorBlueprint*& Editor_Template() { return mTemplate; }
 
@@ -103,6 +118,13 @@ public:
 
 private:
 	Transform mTransform;
+	mutable Mat4 mWorldMatrix;
+	mutable bool mWorldMatrixDirty;
+	// OnTransformChanged is pending for every component
+	bool mTransformChanged;
+	// in the scene's transform updates
+	bool mTransformQueued;
+
 	std::string mName;
 	bool mShouldTick;
 	Scene* mScene;
@@ -1,6 +1,7 @@
 #include "actor_component.h"
 #include "math/math.h"
 #include "actor.h"
+#include "scene.h"
 
 GROOVY_CLASS_IMPL(ActorComponent)
 GROOVY_CLASS_END()
@@ -15,30 +16,70 @@ GROOVY_CLASS_IMPL(SceneComponent)
 GROOVY_CLASS_END()
 
 SceneComponent::SceneComponent()
-	: mTransform{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } }
+	: mTransform{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f } },
+	mAbsoluteTransform(), mWorldMatrix(), mWorldTransformDirty(true), mTransformChanged(false)
 {
 }
 
-Transform SceneComponent::GetAbsoluteTransform() const
+void SceneComponent::SetTransform(const Transform& transform)
 {
-	Transform absoluteTransform;
-	absoluteTransform.location = GetOwner()->GetLocation() + mTransform.location;
-	absoluteTransform.rotation += GetOwner()->GetRotation() + mTransform.rotation;
-	absoluteTransform.scale = GetOwner()->GetScale() * mTransform.scale;
-	return absoluteTransform;
+	mTransform = transform;
+	MarkTransformDirty();
 }
 
-Vec3 SceneComponent::GetAbsoluteLocation() const
+void SceneComponent::SetLocation(Vec3 location)
 {
-	return GetOwner()->GetLocation() + mTransform.location;
+	mTransform.location = location;
+	MarkTransformDirty();
 }
 
-Vec3 SceneComponent::GetAbsoluteRotation() const
+void SceneComponent::SetRotation(Quat rotation)
 {
-	return GetOwner()->GetRotation() + mTransform.rotation;
+	mTransform.rotation = rotation;
+	MarkTransformDirty();
 }
 
-Vec3 SceneComponent::GetAbsoluteScale() const
+void SceneComponent::SetRotationEuler(Vec3 rotation)
 {
-	return GetOwner()->GetScale() * mTransform.scale;
+	SetRotation(math::QuatFromEuler(rotation));
+}
+
+void SceneComponent::SetScale(Vec3 scale)
+{
+	mTransform.scale = scale;
+	MarkTransformDirty();
+}
+
+void SceneComponent::MarkTransformDirty()
+{
+	mWorldTransformDirty = true;
+	mTransformChanged = true;
+	// cdos have no owner, their cache is refreshed when read
+	if (GetOwner())
+		GetOwner()->QueueTransformUpdate();
+}
+
+const Transform& SceneComponent::GetAbsoluteTransform() const
+{
+	if (mWorldTransformDirty)
+		UpdateWorldTransform();
+	return mAbsoluteTransform;
+}
+
+const Mat4& SceneComponent::GetWorldMatrix() const
+{
+	if (mWorldTransformDirty)
+		UpdateWorldTransform();
+	return mWorldMatrix;
+}
+
+void SceneComponent::UpdateWorldTransform() const
+{
+	// no trig here, the rotations are quaternions
+	mAbsoluteTransform = math::CombineTransforms(mTransform, GetOwner()->GetTransform());
+	mWorldMatrix = math::GetModelMatrix(mAbsoluteTransform.location, mAbsoluteTransform.rotation, mAbsoluteTransform.scale);
+	mWorldTransformDirty = false;
+
+	if (Scene* scene = GetOwner()->GetScene())
+		scene->mTransformStats.components++;
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "classes/object.h"
+#include "math/quat.h"
 
 enum EActorComponentType : byte
 {
@@ -33,6 +34,9 @@ protected:
 	virtual void BeginPlay() {}
 	virtual void Tick(float deltaTime) {}
 
+	// the world transform changed (own or owner's transform), called by Scene::UpdateTransforms
+	virtual void OnTransformChanged() {}
+
 private:
 	std::string mName;
 	EActorComponentType mType;
@@ -52,23 +56,50 @@ public:
 	SceneComponent();
 
 #if WITH_EDITOR
+	// call Editor_OnTransformChanged after editing it
 	Transform& Editor_TransformRef() { return mTransform; }
+	void Editor_OnTransformChanged() { MarkTransformDirty(); }
 #endif
 
 	inline const Transform& GetTransform() const { return mTransform; }
 	inline Vec3 GetLocation() const { return mTransform.location; }
-	inline Vec3 GetRotation() const { return mTransform.rotation; }
+	inline Quat GetRotation() const { return mTransform.rotation; }
+	// degrees, converted from the quaternion
+	inline Vec3 GetRotationEuler() const { return math::QuatToEuler(mTransform.rotation); }
 	inline Vec3 GetScale() const { return mTransform.scale; }
 
-	Transform GetAbsoluteTransform() const;
-	Vec3 GetAbsoluteLocation() const;
-	Vec3 GetAbsoluteRotation() const;
-	Vec3 GetAbsoluteScale() const;
+	void SetTransform(const Transform& transform);
+	void SetLocation(Vec3 location);
+	void SetRotation(Quat rotation);
+	// degrees
+	void SetRotationEuler(Vec3 rotation);
+	void SetScale(Vec3 scale);
+
+	// cached, recomputed when read after a change or by Scene::UpdateTransforms
+	const Transform& GetAbsoluteTransform() const;
+	inline Vec3 GetAbsoluteLocation() const { return GetAbsoluteTransform().location; }
+	inline Quat GetAbsoluteRotation() const { return GetAbsoluteTransform().rotation; }
+	inline Vec3 GetAbsoluteScale() const { return GetAbsoluteTransform().scale; }
+	// model matrix of the absolute transform, cached as well
+	const Mat4& GetWorldMatrix() const;
+
+	// for code that writes the transform directly (reflection), the setters already do it
+	void MarkTransformDirty();
+
+private:
+	void UpdateWorldTransform() const;
 
 private:
 	// Relative to parent component / actor
 	Transform mTransform;
 
+	mutable Transform mAbsoluteTransform;
+	mutable Mat4 mWorldMatrix;
+	// the cache is stale
+	mutable bool mWorldTransformDirty;
+	// OnTransformChanged is pending
+	bool mTransformChanged;
+
 	friend class Actor;
 	friend class ActorSerializer;
 	friend class Scene;
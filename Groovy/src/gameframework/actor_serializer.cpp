@@ -6,6 +6,8 @@
 
 void ActorSerializer::CreateActorPack(Actor* actor, ActorPack& outPack)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	check(actor);
 
 	ActorBlueprint* actorTemplate = actor->mTemplate;
@@ -51,8 +53,10 @@ void ActorSerializer::CreateActorPack(Actor* actor, ActorPack& outPack)
 	}
 }
 
-void ActorSerializer::SerializeActorPack(const ActorPack& pack, DynamicBuffer& fileData)
+void ActorSerializer::SerializeActorPack(const ActorPack& pack, DynamicBuffer& fileData, PropertyNameTable* names)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	if (!pack.actorClass)
 		return;
 
@@ -64,7 +68,7 @@ void ActorSerializer::SerializeActorPack(const ActorPack& pack, DynamicBuffer& f
 	DYNAMIC_BUFFER_TRACK(actorFileSize, fileData);
 
 	// actor properties
-	ObjectSerializer::SerializePropertyPack(pack.actorProperties, fileData);
+	ObjectSerializer::SerializePropertyPack(pack.actorProperties, fileData, names);
 
 	// actor components
 	fileData.push<uint32>((uint32)pack.actorComponents.size());
@@ -77,7 +81,7 @@ void ActorSerializer::SerializeActorPack(const ActorPack& pack, DynamicBuffer& f
 
 		fileData.push<std::string>(comp.componentName);
 		fileData.push<EActorComponentType>(comp.componentType);
-		ObjectSerializer::SerializePropertyPack(comp.componentProperties, fileData);
+		ObjectSerializer::SerializePropertyPack(comp.componentProperties, fileData, names);
 
 		DYNAMIC_BUFFER_TRACK_WRITE_RESULT(componentSubfileSize, fileData);
 	}
@@ -85,8 +89,10 @@ void ActorSerializer::SerializeActorPack(const ActorPack& pack, DynamicBuffer& f
 	DYNAMIC_BUFFER_TRACK_WRITE_RESULT(actorFileSize, fileData);
 }
 
-void ActorSerializer::DeserializeActorPack(BufferView& fileData, ActorPack& outPack)
+void ActorSerializer::DeserializeActorPack(BufferView& fileData, ActorPack& outPack, bool referenceFileData, PropertyNameTable* names)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	if (fileData.empty())
 		return;
 
@@ -104,7 +110,7 @@ void ActorSerializer::DeserializeActorPack(BufferView& fileData, ActorPack& outP
 	}
 
 	outPack.actorClass = actorClass;
-	ObjectSerializer::DeserializePropertyPack(actorClass, fileData, outPack.actorProperties);
+	ObjectSerializer::DeserializePropertyPack(actorClass, fileData, outPack.actorProperties, referenceFileData, names);
 
 	uint32 componentsCount = fileData.read<uint32>();
 	for (uint32 i = 0; i < componentsCount; i++)
@@ -124,12 +130,14 @@ void ActorSerializer::DeserializeActorPack(BufferView& fileData, ActorPack& outP
 		compPack.componentClass = componentClass;
 		compPack.componentName = fileData.read<std::string>();
 		compPack.componentType = fileData.read<EActorComponentType>();
-		ObjectSerializer::DeserializePropertyPack(componentClass, fileData, compPack.componentProperties);
+		ObjectSerializer::DeserializePropertyPack(componentClass, fileData, compPack.componentProperties, referenceFileData, names);
 	}
 }
 
 void ActorSerializer::DeserializeActorPackData(const ActorPack& pack, Actor* actor)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	check(actor);
 	check(pack.actorClass);
 	check(pack.actorClass == actor->GetClass());
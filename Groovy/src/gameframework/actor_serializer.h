@@ -3,6 +3,8 @@
 #include "actor.h"
 #include "actor_component.h"
 
+class PropertyNameTable;
+
 struct ComponentPack
 {
 	std::string componentName;
@@ -23,8 +25,9 @@ class CORE_API ActorSerializer
 public:
 	static void CreateActorPack(Actor* actor, ActorPack& outPack);
 	
-	static void SerializeActorPack(const ActorPack& pack, DynamicBuffer& fileData);
-	static void DeserializeActorPack(BufferView& fileData, ActorPack& outPack);
+	// names and referenceFileData go to the property packs, see ObjectSerializer
+	static void SerializeActorPack(const ActorPack& pack, DynamicBuffer& fileData, PropertyNameTable* names = nullptr);
+	static void DeserializeActorPack(BufferView& fileData, ActorPack& outPack, bool referenceFileData = false, PropertyNameTable* names = nullptr);
 
 	static void DeserializeActorPackData(const ActorPack& pack, Actor* actor);
 };
\ No newline at end of file
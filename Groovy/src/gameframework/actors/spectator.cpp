@@ -8,23 +8,30 @@ GROOVY_CLASS_IMPL(Spectator)
 GROOVY_CLASS_END()
 
 Spectator::Spectator()
-	: mMovementSpeed(1.0f), mCameraRotationSpeed(0.5f)
+	: mMovementSpeed(1.0f), mCameraRotationSpeed(0.5f), mLookRotation{ 0.0f, 0.0f, 0.0f }
 {
 	mCamera = AddComponent<CameraComponent>("CameraComponent");
 }
 
+void Spectator::BeginPlay()
+{
+	mLookRotation = GetRotationEuler();
+}
+
 void Spectator::Tick(float deltaTime)
 {
 	// Rotate camera
 
 	MouseDelta mouseDelta = Input::GetMouseDelta();
 
-	Vec3 rotation = GetRotation();
-
-	rotation.y += mouseDelta.x * mCameraRotationSpeed;
-	rotation.x += mouseDelta.y * mCameraRotationSpeed;
+	// a still camera doesn't dirty the transform
+	if (mouseDelta.x || mouseDelta.y)
+	{
+		mLookRotation.y += mouseDelta.x * mCameraRotationSpeed;
+		mLookRotation.x += mouseDelta.y * mCameraRotationSpeed;
 
-	SetRotation(rotation);
+		SetRotationEuler(mLookRotation);
+	}
 
 	// Move 
 
@@ -45,12 +52,13 @@ void Spectator::Tick(float deltaTime)
 
 	if (inputDirection.x || inputDirection.y || inputDirection.z)
 	{
+		Quat rotation = GetRotation();
 		Vec3 movement = 
-			math::GetForwardVector(GetRotation()) * inputDirection.z
+			math::GetForwardVector(rotation) * inputDirection.z
 			+
-			math::GetRightVector(GetRotation()) * inputDirection.x
+			math::GetRightVector(rotation) * inputDirection.x
 			+
-			math::GetUpVector(GetRotation()) * inputDirection.y;
+			math::GetUpVector(rotation) * inputDirection.y;
 
 		movement = math::Normalize(movement);
 		movement *= mMovementSpeed * deltaTime;
@@ -12,10 +12,13 @@ public:
 
 	inline class CameraComponent* GetCamera() const { return mCamera; }
 
+	virtual void BeginPlay() override;
 	virtual void Tick(float deltaTime);
 
 private:
 	class CameraComponent* mCamera;
 	float mMovementSpeed;
 	float mCameraRotationSpeed;
+	// degrees, mouse look accumulates here instead of going through the quaternion every frame
+	Vec3 mLookRotation;
 };
\ No newline at end of file
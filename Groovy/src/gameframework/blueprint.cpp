@@ -21,6 +21,16 @@ void ObjectBlueprint::Load()
 	mLoaded = true;
 }
 
+void ObjectBlueprint::Unload()
+{
+	if (mDefaultObject)
+		ObjectAllocator::Destroy(mDefaultObject);
+
+	mDefaultObject = nullptr;
+	mPropertyPack = PropertyPack();
+	mLoaded = false;
+}
+
 void ObjectBlueprint::Save()
 {
 	AssetSerializer::SerializeGenericAsset(this);
@@ -40,6 +50,8 @@ void ObjectBlueprint::Serialize(DynamicBuffer& fileData) const
 
 void ObjectBlueprint::Deserialize(BufferView fileData)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	if (!fileData.remaining())
 	{
 		GROOVY_LOG_WARN("%s file is empty, deserialization skipped", GetAssetName().c_str());
@@ -105,15 +117,16 @@ void ObjectBlueprint::RebuildPack(GroovyObject* basedOn)
 
 uint32 DepencyDeletionFix(const AssetHandle& assetToBeDeleted, PropertyPack& packToSanitize)
 {
+	checkslow(!packToSanitize.fileData);
+
 	uint32 fixed = 0;
-	size_t propDataOffset = 0;
 	for (const PropertyDesc& p : packToSanitize.desc)
 	{
 		bool assetTypeProp = p.classProp->type == PROPERTY_TYPE_ASSET_REF;
 		bool sameAssetType = p.classProp->param1 == assetToBeDeleted.type;
 		if (assetTypeProp && sameAssetType)
 		{
-			AssetUUID* propUUIDs = (AssetUUID*)(packToSanitize.data.data() + propDataOffset);
+			AssetUUID* propUUIDs = (AssetUUID*)(packToSanitize.data.data() + p.dataOffset);
 			for (uint32 i = 0; i < p.arrayCount; i++)
 			{
 				if (propUUIDs[i] == assetToBeDeleted.uuid)
@@ -123,7 +136,6 @@ uint32 DepencyDeletionFix(const AssetHandle& assetToBeDeleted, PropertyPack& pac
 				}
 			}
 		}
-		propDataOffset += p.sizeBytes;
 	}
 	return fixed;
 }
@@ -156,6 +168,17 @@ void ActorBlueprint::Load()
 	mLoaded = true;
 }
 
+void ActorBlueprint::Unload()
+{
+	if (mDefaultActor)
+		ObjectAllocator::Destroy(mDefaultActor);
+
+	mDefaultActor = nullptr;
+	mActorPack.actorProperties = PropertyPack();
+	mActorPack.actorComponents.clear();
+	mLoaded = false;
+}
+
 void ActorBlueprint::Save()
 {
 	AssetSerializer::SerializeGenericAsset(this);
@@ -174,6 +197,8 @@ void ActorBlueprint::Serialize(DynamicBuffer& fileData) const
 
 void ActorBlueprint::Deserialize(BufferView fileData)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	if (!fileData.remaining())
 	{
 		GROOVY_LOG_WARN("%s file is empty, deserialization skipped", GetAssetName().c_str());
@@ -20,6 +20,7 @@ public:
     virtual AssetUUID GetUUID() const override { return mUUID; }
     virtual bool IsLoaded() const override { return mLoaded; }
     virtual void Load() override;
+    virtual void Unload() override;
     virtual void Save() override;
 
     virtual void Serialize(DynamicBuffer& fileData) const override;
@@ -63,6 +64,7 @@ public:
     virtual AssetUUID GetUUID() const override { return mUUID; }
     virtual bool IsLoaded() const override { return mLoaded; }
     virtual void Load() override;
+    virtual void Unload() override;
     virtual void Save() override;
 
     virtual void Serialize(DynamicBuffer& fileData) const override;
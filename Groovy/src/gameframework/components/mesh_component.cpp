@@ -1,8 +1,8 @@
 #include "mesh_component.h"
-#include "renderer/scene_renderer.h"
 #include "renderer/mesh.h"
 #include "gameframework/actor.h"
 #include "gameframework/scene.h"
+#include "assets/asset_manager.h"
 
 GROOVY_CLASS_IMPL(MeshComponent)
 	GROOVY_REFLECT(mVisible)
@@ -11,18 +11,18 @@ GROOVY_CLASS_IMPL(MeshComponent)
 GROOVY_CLASS_END()
 
 MeshComponent::MeshComponent()
-	: mMesh(nullptr), mVisible(true)
+	: mVisible(true), mMesh(nullptr), mRenderProxy(INVALID_RENDER_PROXY)
 {
 }
 
 void MeshComponent::Initialize()
 {
-	GetOwner()->GetScene()->SubmitForRendering(this);
+	mRenderProxy = GetOwner()->GetScene()->GetRenderProxies().Add(this);
 }
 
 void MeshComponent::Uninitialize()
 {
-	GetOwner()->GetScene()->RemoveFromRenderQueue(this);
+	GetOwner()->GetScene()->GetRenderProxies().Remove(mRenderProxy);
 }
 
 void MeshComponent::SetMaterialOverride(uint32 index, Material* mat)
@@ -30,6 +30,28 @@ void MeshComponent::SetMaterialOverride(uint32 index, Material* mat)
 	check(index < mMaterialOverrides.size());
 
 	mMaterialOverrides[index] = mat;
+	MarkRenderStateDirty();
+}
+
+void MeshComponent::SetVisible(bool visible)
+{
+	if (visible == mVisible)
+		return;
+
+	mVisible = visible;
+	MarkRenderStateDirty();
+}
+
+void MeshComponent::MarkRenderStateDirty()
+{
+	if (mRenderProxy != INVALID_RENDER_PROXY)
+		GetOwner()->GetScene()->GetRenderProxies().Update(mRenderProxy);
+}
+
+void MeshComponent::OnTransformChanged()
+{
+	if (mRenderProxy != INVALID_RENDER_PROXY)
+		GetOwner()->GetScene()->GetRenderProxies().UpdateTransform(mRenderProxy);
 }
 
 void MeshComponent::SetMesh(Mesh* mesh)
@@ -42,6 +64,8 @@ void MeshComponent::SetMesh(Mesh* mesh)
 	}
 
 	mMesh = mesh;
+	mMeshHandle = mesh ? AssetManager::Load(mesh->GetUUID()) : AssetHandle();
+	MarkRenderStateDirty();
 }
 
 #if WITH_EDITOR
@@ -54,6 +78,9 @@ void MeshComponent::Editor_OnPropertyChanged(const GroovyProperty* prop)
 		if (mMesh)
 			mMaterialOverrides.resize(mMesh->GetMaterials().size(), nullptr);
 	}
+
+	// mesh, overrides or visibility
+	MarkRenderStateDirty();
 }
 
 #endif
\ No newline at end of file
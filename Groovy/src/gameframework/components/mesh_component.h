@@ -1,6 +1,8 @@
 #pragma once
 
 #include "gameframework/actor_component.h"
+#include "assets/asset.h"
+#include "renderer/render_proxy.h"
 
 GROOVY_CLASS_DECL(MeshComponent)
 class CORE_API MeshComponent : public SceneComponent
@@ -19,17 +21,29 @@ public:
 	inline const std::vector<Material*> GetMaterialOverrides() const { return mMaterialOverrides; }
 	void SetMaterialOverride(uint32 index, Material* mat);
 
+	inline bool IsVisible() const { return mVisible; }
+	void SetVisible(bool visible);
+
+	// rebuilds the render proxy, for code that writes the properties directly (reflection)
+	void MarkRenderStateDirty();
+
 #if WITH_EDITOR
 	void Editor_OnPropertyChanged(const GroovyProperty* prop) override;
 #endif
 
-public:
-	bool mVisible;
+protected:
+	virtual void OnTransformChanged() override;
 
 private:
+	bool mVisible;
 	Mesh* mMesh;
 	std::vector<Material*> mMaterialOverrides;
 
+	// keeps a mesh set at runtime loaded, serialized meshes are kept by the scene or blueprint
+	AssetHandle mMeshHandle;
+
+	// index in the scene render proxies, INVALID_RENDER_PROXY when not initialized
+	uint32 mRenderProxy;
 
-	friend class SceneRenderer;
+	friend class RenderProxies;
 };
\ No newline at end of file
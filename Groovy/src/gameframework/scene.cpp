@@ -1,5 +1,6 @@
 #include "scene.h"
 #include "actor_serializer.h"
+#include "classes/object_serializer.h"
 #include "runtime/object_allocator.h"
 #include "assets/asset_loader.h"
 #include "assets/asset_serializer.h"
@@ -28,15 +29,31 @@ void Scene::Unload()
 {
 	Clear();
 	mLoaded = false;
+
+	// blueprints and meshes the scene referenced can go now
+	AssetManager::__internal_ReleaseDependencies(mUUID);
+
+	// the scene objects are gone, give their empty chunks back
+	ObjectAllocator::TrimPools();
 }
 
 void Scene::Save()
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	AssetSerializer::SerializeGenericAsset(this);
 }
 
 void Scene::Serialize(DynamicBuffer& fileData) const
 {
+	fileData.push<uint32>(GROOVY_SCENE_MAGIC);
+	fileData.push<uint32>(GROOVY_SCENE_VERSION);
+
+	// property names of every actor pack, written at the end once they are all known
+	PropertyNameTable names;
+	size_t namesOffsetPosition = fileData.used();
+	fileData.push<uint64>(0);
+
 	fileData.push<uint32>((uint32)mActors.size());
 	for (Actor* actor : mActors)
 	{
@@ -46,21 +63,57 @@ void Scene::Serialize(DynamicBuffer& fileData) const
 
 		ActorPack pack;
 		ActorSerializer::CreateActorPack(actor, pack);
-		ActorSerializer::SerializeActorPack(pack, fileData);
+		ActorSerializer::SerializeActorPack(pack, fileData, &names);
 	}
+
+	uint64 namesOffset = fileData.used();
+	memcpy(fileData.data() + namesOffsetPosition, &namesOffset, sizeof(uint64));
+	names.Serialize(fileData);
 }
 
 void Scene::Deserialize(BufferView fileData)
 {
+	GROOVY_PROFILE_FUNCTION();
+
+	byte* fileStart = fileData.seek();
+	size_t fileSize = fileData.remaining();
+
+	uint32 version = 0;
+	PropertyNameTable names;
 	uint32 actorsCount = fileData.read<uint32>();
+	if (actorsCount == GROOVY_SCENE_MAGIC)
+	{
+		version = fileData.read<uint32>();
+		if (version > GROOVY_SCENE_VERSION)
+		{
+			GROOVY_LOG_ERR("Scene %llu is version %u, only up to %u is supported, not loaded", (unsigned long long)mUUID, version, (uint32)GROOVY_SCENE_VERSION);
+			return;
+		}
+
+		if (version >= 2)
+		{
+			uint64 namesOffset = fileData.read<uint64>();
+			if (namesOffset > fileSize)
+			{
+				GROOVY_LOG_ERR("Scene %llu is corrupted, not loaded", (unsigned long long)mUUID);
+				return;
+			}
+			BufferView namesData(fileStart + namesOffset, fileSize - namesOffset);
+			names.Deserialize(namesData);
+		}
+		actorsCount = fileData.read<uint32>();
+	}
+
 	for (uint32 i = 0; i < actorsCount; i++)
 	{
 		std::string name = fileData.read<std::string>();
 		AssetUUID bpUUID = fileData.read<AssetUUID>();
-		Transform transform = fileData.read<Transform>();
+		// legacy scenes have euler rotations, converted once here
+		Transform transform = version >= 1 ? fileData.read<Transform>() : math::ToTransform(fileData.read<EulerTransform>());
 
+		// the packs are applied right away, they can read from the file buffer
 		ActorPack pack;
-		ActorSerializer::DeserializeActorPack(fileData, pack);
+		ActorSerializer::DeserializeActorPack(fileData, pack, true, &names);
 
 		if (pack.actorClass)
 		{
@@ -130,6 +183,9 @@ bool Scene::Editor_FixDependencyDeletion(AssetHandle assetToBeDeleted)
 		for (ActorComponent* comp : actor->mComponents)
 		{
 			reflectionUtils::ReplaceValueTypeProperty(comp, PROPERTY_TYPE_ASSET_REF, &assetI, &nullAsset);
+
+			if (MeshComponent* meshComp = Cast<MeshComponent>(comp))
+				meshComp->MarkRenderStateDirty();
 		}
 	}
 
@@ -148,6 +204,7 @@ void Scene::Editor_DeleteActor(Actor* actor)
 	check(actor);
 
 	actor->UninitializeComponents();
+	RemoveFromTransformUpdates(actor);
 
 	// free memory
 	ObjectAllocator::Destroy(actor);
@@ -247,6 +304,15 @@ uint32 Scene::Editor_OnBlueprintUpdated(ActorBlueprint* bp, Actor* oldTemplate,
 						reflectionUtils::CopyProperty(actorComp, newTemplateComp, &prop);
 				}
 			}
+
+			// properties were written directly, mesh and transform included
+			for (ActorComponent* comp : actor->GetComponents())
+			{
+				if (SceneComponent* sceneComp = Cast<SceneComponent>(comp))
+					sceneComp->MarkTransformDirty();
+				if (MeshComponent* meshComp = Cast<MeshComponent>(comp))
+					meshComp->MarkRenderStateDirty();
+			}
 		}
 	}
 
@@ -269,6 +335,8 @@ void Scene::DestroyActor(Actor* actor)
 
 void Scene::BeginPlay()
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	for (Actor* actor : mActors)
 	{
 		if (actor->mShouldTick)
@@ -283,6 +351,8 @@ void Scene::BeginPlay()
 
 void Scene::Tick(float deltaTime)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 #if TICK_ACTORS_CREATED_DURING_TICK
 
 	for (uint32 i = 0; i < mActorTickQueue.size(); i++)
@@ -312,6 +382,7 @@ void Scene::Tick(float deltaTime)
 		}
 
 		actor->UninitializeComponents();
+		RemoveFromTransformUpdates(actor);
 
 		ObjectAllocator::Destroy(actor);
 	}
@@ -328,25 +399,50 @@ void Scene::Clear()
 	}
 	mActors.clear();
 	mActorTickQueue.clear();
+	mTransformUpdateQueue.clear();
 
-	checkf(mRenderQueue.size() == 0, "There's a bug, scene render queue not empty after clear");
+	checkf(mRenderProxies.GetCount() == 0, "There's a bug, scene render proxies not empty after clear");
 
 	mCamera = nullptr;
 }
 
-void Scene::SubmitForRendering(MeshComponent* mesh)
+void Scene::UpdateTransforms()
 {
-	check(mesh);
+	GROOVY_PROFILE_FUNCTION();
+
+	for (Actor* actor : mTransformUpdateQueue)
+	{
+		actor->GetWorldMatrix();
 
-	mRenderQueue.push_back(mesh);
+		for (ActorComponent* comp : actor->mComponents)
+		{
+			SceneComponent* sceneComp = Cast<SceneComponent>(comp);
+			bool changed = actor->mTransformChanged;
+
+			if (sceneComp)
+			{
+				sceneComp->GetWorldMatrix();
+				changed |= sceneComp->mTransformChanged;
+				sceneComp->mTransformChanged = false;
+			}
+
+			if (changed)
+				comp->OnTransformChanged();
+		}
+
+		actor->mTransformChanged = false;
+		actor->mTransformQueued = false;
+	}
+	mTransformUpdateQueue.clear();
 }
 
-void Scene::RemoveFromRenderQueue(MeshComponent* mesh)
+void Scene::RemoveFromTransformUpdates(Actor* actor)
 {
-	check(mesh);
+	if (!actor->mTransformQueued)
+		return;
 
-	auto it = std::find(mRenderQueue.begin(), mRenderQueue.end(), mesh);
-	mRenderQueue.erase(it);
+	auto it = std::find(mTransformUpdateQueue.begin(), mTransformUpdateQueue.end(), actor);
+	mTransformUpdateQueue.erase(it);
 }
 
 void Scene::Copy(Scene* to)
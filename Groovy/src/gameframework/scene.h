@@ -3,6 +3,14 @@
 #include "actor.h"
 #include "actor_component.h"
 #include "blueprint.h"
+#include "renderer/render_proxy.h"
+
+// world transforms recomputed, by the getters of changed transforms or by Scene::UpdateTransforms
+struct SceneTransformStats
+{
+	uint32 actors = 0;
+	uint32 components = 0;
+};
 
 class CORE_API Scene : public AssetInstance
 {
@@ -16,10 +24,9 @@ public:
 
 	virtual bool IsLoaded() const override { return mLoaded; }
 	virtual void Load() override;
+	virtual void Unload() override;
 	virtual void Save() override;
 
-	void Unload();
-
 	virtual void Serialize(DynamicBuffer& fileData) const override;
 	virtual void Deserialize(BufferView fileData) override;
 
@@ -46,10 +53,16 @@ public:
 	void Tick(float deltaTime);
 	void Clear();
 
-	void SubmitForRendering(class MeshComponent* mesh);
-	void RemoveFromRenderQueue(class MeshComponent* mesh);
+	// recomputes the world transforms changed since the last call and calls OnTransformChanged on their components.
+	// once per frame, before rendering (SceneRenderer::RenderScene)
+	void UpdateTransforms();
+	// totals since the last reset, divide by the frame count for per frame numbers
+	inline const SceneTransformStats& GetTransformStats() const { return mTransformStats; }
+	inline void ResetTransformStats() { mTransformStats = SceneTransformStats(); }
 
-	const std::vector<class MeshComponent*>& GetRenderQueue() const { return mRenderQueue; }
+	// one per initialized MeshComponent
+	inline RenderProxies& GetRenderProxies() { return mRenderProxies; }
+	inline const RenderProxies& GetRenderProxies() const { return mRenderProxies; }
 
 	void Copy(Scene* to);
 
@@ -69,6 +82,8 @@ public:
 
 private:
 	Actor* ConstructActor(GroovyClass* actorClass, ActorBlueprint* bp = nullptr);
+	// before destroying a queued actor
+	void RemoveFromTransformUpdates(Actor* actor);
 
 private:
 	std::vector<Actor*> mActors;
@@ -78,7 +93,11 @@ private:
 	// empty before play
 	std::vector<Actor*> mActorKillQueue;
 
-	std::vector<class MeshComponent*> mRenderQueue;
+	RenderProxies mRenderProxies;
+
+	// actors with a changed transform (their own or a component's)
+	std::vector<Actor*> mTransformUpdateQueue;
+	SceneTransformStats mTransformStats;
 	
 public:
 	class CameraComponent* mCamera;
@@ -86,4 +105,7 @@ public:
 private:
 	AssetUUID mUUID;
 	bool mLoaded;
+
+	friend class Actor;
+	friend class SceneComponent;
 };
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "bounds.h"
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #include <emmintrin.h>
+    #define BOUNDS_SSE 1
+#else
+    #define BOUNDS_SSE 0
+#endif
+
+static Vec4 NormalizePlane(float a, float b, float c, float d)
+{
+    float length = sqrtf(a * a + b * b + c * c);
+    float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+    return { a * invLength, b * invLength, c * invLength, d * invLength };
+}
+
+Frustum math::GetFrustum(const Mat4& viewProjection)
+{
+    const Mat4& m = viewProjection;
+
+    // row vectors (clip = p * vp), each plane is a combination of the matrix columns. d3d clip z goes from 0 to w
+    Frustum frustum;
+    frustum.planes[0] = NormalizePlane(m.m[0][3] + m.m[0][0], m.m[1][3] + m.m[1][0], m.m[2][3] + m.m[2][0], m.m[3][3] + m.m[3][0]);
+    frustum.planes[1] = NormalizePlane(m.m[0][3] - m.m[0][0], m.m[1][3] - m.m[1][0], m.m[2][3] - m.m[2][0], m.m[3][3] - m.m[3][0]);
+    frustum.planes[2] = NormalizePlane(m.m[0][3] + m.m[0][1], m.m[1][3] + m.m[1][1], m.m[2][3] + m.m[2][1], m.m[3][3] + m.m[3][1]);
+    frustum.planes[3] = NormalizePlane(m.m[0][3] - m.m[0][1], m.m[1][3] - m.m[1][1], m.m[2][3] - m.m[2][1], m.m[3][3] - m.m[3][1]);
+    frustum.planes[4] = NormalizePlane(m.m[0][2], m.m[1][2], m.m[2][2], m.m[3][2]);
+    frustum.planes[5] = NormalizePlane(m.m[0][3] - m.m[0][2], m.m[1][3] - m.m[1][2], m.m[2][3] - m.m[2][2], m.m[3][3] - m.m[3][2]);
+    return frustum;
+}
+
+void math::TransformBoundingBox(const BoundingBox& box, const Mat4& transform, Vec3& outCenter, Vec3& outExtents)
+{
+    const Mat4& m = transform;
+
+    const float center[3] = { (box.min.x + box.max.x) * 0.5f, (box.min.y + box.max.y) * 0.5f, (box.min.z + box.max.z) * 0.5f };
+    const float extents[3] = { (box.max.x - box.min.x) * 0.5f, (box.max.y - box.min.y) * 0.5f, (box.max.z - box.min.z) * 0.5f };
+
+    // Arvo, the extents go through the absolute matrix
+    float worldCenter[3];
+    float worldExtents[3];
+    for (int j = 0; j < 3; j++)
+    {
+        worldCenter[j] = m.m[3][j];
+        worldExtents[j] = 0.0f;
+        for (int i = 0; i < 3; i++)
+        {
+            worldCenter[j] += center[i] * m.m[i][j];
+            worldExtents[j] += extents[i] * fabsf(m.m[i][j]);
+        }
+    }
+
+    outCenter = { worldCenter[0], worldCenter[1], worldCenter[2] };
+    outExtents = { worldExtents[0], worldExtents[1], worldExtents[2] };
+}
+
+BoundingSphere math::TransformBoundingSphere(const BoundingSphere& sphere, const Mat4& transform)
+{
+    const Mat4& m = transform;
+
+    const float center[3] = { sphere.center.x, sphere.center.y, sphere.center.z };
+
+    float worldCenter[3];
+    float maxScaleSq = 0.0f;
+    for (int j = 0; j < 3; j++)
+    {
+        worldCenter[j] = m.m[3][j];
+        for (int i = 0; i < 3; i++)
+            worldCenter[j] += center[i] * m.m[i][j];
+
+        float scaleSq = m.m[j][0] * m.m[j][0] + m.m[j][1] * m.m[j][1] + m.m[j][2] * m.m[j][2];
+        maxScaleSq = scaleSq > maxScaleSq ? scaleSq : maxScaleSq;
+    }
+
+    return { { worldCenter[0], worldCenter[1], worldCenter[2] }, sphere.radius * sqrtf(maxScaleSq) };
+}
+
+static bool IsBoxVisible(const Frustum& frustum, float cx, float cy, float cz, float ex, float ey, float ez)
+{
+    for (const Vec4& plane : frustum.planes)
+    {
+        // distance of the center plus the projected extents, fully behind the plane when negative
+        float distance = plane.x * cx + plane.y * cy + plane.z * cz + plane.w;
+        float radius = fabsf(plane.x) * ex + fabsf(plane.y) * ey + fabsf(plane.z) * ez;
+        if (distance + radius < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+uint32 math::FrustumCullBoxes(const Frustum& frustum, const BoundingBoxesSoA& boxes, uint32 count, uint8* outVisible)
+{
+    uint32 visibleCount = 0;
+    uint32 i = 0;
+
+#if BOUNDS_SSE
+    __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+    __m128 absPlaneX[6], absPlaneY[6], absPlaneZ[6];
+    for (int p = 0; p < 6; p++)
+    {
+        const Vec4& plane = frustum.planes[p];
+        planeX[p] = _mm_set1_ps(plane.x);
+        planeY[p] = _mm_set1_ps(plane.y);
+        planeZ[p] = _mm_set1_ps(plane.z);
+        planeW[p] = _mm_set1_ps(plane.w);
+        absPlaneX[p] = _mm_set1_ps(fabsf(plane.x));
+        absPlaneY[p] = _mm_set1_ps(fabsf(plane.y));
+        absPlaneZ[p] = _mm_set1_ps(fabsf(plane.z));
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+
+    // 4 boxes against every plane
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(boxes.centerX + i);
+        __m128 cy = _mm_loadu_ps(boxes.centerY + i);
+        __m128 cz = _mm_loadu_ps(boxes.centerZ + i);
+        __m128 ex = _mm_loadu_ps(boxes.extentX + i);
+        __m128 ey = _mm_loadu_ps(boxes.extentY + i);
+        __m128 ez = _mm_loadu_ps(boxes.extentZ + i);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; p++)
+        {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], cx), _mm_mul_ps(planeY[p], cy)), _mm_add_ps(_mm_mul_ps(planeZ[p], cz), planeW[p]));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absPlaneX[p], ex), _mm_mul_ps(absPlaneY[p], ey)), _mm_mul_ps(absPlaneZ[p], ez));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        uint32 mask = (uint32)_mm_movemask_ps(inside);
+        for (uint32 k = 0; k < 4; k++)
+        {
+            uint8 visible = (mask >> k) & 1;
+            outVisible[i + k] = visible;
+            visibleCount += visible;
+        }
+    }
+#endif
+
+    // what's left (or everything without sse)
+    for (; i < count; i++)
+    {
+        uint8 visible = IsBoxVisible(frustum, boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i], boxes.extentX[i], boxes.extentY[i], boxes.extentZ[i]) ? 1 : 0;
+        outVisible[i] = visible;
+        visibleCount += visible;
+    }
+
+    return visibleCount;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "core/coreminimal.h"
+#include "vector.h"
+#include "matrix.h"
+
+struct BoundingBox
+{
+	Vec3 min;
+	Vec3 max;
+};
+
+struct BoundingSphere
+{
+	Vec3 center;
+	float radius;
+};
+
+// planes point inwards, p is inside a plane when dot(plane.xyz, p) + plane.w >= 0
+struct Frustum
+{
+	// left, right, bottom, top, near, far
+	Vec4 planes[6];
+};
+
+// world space boxes as center / extents, one array per component so they can be tested several at a time
+struct BoundingBoxesSoA
+{
+	const float* centerX;
+	const float* centerY;
+	const float* centerZ;
+	const float* extentX;
+	const float* extentY;
+	const float* extentZ;
+};
+
+namespace math
+{
+	CORE_API Frustum GetFrustum(const Mat4& viewProjection);
+
+	// box of the transformed box, as center / extents
+	CORE_API void TransformBoundingBox(const BoundingBox& box, const Mat4& transform, Vec3& outCenter, Vec3& outExtents);
+	// the radius grows with the biggest scale axis
+	CORE_API BoundingSphere TransformBoundingSphere(const BoundingSphere& sphere, const Mat4& transform);
+
+	// outVisible[i] = 1 if box i intersects the frustum, 0 otherwise. returns how many are visible
+	CORE_API uint32 FrustumCullBoxes(const Frustum& frustum, const BoundingBoxesSoA& boxes, uint32 count, uint8* outVisible);
+}
@@ -2,4 +2,6 @@
 
 #include "generic.h"
 #include "vector.h"
-#include "matrix.h"
\ No newline at end of file
+#include "matrix.h"
+#include "quat.h"
+#include "bounds.h"
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "math.h"
+#include "engine/benchmark_utils.h"
+
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+
+#if PLATFORM_WIN32
+	// what the engine used before its own math, kept here as the baseline
+	#include <DirectXMath.h>
+#endif
+
+static constexpr uint32 BENCHMARK_COUNT = 4096;
+static constexpr uint32 BENCHMARK_ITERATIONS = 2000;
+static constexpr double BENCHMARK_ITEMS = (double)BENCHMARK_COUNT * BENCHMARK_ITERATIONS;
+
+static void PrintHeader(const char* title)
+{
+	fprintf(stdout, "\n%s\n", title);
+	benchmark::PrintColumns("item");
+}
+
+static Mat4 MultiplyScalar(const Mat4& a, const Mat4& b)
+{
+	Mat4 result;
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 4; j++)
+			result.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j] + a.m[i][3] * b.m[3][j];
+	return result;
+}
+
+#if PLATFORM_WIN32
+static float MaxDifference(const Mat4& a, const Mat4& b)
+{
+	float maxDifference = 0.0f;
+	for (int i = 0; i < 4; i++)
+		for (int j = 0; j < 4; j++)
+			maxDifference = fabsf(a.m[i][j] - b.m[i][j]) > maxDifference ? fabsf(a.m[i][j] - b.m[i][j]) : maxDifference;
+	return maxDifference;
+}
+#endif
+
+void BenchmarkMath()
+{
+	std::vector<EulerTransform> eulerTransforms(BENCHMARK_COUNT);
+	std::vector<Transform> transforms(BENCHMARK_COUNT);
+	std::vector<Vec3> points(BENCHMARK_COUNT);
+	std::vector<Quat> quats(BENCHMARK_COUNT);
+	for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+	{
+		float f = (float)i;
+		eulerTransforms[i] = { { f * 0.5f, -f, f * 0.25f }, { fmodf(f * 7.0f, 360.0f), fmodf(f * 13.0f, 360.0f), fmodf(f * 3.0f, 360.0f) }, { 1.0f + f * 0.001f, 1.0f, 2.0f } };
+		transforms[i] = math::ToTransform(eulerTransforms[i]);
+		points[i] = { f * 0.1f, f * -0.2f, f * 0.3f };
+		quats[i] = transforms[i].rotation;
+	}
+
+	Mat4 viewProjection = math::GetViewMatrix({ 0.0f, 2.0f, -10.0f }, Vec3{ 10.0f, 20.0f, 0.0f }) * math::GetPerspectiveMatrix(16.0f / 9.0f, 60.0f, 0.01f, 1000.0f);
+
+	std::vector<Mat4> models(BENCHMARK_COUNT);
+	std::vector<Mat4> results(BENCHMARK_COUNT);
+	std::vector<Vec3> outPoints(BENCHMARK_COUNT);
+	math::GetModelMatrices(transforms.data(), BENCHMARK_COUNT, models.data());
+
+	fprintf(stdout, "Math, %u items per run, %u runs, engine simd: %s\n", BENCHMARK_COUNT, BENCHMARK_ITERATIONS, math::GetSimdName());
+
+	// model matrices from transforms
+
+	PrintHeader("model matrix from location, rotation, scale");
+	double baseline = 0.0;
+
+#if PLATFORM_WIN32
+	baseline = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+		{
+			const EulerTransform& t = eulerTransforms[i];
+			DirectX::XMMATRIX m =
+				DirectX::XMMatrixScaling(t.scale.x, t.scale.y, t.scale.z) *
+				DirectX::XMMatrixRotationRollPitchYaw(math::DegToRad(t.rotation.x), math::DegToRad(t.rotation.y), math::DegToRad(t.rotation.z)) *
+				DirectX::XMMatrixTranslation(t.location.x, t.location.y, t.location.z);
+			DirectX::XMStoreFloat4x4((DirectX::XMFLOAT4X4*)&results[i], m);
+		}
+	});
+	benchmark::PrintCase("directxmath", baseline, baseline, BENCHMARK_ITEMS);
+
+	// same matrices as before the switch
+	float maxDifference = 0.0f;
+	for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+	{
+		float difference = MaxDifference(results[i], models[i]);
+		maxDifference = difference > maxDifference ? difference : maxDifference;
+	}
+	fprintf(stdout, "(engine vs directxmath max difference: %g)\n", maxDifference);
+#endif
+
+	double seconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]() { math::GetModelMatrices(transforms.data(), BENCHMARK_COUNT, results.data()); });
+	double eulerSeconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+			results[i] = math::GetModelMatrix(eulerTransforms[i].location, eulerTransforms[i].rotation, eulerTransforms[i].scale);
+	});
+	// no directxmath, the euler path is the baseline
+	if (baseline == 0.0)
+		baseline = eulerSeconds;
+	benchmark::PrintCase("engine GetModelMatrix (euler)", eulerSeconds, baseline, BENCHMARK_ITEMS);
+	benchmark::PrintCase("engine GetModelMatrices (quaternion)", seconds, baseline, BENCHMARK_ITEMS);
+	benchmark::KeepResult(results[BENCHMARK_COUNT - 1].m[0][0]);
+
+	// model * view projection
+
+	PrintHeader("compose matrices (model * view projection)");
+
+	baseline = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+			results[i] = MultiplyScalar(models[i], viewProjection);
+	});
+	benchmark::PrintCase("scalar reference", baseline, baseline, BENCHMARK_ITEMS);
+
+#if PLATFORM_WIN32
+	seconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		DirectX::XMMATRIX vp = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)&viewProjection);
+		for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+		{
+			DirectX::XMMATRIX m = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)&models[i]);
+			DirectX::XMStoreFloat4x4((DirectX::XMFLOAT4X4*)&results[i], DirectX::XMMatrixMultiply(m, vp));
+		}
+	});
+	benchmark::PrintCase("directxmath", seconds, baseline, BENCHMARK_ITEMS);
+#endif
+
+	seconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+			results[i] = models[i] * viewProjection;
+	});
+	benchmark::PrintCase("engine operator*", seconds, baseline, BENCHMARK_ITEMS);
+	seconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]() { math::MultiplyMatrices(models.data(), viewProjection, BENCHMARK_COUNT, results.data()); });
+	benchmark::PrintCase("engine MultiplyMatrices", seconds, baseline, BENCHMARK_ITEMS);
+	benchmark::KeepResult(results[BENCHMARK_COUNT - 1].m[3][3]);
+
+	// points
+
+	PrintHeader("transform points");
+
+	const Mat4& model = models[1];
+	baseline = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+		{
+			const Vec3& p = points[i];
+			outPoints[i] =
+			{
+				p.x * model.m[0][0] + p.y * model.m[1][0] + p.z * model.m[2][0] + model.m[3][0],
+				p.x * model.m[0][1] + p.y * model.m[1][1] + p.z * model.m[2][1] + model.m[3][1],
+				p.x * model.m[0][2] + p.y * model.m[1][2] + p.z * model.m[2][2] + model.m[3][2]
+			};
+		}
+	});
+	benchmark::PrintCase("scalar reference", baseline, baseline, BENCHMARK_ITEMS);
+
+#if PLATFORM_WIN32
+	seconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		DirectX::XMMATRIX m = DirectX::XMLoadFloat4x4((const DirectX::XMFLOAT4X4*)&model);
+		for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+		{
+			DirectX::XMVECTOR p = DirectX::XMLoadFloat3((const DirectX::XMFLOAT3*)&points[i]);
+			DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)&outPoints[i], DirectX::XMVector3Transform(p, m));
+		}
+	});
+	benchmark::PrintCase("directxmath", seconds, baseline, BENCHMARK_ITEMS);
+#endif
+
+	seconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (uint32 i = 0; i < BENCHMARK_COUNT; i++)
+			outPoints[i] = math::TransformPoint(points[i], model);
+	});
+	benchmark::PrintCase("engine TransformPoint", seconds, baseline, BENCHMARK_ITEMS);
+	seconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]() { math::TransformPoints(points.data(), BENCHMARK_COUNT, model, outPoints.data()); });
+	benchmark::PrintCase("engine TransformPoints", seconds, baseline, BENCHMARK_ITEMS);
+	benchmark::KeepResult(outPoints[BENCHMARK_COUNT - 1].x);
+
+	// quaternions
+
+	PrintHeader("quaternion multiply");
+
+	std::vector<Quat> outQuats(BENCHMARK_COUNT);
+	baseline = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (uint32 i = 0; i + 1 < BENCHMARK_COUNT; i++)
+		{
+			// hamilton product quats[i + 1] * quats[i]
+			const Quat& a = quats[i];
+			const Quat& b = quats[i + 1];
+			outQuats[i] =
+			{
+				b.w * a.x + b.x * a.w + b.y * a.z - b.z * a.y,
+				b.w * a.y - b.x * a.z + b.y * a.w + b.z * a.x,
+				b.w * a.z + b.x * a.y - b.y * a.x + b.z * a.w,
+				b.w * a.w - b.x * a.x - b.y * a.y - b.z * a.z
+			};
+		}
+	});
+	benchmark::PrintCase("scalar reference", baseline, baseline, BENCHMARK_ITEMS);
+
+#if PLATFORM_WIN32
+	seconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (uint32 i = 0; i + 1 < BENCHMARK_COUNT; i++)
+		{
+			DirectX::XMVECTOR a = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)&quats[i]);
+			DirectX::XMVECTOR b = DirectX::XMLoadFloat4((const DirectX::XMFLOAT4*)&quats[i + 1]);
+			DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)&outQuats[i], DirectX::XMQuaternionMultiply(a, b));
+		}
+	});
+	benchmark::PrintCase("directxmath", seconds, baseline, BENCHMARK_ITEMS);
+#endif
+
+	seconds = benchmark::TimeCase(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (uint32 i = 0; i + 1 < BENCHMARK_COUNT; i++)
+			outQuats[i] = math::QuatMultiply(quats[i], quats[i + 1]);
+	});
+	benchmark::PrintCase("engine QuatMultiply", seconds, baseline, BENCHMARK_ITEMS);
+	benchmark::KeepResult(outQuats[0].w);
+}
@@ -1,30 +1,212 @@
 #include "matrix.h"
+#include "quat.h"
+#include "matrix_internal.h"
+#include "simd.h"
+#include "platform/cpu.h"
+#include <math.h>
 
-Mat4 math::GetModelMatrix(Vec3 location, Vec3 rotation, Vec3 scale)
+using namespace simd;
+
+static inline Float4 LoadRow(const Mat4& matrix, int row)
+{
+    return Load(matrix.m[row]);
+}
+
+// out.row = row * b, the b rows are loaded once by the caller
+static inline Float4 MultiplyRow(Float4 row, Float4 b0, Float4 b1, Float4 b2, Float4 b3)
+{
+    Float4 result = Mul(SplatLane<0>(row), b0);
+    result = MulAdd(SplatLane<1>(row), b1, result);
+    result = MulAdd(SplatLane<2>(row), b2, result);
+    return MulAdd(SplatLane<3>(row), b3, result);
+}
+
+static inline void MultiplyMatrix(const Mat4& a, Float4 b0, Float4 b1, Float4 b2, Float4 b3, Mat4& out)
+{
+    // every row of a is read before the matching row of out is written, out can be a
+    for (int i = 0; i < 4; i++)
+        Store(out.m[i], MultiplyRow(LoadRow(a, i), b0, b1, b2, b3));
+}
+
+static const MatrixBatchKernels* GetAVX2Kernels()
+{
+    static const MatrixBatchKernels* kernels = CpuInfo::SupportsAVX2() ? GetMatrixBatchKernels_AVX2() : nullptr;
+    return kernels;
+}
+
+Mat4 operator*(const Mat4& a, const Mat4& b)
+{
+    Mat4 result;
+    MultiplyMatrix(a, LoadRow(b, 0), LoadRow(b, 1), LoadRow(b, 2), LoadRow(b, 3), result);
+    return result;
+}
+
+Mat4 math::GetIdentityMatrix()
 {
     return
-    {
-        DirectX::XMMatrixScaling(scale.x, scale.y, scale.z)
-        *
-        DirectX::XMMatrixRotationRollPitchYawFromVector(VEC_TO_RAD(rotation))
-        *
-        DirectX::XMMatrixTranslation(location.x, location.y, location.z)
-    };
+    {{
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    }};
+}
+
+Mat4 math::GetScaleMatrix(Vec3 scale)
+{
+    return
+    {{
+        { scale.x, 0.0f, 0.0f, 0.0f },
+        { 0.0f, scale.y, 0.0f, 0.0f },
+        { 0.0f, 0.0f, scale.z, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    }};
+}
+
+Mat4 math::GetTranslationMatrix(Vec3 location)
+{
+    return
+    {{
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { location.x, location.y, location.z, 1.0f }
+    }};
+}
+
+Mat4 math::GetRotationMatrix(Vec3 rotation)
+{
+    float sp = sinf(DegToRad(rotation.x)), cp = cosf(DegToRad(rotation.x));
+    float sy = sinf(DegToRad(rotation.y)), cy = cosf(DegToRad(rotation.y));
+    float sr = sinf(DegToRad(rotation.z)), cr = cosf(DegToRad(rotation.z));
+
+    // roll * pitch * yaw multiplied out
+    return
+    {{
+        { cr * cy + sr * sp * sy, sr * cp, sr * sp * cy - cr * sy, 0.0f },
+        { cr * sp * sy - sr * cy, cr * cp, sr * sy + cr * sp * cy, 0.0f },
+        { cp * sy, -sp, cp * cy, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    }};
+}
+
+Mat4 math::GetModelMatrix(Vec3 location, Vec3 rotation, Vec3 scale)
+{
+    // scale * rotation * translation: the rotation rows scaled, the location as the last row
+    Mat4 model = GetRotationMatrix(rotation);
+    Store(model.m[0], Mul(LoadRow(model, 0), Splat(scale.x)));
+    Store(model.m[1], Mul(LoadRow(model, 1), Splat(scale.y)));
+    Store(model.m[2], Mul(LoadRow(model, 2), Splat(scale.z)));
+    Store(model.m[3], Set(location.x, location.y, location.z, 1.0f));
+    return model;
 }
 
 Mat4 math::GetViewMatrix(Vec3 camLocation, Vec3 camRotation)
 {
-    auto defaultView = DirectX::XMMatrixLookAtLH(VEC_TO_XVEC(camLocation), VEC_TO_XVEC((GetForwardVector(camRotation) + camLocation)), VEC_TO_XVEC(GetUpVector(camRotation)));
-    auto zRotation = DirectX::XMMatrixRotationZ(math::DegToRad(camRotation.z));
-    return defaultView * zRotation;
+    // left handed look to, the basis as columns and the camera location moved to the origin
+    Vec3 forward = Normalize(GetForwardVector(camRotation));
+    Vec3 right = Normalize(Cross(GetUpVector(camRotation), forward));
+    Vec3 up = Cross(forward, right);
+
+    Mat4 lookTo =
+    {{
+        { right.x, up.x, forward.x, 0.0f },
+        { right.y, up.y, forward.y, 0.0f },
+        { right.z, up.z, forward.z, 0.0f },
+        { -Dot(right, camLocation), -Dot(up, camLocation), -Dot(forward, camLocation), 1.0f }
+    }};
+
+    float sr = sinf(DegToRad(camRotation.z)), cr = cosf(DegToRad(camRotation.z));
+    Mat4 zRotation =
+    {{
+        { cr, sr, 0.0f, 0.0f },
+        { -sr, cr, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    }};
+
+    return lookTo * zRotation;
 }
 
 Mat4 math::GetPerspectiveMatrix(float aspectRatio, float fov, float nearZ, float farZ)
 {
-    return DirectX::XMMatrixPerspectiveFovLH(math::DegToRad(fov), aspectRatio, nearZ, farZ);
+    float height = 1.0f / tanf(DegToRad(fov) * 0.5f);
+    float width = height / aspectRatio;
+    float range = farZ / (farZ - nearZ);
+
+    return
+    {{
+        { width, 0.0f, 0.0f, 0.0f },
+        { 0.0f, height, 0.0f, 0.0f },
+        { 0.0f, 0.0f, range, 1.0f },
+        { 0.0f, 0.0f, -range * nearZ, 0.0f }
+    }};
+}
+
+Mat4 math::GetMatrixTransposed(const Mat4& matrix)
+{
+    Float4 r0 = LoadRow(matrix, 0), r1 = LoadRow(matrix, 1), r2 = LoadRow(matrix, 2), r3 = LoadRow(matrix, 3);
+    Transpose(r0, r1, r2, r3);
+
+    Mat4 result;
+    Store(result.m[0], r0);
+    Store(result.m[1], r1);
+    Store(result.m[2], r2);
+    Store(result.m[3], r3);
+    return result;
+}
+
+void math::TransformPoints(const Vec3* points, uint32 count, const Mat4& matrix, Vec3* outPoints)
+{
+    if (const MatrixBatchKernels* avx2 = GetAVX2Kernels())
+    {
+        avx2->transformPoints(points, count, matrix, outPoints);
+        return;
+    }
+
+    // one point per simd register loses to plain scalar code, it's vectorized across points with avx2 only
+    for (uint32 i = 0; i < count; i++)
+        outPoints[i] = TransformPoint(points[i], matrix);
+}
+
+void math::MultiplyMatrices(const Mat4* a, const Mat4& b, uint32 count, Mat4* out)
+{
+    if (const MatrixBatchKernels* avx2 = GetAVX2Kernels())
+    {
+        avx2->multiplyMatrices(a, b, count, out);
+        return;
+    }
+
+    Float4 b0 = LoadRow(b, 0), b1 = LoadRow(b, 1), b2 = LoadRow(b, 2), b3 = LoadRow(b, 3);
+    for (uint32 i = 0; i < count; i++)
+        MultiplyMatrix(a[i], b0, b1, b2, b3, out[i]);
+}
+
+void math::MultiplyMatrices(const Mat4* a, const Mat4* b, uint32 count, Mat4* out)
+{
+    if (const MatrixBatchKernels* avx2 = GetAVX2Kernels())
+    {
+        avx2->multiplyMatricesPairwise(a, b, count, out);
+        return;
+    }
+
+    for (uint32 i = 0; i < count; i++)
+        MultiplyMatrix(a[i], LoadRow(b[i], 0), LoadRow(b[i], 1), LoadRow(b[i], 2), LoadRow(b[i], 3), out[i]);
+}
+
+void math::TransposeMatrices(const Mat4* matrices, uint32 count, Mat4* out)
+{
+    for (uint32 i = 0; i < count; i++)
+        out[i] = GetMatrixTransposed(matrices[i]);
+}
+
+void math::GetModelMatrices(const Transform* transforms, uint32 count, Mat4* out)
+{
+    for (uint32 i = 0; i < count; i++)
+        out[i] = GetModelMatrix(transforms[i].location, transforms[i].rotation, transforms[i].scale);
 }
 
-Mat4 math::GetMatrixTransposed(Mat4 matrix)
+const char* math::GetSimdName()
 {
-    return DirectX::XMMatrixTranspose(matrix);
+    return GetAVX2Kernels() ? GROOVY_SIMD_NAME "+avx2" : GROOVY_SIMD_NAME;
 }
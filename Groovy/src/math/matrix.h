@@ -1,14 +1,69 @@
 #pragma once
 
+#include "core/coreminimal.h"
 #include "vector.h"
-#include <DirectXMath.h>
 
-typedef DirectX::XMMATRIX Mat4;
+// row vectors (p' = p * M, so A * B applies A first), translation in the last row. same layout as the shaders get after a transpose
+struct alignas(16) Mat4
+{
+	float m[4][4];
+};
+
+CORE_API Mat4 operator*(const Mat4& a, const Mat4& b);
 
 namespace math
 {
+	CORE_API Mat4 GetIdentityMatrix();
+	CORE_API Mat4 GetScaleMatrix(Vec3 scale);
+	CORE_API Mat4 GetTranslationMatrix(Vec3 location);
+	// degrees, roll (z) then pitch (x) then yaw (y)
+	CORE_API Mat4 GetRotationMatrix(Vec3 rotation);
+
 	CORE_API Mat4 GetModelMatrix(Vec3 location, Vec3 rotation, Vec3 scale);
 	CORE_API Mat4 GetViewMatrix(Vec3 camLocation, Vec3 camRotation);
+	// left handed, depth from 0 to 1
 	CORE_API Mat4 GetPerspectiveMatrix(float aspectRatio, float fov, float nearZ, float farZ);
-	CORE_API Mat4 GetMatrixTransposed(Mat4 matrix);
-}
\ No newline at end of file
+	CORE_API Mat4 GetMatrixTransposed(const Mat4& matrix);
+
+	// w = 1. inline and scalar, they're called per item
+	inline Vec3 TransformPoint(Vec3 point, const Mat4& matrix)
+	{
+		return
+		{
+			point.x * matrix.m[0][0] + point.y * matrix.m[1][0] + point.z * matrix.m[2][0] + matrix.m[3][0],
+			point.x * matrix.m[0][1] + point.y * matrix.m[1][1] + point.z * matrix.m[2][1] + matrix.m[3][1],
+			point.x * matrix.m[0][2] + point.y * matrix.m[1][2] + point.z * matrix.m[2][2] + matrix.m[3][2]
+		};
+	}
+
+	// w = 0
+	inline Vec3 TransformDirection(Vec3 direction, const Mat4& matrix)
+	{
+		return
+		{
+			direction.x * matrix.m[0][0] + direction.y * matrix.m[1][0] + direction.z * matrix.m[2][0],
+			direction.x * matrix.m[0][1] + direction.y * matrix.m[1][1] + direction.z * matrix.m[2][1],
+			direction.x * matrix.m[0][2] + direction.y * matrix.m[1][2] + direction.z * matrix.m[2][2]
+		};
+	}
+
+	/*
+		batch versions, the whole array in one call (avx2 when the cpu has it). outputs may alias the inputs
+
+		math::TransformPoints(localPositions, count, model, worldPositions);
+		math::MultiplyMatrices(models, viewProjection, count, mvps);
+	*/
+	CORE_API void TransformPoints(const Vec3* points, uint32 count, const Mat4& matrix, Vec3* outPoints);
+	// out[i] = a[i] * b
+	CORE_API void MultiplyMatrices(const Mat4* a, const Mat4& b, uint32 count, Mat4* out);
+	// out[i] = a[i] * b[i]
+	CORE_API void MultiplyMatrices(const Mat4* a, const Mat4* b, uint32 count, Mat4* out);
+	CORE_API void TransposeMatrices(const Mat4* matrices, uint32 count, Mat4* out);
+	CORE_API void GetModelMatrices(const Transform* transforms, uint32 count, Mat4* out);
+
+	// backend of the functions above, "sse2", "neon" or "scalar" with "+avx2" when the batch functions use it
+	CORE_API const char* GetSimdName();
+}
+
+// benchmark, engine math (scalar, simd and batch paths) against directxmath where it's available
+void BenchmarkMath();
@@ -0,0 +1,122 @@
+#include "matrix_internal.h"
+
+// built with avx2 code generation (see Groovy/premake5.lua), only called after checking the cpu supports it
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+// the same 4 floats in both halves
+static inline __m256 BroadcastRow(const Mat4& matrix, int row)
+{
+    return _mm256_broadcast_ps((const __m128*)matrix.m[row]);
+}
+
+// two rows of a (one per half) times b
+static inline __m256 MultiplyRows(__m256 rows, __m256 b0, __m256 b1, __m256 b2, __m256 b3)
+{
+    __m256 result = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b0);
+    result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), b1));
+    result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b2));
+    return _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b3));
+}
+
+static inline void MultiplyMatrix(const Mat4& a, __m256 b0, __m256 b1, __m256 b2, __m256 b3, Mat4& out)
+{
+    // both halves of a are loaded before out is written, out can be a
+    __m256 rows01 = _mm256_loadu_ps(a.m[0]);
+    __m256 rows23 = _mm256_loadu_ps(a.m[2]);
+    _mm256_storeu_ps(out.m[0], MultiplyRows(rows01, b0, b1, b2, b3));
+    _mm256_storeu_ps(out.m[2], MultiplyRows(rows23, b0, b1, b2, b3));
+}
+
+// the 8 points of 24 contiguous floats as two 128 bit halves each: [x0 y0 z0 x1 | x4 y4 z4 x5] [y1 z1 x2 y2 | y5 z5 x6 y6] [z2 x3 y3 z3 | z6 x7 y7 z7]
+static inline __m256 LoadHalves(const float* p)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+}
+
+static inline void StoreHalves(float* p, __m256 v)
+{
+    _mm_storeu_ps(p, _mm256_castps256_ps128(v));
+    _mm_storeu_ps(p + 12, _mm256_extractf128_ps(v, 1));
+}
+
+static void TransformPoints_AVX2(const Vec3* points, uint32 count, const Mat4& matrix, Vec3* outPoints)
+{
+    static_assert(sizeof(Vec3) == 3 * sizeof(float), "Vec3 is expected to be packed");
+
+    const float* in = (const float*)points;
+    float* out = (float*)outPoints;
+
+    __m256 m[4][3];
+    for (int row = 0; row < 4; row++)
+        for (int column = 0; column < 3; column++)
+            m[row][column] = _mm256_set1_ps(matrix.m[row][column]);
+
+    // 8 points at a time, loaded contiguously and deinterleaved into x, y and z with shuffles (and back for the store)
+    uint32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const float* p = in + i * 3;
+        __m256 m03 = LoadHalves(p);
+        __m256 m14 = LoadHalves(p + 4);
+        __m256 m25 = LoadHalves(p + 8);
+
+        __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+        __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+        __m256 x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        __m256 y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256 z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+
+        __m256 result[3];
+        for (int column = 0; column < 3; column++)
+        {
+            __m256 v = _mm256_add_ps(_mm256_mul_ps(x, m[0][column]), m[3][column]);
+            v = _mm256_add_ps(v, _mm256_mul_ps(y, m[1][column]));
+            result[column] = _mm256_add_ps(v, _mm256_mul_ps(z, m[2][column]));
+        }
+
+        __m256 rxy = _mm256_shuffle_ps(result[0], result[1], _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 ryz = _mm256_shuffle_ps(result[1], result[2], _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 rzx = _mm256_shuffle_ps(result[2], result[0], _MM_SHUFFLE(3, 1, 2, 0));
+
+        // everything is loaded before anything is stored, out can be points
+        float* o = out + i * 3;
+        StoreHalves(o, _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0)));
+        StoreHalves(o + 4, _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0)));
+        StoreHalves(o + 8, _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+
+    // what's left
+    for (; i < count; i++)
+        outPoints[i] = math::TransformPoint(points[i], matrix);
+}
+
+static void MultiplyMatrices_AVX2(const Mat4* a, const Mat4& b, uint32 count, Mat4* out)
+{
+    __m256 b0 = BroadcastRow(b, 0), b1 = BroadcastRow(b, 1), b2 = BroadcastRow(b, 2), b3 = BroadcastRow(b, 3);
+    for (uint32 i = 0; i < count; i++)
+        MultiplyMatrix(a[i], b0, b1, b2, b3, out[i]);
+}
+
+static void MultiplyMatricesPairwise_AVX2(const Mat4* a, const Mat4* b, uint32 count, Mat4* out)
+{
+    for (uint32 i = 0; i < count; i++)
+        MultiplyMatrix(a[i], BroadcastRow(b[i], 0), BroadcastRow(b[i], 1), BroadcastRow(b[i], 2), BroadcastRow(b[i], 3), out[i]);
+}
+
+static const MatrixBatchKernels AVX2_KERNELS = { TransformPoints_AVX2, MultiplyMatrices_AVX2, MultiplyMatricesPairwise_AVX2 };
+
+const MatrixBatchKernels* GetMatrixBatchKernels_AVX2()
+{
+    return &AVX2_KERNELS;
+}
+
+#else
+
+const MatrixBatchKernels* GetMatrixBatchKernels_AVX2()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "matrix.h"
+
+// batch kernels built with other code generation, shared by matrix.cpp and the kernel files
+
+struct MatrixBatchKernels
+{
+	void(*transformPoints)(const Vec3* points, uint32 count, const Mat4& matrix, Vec3* outPoints);
+	void(*multiplyMatrices)(const Mat4* a, const Mat4& b, uint32 count, Mat4* out);
+	void(*multiplyMatricesPairwise)(const Mat4* a, const Mat4* b, uint32 count, Mat4* out);
+};
+
+// nullptr when the kernels are not compiled in
+const MatrixBatchKernels* GetMatrixBatchKernels_AVX2();
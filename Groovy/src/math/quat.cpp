@@ -0,0 +1,194 @@
+#include "quat.h"
+#include "simd.h"
+#include <math.h>
+
+using namespace simd;
+
+static inline Float4 LoadQuat(const Quat& q)
+{
+    return Load(&q.x);
+}
+
+static inline Quat StoreQuat(Float4 v)
+{
+    Quat q;
+    Store(&q.x, v);
+    return q;
+}
+
+Quat math::QuatFromEuler(Vec3 rotation)
+{
+    float sp = sinf(DegToRad(rotation.x) * 0.5f), cp = cosf(DegToRad(rotation.x) * 0.5f);
+    float sy = sinf(DegToRad(rotation.y) * 0.5f), cy = cosf(DegToRad(rotation.y) * 0.5f);
+    float sr = sinf(DegToRad(rotation.z) * 0.5f), cr = cosf(DegToRad(rotation.z) * 0.5f);
+
+    return
+    {
+        cr * sp * cy + sr * cp * sy,
+        cr * cp * sy - sr * sp * cy,
+        sr * cp * cy - cr * sp * sy,
+        cr * cp * cy + sr * sp * sy
+    };
+}
+
+Vec3 math::QuatToEuler(Quat q)
+{
+    constexpr float RAD_TO_DEG = (float)(180.0 / PI);
+
+    // the rotation matrix entries the angles come from, see GetRotationMatrix
+    float m21 = 2.0f * (q.y * q.z - q.x * q.w);
+    float sinPitch = Clamp(-m21, -1.0f, 1.0f);
+
+    Vec3 rotation;
+    rotation.x = asinf(sinPitch) * RAD_TO_DEG;
+
+    if (fabsf(sinPitch) < 0.9999f)
+    {
+        rotation.y = atan2f(2.0f * (q.x * q.z + q.y * q.w), 1.0f - 2.0f * (q.x * q.x + q.y * q.y)) * RAD_TO_DEG;
+        rotation.z = atan2f(2.0f * (q.x * q.y + q.z * q.w), 1.0f - 2.0f * (q.x * q.x + q.z * q.z)) * RAD_TO_DEG;
+    }
+    else
+    {
+        // looking straight up or down, roll and yaw turn around the same axis: all of it goes to yaw
+        rotation.y = atan2f(-2.0f * (q.x * q.z - q.y * q.w), 1.0f - 2.0f * (q.y * q.y + q.z * q.z)) * RAD_TO_DEG;
+        rotation.z = 0.0f;
+    }
+
+    return rotation;
+}
+
+Quat math::QuatFromAxisAngle(Vec3 axis, float angle)
+{
+    float halfAngle = DegToRad(angle) * 0.5f;
+    float s = sinf(halfAngle);
+    return { axis.x * s, axis.y * s, axis.z * s, cosf(halfAngle) };
+}
+
+float math::QuatDot(Quat a, Quat b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+Quat math::QuatNormalize(Quat q)
+{
+    float length = sqrtf(QuatDot(q, q));
+    if (length <= 0.0f)
+        return GetIdentityQuat();
+
+    return StoreQuat(Mul(LoadQuat(q), Splat(1.0f / length)));
+}
+
+Quat math::QuatInverse(Quat q)
+{
+    // the conjugate, unit quaternions only
+    return { -q.x, -q.y, -q.z, q.w };
+}
+
+Quat math::QuatSlerp(Quat a, Quat b, float t)
+{
+    float cosAngle = QuatDot(a, b);
+
+    // q and -q are the same rotation, take the short way
+    if (cosAngle < 0.0f)
+    {
+        b = { -b.x, -b.y, -b.z, -b.w };
+        cosAngle = -cosAngle;
+    }
+
+    float wa, wb;
+    if (cosAngle > 0.9995f)
+    {
+        // almost the same rotation, lerp (normalized below)
+        wa = 1.0f - t;
+        wb = t;
+    }
+    else
+    {
+        float angle = acosf(cosAngle);
+        float invSin = 1.0f / sinf(angle);
+        wa = sinf((1.0f - t) * angle) * invSin;
+        wb = sinf(t * angle) * invSin;
+    }
+
+    return QuatNormalize(StoreQuat(MulAdd(LoadQuat(a), Splat(wa), Mul(LoadQuat(b), Splat(wb)))));
+}
+
+Vec3 math::QuatRotateVector(Quat q, Vec3 v)
+{
+    // v + w * t + cross(u, t), t = 2 * cross(u, v)
+    Vec3 u = { q.x, q.y, q.z };
+    Vec3 t = Cross(u, v) * 2.0f;
+    return v + t * q.w + Cross(u, t);
+}
+
+Mat4 math::QuatToMatrix(Quat q)
+{
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    return
+    {{
+        { 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f },
+        { 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f },
+        { 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f }
+    }};
+}
+
+Mat4 math::GetModelMatrix(Vec3 location, Quat rotation, Vec3 scale)
+{
+    Mat4 model = QuatToMatrix(rotation);
+    Store(model.m[0], Mul(Load(model.m[0]), Splat(scale.x)));
+    Store(model.m[1], Mul(Load(model.m[1]), Splat(scale.y)));
+    Store(model.m[2], Mul(Load(model.m[2]), Splat(scale.z)));
+    Store(model.m[3], Set(location.x, location.y, location.z, 1.0f));
+    return model;
+}
+
+Mat4 math::GetViewMatrix(Vec3 camLocation, Quat camRotation)
+{
+    // the rotation transposed, the camera location moved to the origin
+    Vec3 right = GetRightVector(camRotation);
+    Vec3 up = GetUpVector(camRotation);
+    Vec3 forward = GetForwardVector(camRotation);
+
+    return
+    {{
+        { right.x, up.x, forward.x, 0.0f },
+        { right.y, up.y, forward.y, 0.0f },
+        { right.z, up.z, forward.z, 0.0f },
+        { -Dot(right, camLocation), -Dot(up, camLocation), -Dot(forward, camLocation), 1.0f }
+    }};
+}
+
+// rows of QuatToMatrix
+
+Vec3 math::GetForwardVector(Quat q)
+{
+    return { 2.0f * (q.x * q.z + q.w * q.y), 2.0f * (q.y * q.z - q.w * q.x), 1.0f - 2.0f * (q.x * q.x + q.y * q.y) };
+}
+
+Vec3 math::GetRightVector(Quat q)
+{
+    return { 1.0f - 2.0f * (q.y * q.y + q.z * q.z), 2.0f * (q.x * q.y + q.w * q.z), 2.0f * (q.x * q.z - q.w * q.y) };
+}
+
+Vec3 math::GetUpVector(Quat q)
+{
+    return { 2.0f * (q.x * q.y - q.w * q.z), 1.0f - 2.0f * (q.x * q.x + q.z * q.z), 2.0f * (q.y * q.z + q.w * q.x) };
+}
+
+Transform math::CombineTransforms(const Transform& local, const Transform& parent)
+{
+    Transform result;
+    result.location = parent.location + QuatRotateVector(parent.rotation, local.location * parent.scale);
+    result.rotation = QuatMultiply(local.rotation, parent.rotation);
+    result.scale = local.scale * parent.scale;
+    return result;
+}
+
+Transform math::ToTransform(const EulerTransform& transform)
+{
+    return { transform.location, QuatFromEuler(transform.rotation), transform.scale };
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "core/coreminimal.h"
+#include "vector.h"
+#include "matrix.h"
+
+// Transform before rotations were quaternions (degrees), what old scenes and property packs store
+struct EulerTransform
+{
+	Vec3 location;
+	Vec3 rotation;
+	Vec3 scale;
+};
+
+namespace math
+{
+	inline Quat GetIdentityQuat() { return { 0.0f, 0.0f, 0.0f, 1.0f }; }
+
+	// degrees, same rotation as GetRotationMatrix: roll (z) then pitch (x) then yaw (y)
+	CORE_API Quat QuatFromEuler(Vec3 rotation);
+	// degrees, pitch in [-90, 90]. the inverse of QuatFromEuler up to equivalent angles
+	CORE_API Vec3 QuatToEuler(Quat q);
+	// axis must be normalized, angle in degrees
+	CORE_API Quat QuatFromAxisAngle(Vec3 axis, float angle);
+
+	// rotates by a, then by b (like a * b with row vector matrices). hamilton product b * a, inline and scalar, it's called per item
+	inline Quat QuatMultiply(Quat a, Quat b)
+	{
+		return
+		{
+			b.w * a.x + b.x * a.w + b.y * a.z - b.z * a.y,
+			b.w * a.y - b.x * a.z + b.y * a.w + b.z * a.x,
+			b.w * a.z + b.x * a.y - b.y * a.x + b.z * a.w,
+			b.w * a.w - b.x * a.x - b.y * a.y - b.z * a.z
+		};
+	}
+	CORE_API Quat QuatNormalize(Quat q);
+	CORE_API Quat QuatInverse(Quat q);
+	// shortest path
+	CORE_API Quat QuatSlerp(Quat a, Quat b, float t);
+	CORE_API float QuatDot(Quat a, Quat b);
+
+	CORE_API Vec3 QuatRotateVector(Quat q, Vec3 v);
+	CORE_API Mat4 QuatToMatrix(Quat q);
+	CORE_API Mat4 GetModelMatrix(Vec3 location, Quat rotation, Vec3 scale);
+	// inverse of the camera's model matrix (no scale)
+	CORE_API Mat4 GetViewMatrix(Vec3 camLocation, Quat camRotation);
+
+	// the rotated axes, no trig
+	CORE_API Vec3 GetForwardVector(Quat rotation);
+	CORE_API Vec3 GetRightVector(Quat rotation);
+	CORE_API Vec3 GetUpVector(Quat rotation);
+
+	// local relative to parent, scaled, rotated and moved by it (parent scale applied on the local axes)
+	CORE_API Transform CombineTransforms(const Transform& local, const Transform& parent);
+	CORE_API Transform ToTransform(const EulerTransform& transform);
+}
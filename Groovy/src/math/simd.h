@@ -0,0 +1,108 @@
+#pragma once
+
+/*
+	4 wide float vector for the math library, picked at compile time:
+	sse2 on x86 (always there on x64), neon on arm, plain floats everywhere else.
+	Internal to the math .cpp files, the public types (Vec*, Mat4, Quat) stay plain structs.
+	AVX2 versions of the batch functions live in matrix_avx2.cpp and are picked at runtime.
+*/
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define GROOVY_SIMD_SSE 1
+	#define GROOVY_SIMD_NAME "sse2"
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+	#include <arm_neon.h>
+	#define GROOVY_SIMD_NEON 1
+	#define GROOVY_SIMD_NAME "neon"
+#else
+	#define GROOVY_SIMD_SCALAR 1
+	#define GROOVY_SIMD_NAME "scalar"
+#endif
+
+namespace simd
+{
+#if GROOVY_SIMD_SSE
+
+	typedef __m128 Float4;
+
+	inline Float4 Load(const float* p) { return _mm_loadu_ps(p); }
+	inline void Store(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+	inline Float4 Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+	inline Float4 Splat(float f) { return _mm_set1_ps(f); }
+	inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+	inline Float4 Sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+	inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+	// a * b + c
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+	template<int X, int Y, int Z, int W>
+	inline Float4 Shuffle(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X)); }
+
+	inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+
+	inline float GetX(Float4 v) { return _mm_cvtss_f32(v); }
+
+#elif GROOVY_SIMD_NEON
+
+	typedef float32x4_t Float4;
+
+	inline Float4 Load(const float* p) { return vld1q_f32(p); }
+	inline void Store(float* p, Float4 v) { vst1q_f32(p, v); }
+	inline Float4 Set(float x, float y, float z, float w) { float f[4] = { x, y, z, w }; return vld1q_f32(f); }
+	inline Float4 Splat(float f) { return vdupq_n_f32(f); }
+	inline Float4 Add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+	inline Float4 Sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+	inline Float4 Mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return vmlaq_f32(c, a, b); }
+
+	template<int X, int Y, int Z, int W>
+	inline Float4 Shuffle(Float4 v) { return Set(vgetq_lane_f32(v, X), vgetq_lane_f32(v, Y), vgetq_lane_f32(v, Z), vgetq_lane_f32(v, W)); }
+
+	inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+	{
+		float32x4x2_t t01 = vtrnq_f32(r0, r1);
+		float32x4x2_t t23 = vtrnq_f32(r2, r3);
+		r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+
+	inline float GetX(Float4 v) { return vgetq_lane_f32(v, 0); }
+
+#else
+
+	struct Float4
+	{
+		float v[4];
+	};
+
+	inline Float4 Load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+	inline void Store(float* p, Float4 v) { p[0] = v.v[0]; p[1] = v.v[1]; p[2] = v.v[2]; p[3] = v.v[3]; }
+	inline Float4 Set(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+	inline Float4 Splat(float f) { return { { f, f, f, f } }; }
+	inline Float4 Add(Float4 a, Float4 b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+	inline Float4 Sub(Float4 a, Float4 b) { return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+	inline Float4 Mul(Float4 a, Float4 b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return Add(Mul(a, b), c); }
+
+	template<int X, int Y, int Z, int W>
+	inline Float4 Shuffle(Float4 v) { return { { v.v[X], v.v[Y], v.v[Z], v.v[W] } }; }
+
+	inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+	{
+		Float4 t0 = r0, t1 = r1, t2 = r2, t3 = r3;
+		r0 = { { t0.v[0], t1.v[0], t2.v[0], t3.v[0] } };
+		r1 = { { t0.v[1], t1.v[1], t2.v[1], t3.v[1] } };
+		r2 = { { t0.v[2], t1.v[2], t2.v[2], t3.v[2] } };
+		r3 = { { t0.v[3], t1.v[3], t2.v[3], t3.v[3] } };
+	}
+
+	inline float GetX(Float4 v) { return v.v[0]; }
+
+#endif
+
+	template<int Lane>
+	inline Float4 SplatLane(Float4 v) { return Shuffle<Lane, Lane, Lane, Lane>(v); }
+}
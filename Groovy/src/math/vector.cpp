@@ -1,7 +1,6 @@
 #include "vector.h"
 #include "generic.h"
 #include <math.h>
-#include <DirectXMath.h>
 
 Vec3 math::GetForwardVector(Vec3 rotation)
 {
@@ -31,9 +30,7 @@ Vec3 math::GetRightVector(Vec3 rotation)
 
 Vec3 math::GetUpVector(Vec3 rotation)
 {
-    DirectX::XMVECTOR up = DirectX::XMVector3Cross(VEC_TO_XVEC(GetForwardVector(rotation)), VEC_TO_XVEC(GetRightVector(rotation)));
-
-    return { up.m128_f32[0], up.m128_f32[1], up.m128_f32[2] };
+    return Cross(GetForwardVector(rotation), GetRightVector(rotation));
 }
 
 float math::Magnitude(Vec3 v)
@@ -4,7 +4,6 @@
 #include "core/api.h"
 
 #define VEC_TO_RAD(v) { math::DegToRad(v.x), math::DegToRad(v.y), math::DegToRad(v.z) }
-#define VEC_TO_XVEC(v) { v.x, v.y, v.z, 1.0f }
 
 struct Vec2
 {
@@ -236,10 +235,16 @@ inline Vec3& operator/=(Vec3& v1, Vec3 v2)
 	return v1;
 }
 
+// rotation quaternion, w is the real part. unit length unless said otherwise, functions in quat.h
+struct Quat
+{
+	float x, y, z, w;
+};
+
 struct Transform
 {
 	Vec3 location;
-	Vec3 rotation;
+	Quat rotation;
 	Vec3 scale;
 };
 
@@ -251,4 +256,19 @@ namespace math
 
 	CORE_API float Magnitude(Vec3 v);
 	CORE_API Vec3 Normalize(Vec3 v);
+
+	inline float Dot(Vec3 v1, Vec3 v2)
+	{
+		return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+	}
+
+	inline Vec3 Cross(Vec3 v1, Vec3 v2)
+	{
+		return { v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x };
+	}
+
+	inline Vec3 Lerp(Vec3 v1, Vec3 v2, float t)
+	{
+		return v1 + (v2 - v1) * t;
+	}
 }
\ No newline at end of file
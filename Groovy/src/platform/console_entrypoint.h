@@ -0,0 +1,11 @@
+#pragma once
+
+#include "core/core.h"
+
+// console entrypoint for headless builds, works on every platform
+int32 GroovyHeadlessEntryPoint(int32 argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	return GroovyHeadlessEntryPoint(argc, argv);
+}
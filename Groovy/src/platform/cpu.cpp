@@ -0,0 +1,33 @@
+#include "cpu.h"
+#include "core/coreminimal.h"
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+bool CpuInfo::SupportsAVX2()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+	int32 info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx)
+		return false;
+
+	// the os must save the ymm registers
+	if ((_xgetbv(0) & 0x6) != 0x6)
+		return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
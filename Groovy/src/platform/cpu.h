@@ -0,0 +1,10 @@
+#pragma once
+
+#include "core/api.h"
+
+// instruction sets the cpu (and os) support, for code that picks a simd path at runtime
+class CORE_API CpuInfo
+{
+public:
+	static bool SupportsAVX2();
+};
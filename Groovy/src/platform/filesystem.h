@@ -10,6 +10,71 @@ enum EFileOpenResult
 	FILE_OPEN_RESULT_OK
 };
 
+enum EFileAccessHint
+{
+	FILE_ACCESS_HINT_NORMAL,
+	// read front to back once, the os reads ahead aggressively
+	FILE_ACCESS_HINT_SEQUENTIAL,
+	// scattered reads, no read ahead
+	FILE_ACCESS_HINT_RANDOM
+};
+
+/*
+	Read-only view of a whole file (see FileSystem::MapFileReadOnly), pages are read on first touch and shared with the os file cache.
+	The view is valid until the file is unmapped or the MappedFile destroyed.
+
+	MappedFile file;
+	if (FileSystem::MapFileReadOnly(path, file, FILE_ACCESS_HINT_SEQUENTIAL) == FILE_OPEN_RESULT_OK)
+		Parse(file.GetView());
+*/
+class CORE_API MappedFile
+{
+public:
+	MappedFile() : mData(nullptr), mSize(0) {}
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept
+		: mData(other.mData), mSize(other.mSize)
+	{
+		other.mData = nullptr;
+		other.mSize = 0;
+	}
+
+	MappedFile& operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Unmap();
+			mData = other.mData;
+			mSize = other.mSize;
+			other.mData = nullptr;
+			other.mSize = 0;
+		}
+		return *this;
+	}
+
+	~MappedFile() { Unmap(); }
+
+	void Unmap();
+
+	// empty files are never mapped
+	inline bool IsMapped() const { return mData != nullptr; }
+	inline const byte* GetData() const { return mData; }
+	inline size_t GetSize() const { return mSize; }
+	inline BufferView GetView() const { return BufferView(mData, mSize); }
+
+	void Advise(EFileAccessHint hint) const;
+	// starts reading [offset, offset + size) in the background
+	void Prefetch(size_t offset, size_t size) const;
+
+private:
+	byte* mData;
+	size_t mSize;
+
+	friend class FileSystem;
+};
+
 class CORE_API FileSystem
 {
 public:
@@ -18,6 +83,8 @@ public:
 	static std::vector<std::string> GetFilesInDir(const std::string& dir, const std::vector<std::string>& extensionsFilters);
 	static EFileOpenResult ReadFileBinary(const std::string& path, void* outBuffer, size_t bufferSize, size_t& outBytesRead);
 	static EFileOpenResult ReadFileBinary(const std::string& path, Buffer& outBuffer);
+	// no copy, prefer it when the content is only read
+	static EFileOpenResult MapFileReadOnly(const std::string& path, MappedFile& outFile, EFileAccessHint hint = FILE_ACCESS_HINT_NORMAL);
 	static EFileOpenResult WriteFileBinary(const std::string& path, const void* data, size_t sizeBytes);
 	static EFileOpenResult OverwriteFileBinary(const std::string& path, const void* data, size_t sizeBytes, size_t offset);
 	static EFileOpenResult DeleteFile(const std::string& path);
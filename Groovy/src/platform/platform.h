@@ -6,4 +6,5 @@
 #include "window.h"
 #include "input.h"
 #include "tick.h"
-#include "lib.h"
\ No newline at end of file
+#include "lib.h"
+#include "cpu.h"
\ No newline at end of file
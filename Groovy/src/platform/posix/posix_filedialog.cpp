@@ -0,0 +1,17 @@
+#if PLATFORM_LINUX
+
+#include "platform/filedialog.h"
+
+std::string FileDialog::OpenFileDialog(const std::string& titleBar, const ExtensionFilters& filters)
+{
+	GROOVY_LOG_WARN("FileDialog::OpenFileDialog not supported on this platform");
+	return {};
+}
+
+std::string FileDialog::SaveFileDialog(const std::string& titleBar)
+{
+	GROOVY_LOG_WARN("FileDialog::SaveFileDialog not supported on this platform");
+	return {};
+}
+
+#endif
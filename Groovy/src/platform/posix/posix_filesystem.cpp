@@ -0,0 +1,284 @@
+#if PLATFORM_LINUX
+
+#include "platform/filesystem.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static bool MatchesExtension(const std::string& fileName, const std::string& filter)
+{
+	// filters come in the win32 form "*.ext"
+	std::string ext = filter[0] == '*' ? filter.substr(1) : filter;
+	return fileName.size() >= ext.size() && fileName.compare(fileName.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+std::vector<std::string> FileSystem::GetFilesInDir(const std::string& dir, const std::vector<std::string>& extensionsFilters)
+{
+	std::vector<std::string> result;
+
+	DIR* dirHandle = opendir(dir.c_str());
+	if (!dirHandle)
+		return result;
+
+	while (dirent* entry = readdir(dirHandle))
+	{
+		std::string fileName = entry->d_name;
+
+		if (extensionsFilters.empty())
+		{
+			result.push_back(fileName);
+			continue;
+		}
+
+		for (const std::string& filter : extensionsFilters)
+		{
+			if (MatchesExtension(fileName, filter))
+			{
+				result.push_back(fileName);
+				break;
+			}
+		}
+	}
+
+	closedir(dirHandle);
+
+	return result;
+}
+
+static bool ReadAll(int fd, void* data, size_t size)
+{
+	byte* dst = (byte*)data;
+	while (size)
+	{
+		ssize_t bytesRead = read(fd, dst, size);
+		if (bytesRead <= 0)
+			return false;
+		dst += bytesRead;
+		size -= bytesRead;
+	}
+	return true;
+}
+
+static bool WriteAll(int fd, const void* data, size_t size)
+{
+	const byte* src = (const byte*)data;
+	while (size)
+	{
+		ssize_t bytesWritten = write(fd, src, size);
+		if (bytesWritten <= 0)
+			return false;
+		src += bytesWritten;
+		size -= bytesWritten;
+	}
+	return true;
+}
+
+EFileOpenResult FileSystem::ReadFileBinary(const std::string& path, void* outBuffer, size_t bufferSize, size_t& outBytesRead)
+{
+	check(outBuffer && bufferSize);
+
+	int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd == -1)
+	{
+		GROOVY_LOG_ERR("FileSystem::ReadFileBinary Unable to open file %s", path.c_str());
+		return FILE_OPEN_RESULT_FILE_NOT_FOUND;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) == -1)
+	{
+		GROOVY_LOG_ERR("FileSystem::ReadFileBinary Unable to read the size of file %s", path.c_str());
+		close(fd);
+		return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+	}
+
+	size_t bytesToRead = bufferSize < (size_t)fileStat.st_size ? bufferSize : (size_t)fileStat.st_size;
+
+	if (bytesToRead)
+	{
+		if (!ReadAll(fd, outBuffer, bytesToRead))
+		{
+			close(fd);
+			return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+		}
+
+		outBytesRead = bytesToRead;
+	}
+
+	close(fd);
+
+	return FILE_OPEN_RESULT_OK;
+}
+
+EFileOpenResult FileSystem::ReadFileBinary(const std::string& path, Buffer& outBuffer)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd == -1)
+	{
+		GROOVY_LOG_ERR("FileSystem::ReadFileBinary Unable to open file %s", path.c_str());
+		return FILE_OPEN_RESULT_FILE_NOT_FOUND;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) == -1)
+	{
+		GROOVY_LOG_ERR("FileSystem::ReadFileBinary Unable to read the size of file %s", path.c_str());
+		close(fd);
+		return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+	}
+
+	if (fileStat.st_size)
+	{
+		outBuffer.resize(fileStat.st_size);
+
+		if (!ReadAll(fd, outBuffer.data(), outBuffer.size()))
+		{
+			close(fd);
+			return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+		}
+	}
+
+	close(fd);
+
+	return FILE_OPEN_RESULT_OK;
+}
+
+static int32 GetMadvice(EFileAccessHint hint)
+{
+	switch (hint)
+	{
+		case FILE_ACCESS_HINT_SEQUENTIAL:	return MADV_SEQUENTIAL;
+		case FILE_ACCESS_HINT_RANDOM:		return MADV_RANDOM;
+		default:							return MADV_NORMAL;
+	}
+}
+
+EFileOpenResult FileSystem::MapFileReadOnly(const std::string& path, MappedFile& outFile, EFileAccessHint hint)
+{
+	outFile.Unmap();
+
+	int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd == -1)
+	{
+		GROOVY_LOG_ERR("FileSystem::MapFileReadOnly Unable to open file %s", path.c_str());
+		return FILE_OPEN_RESULT_FILE_NOT_FOUND;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) == -1)
+	{
+		GROOVY_LOG_ERR("FileSystem::MapFileReadOnly Unable to read the size of file %s", path.c_str());
+		close(fd);
+		return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+	}
+
+	if (fileStat.st_size)
+	{
+		// the mapping keeps the file alive, the descriptor isn't needed anymore
+		void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			close(fd);
+			return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+		}
+
+		outFile.mData = (byte*)data;
+		outFile.mSize = (size_t)fileStat.st_size;
+		outFile.Advise(hint);
+	}
+
+	close(fd);
+
+	return FILE_OPEN_RESULT_OK;
+}
+
+void MappedFile::Unmap()
+{
+	if (mData)
+		munmap(mData, mSize);
+
+	mData = nullptr;
+	mSize = 0;
+}
+
+void MappedFile::Advise(EFileAccessHint hint) const
+{
+	if (mData)
+		madvise(mData, mSize, GetMadvice(hint));
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const
+{
+	if (!mData || offset >= mSize)
+		return;
+
+	// madvise wants a page aligned start
+	size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	size_t begin = offset & ~(pageSize - 1);
+	size_t end = offset + size < mSize ? offset + size : mSize;
+	madvise(mData + begin, end - begin, MADV_WILLNEED);
+}
+
+EFileOpenResult FileSystem::WriteFileBinary(const std::string& path, const void* data, size_t sizeBytes)
+{
+	int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1)
+	{
+		GROOVY_LOG_ERR("FileSystem::WriteFileBinary Unable to write file %s", path.c_str());
+		return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+	}
+
+	bool written = WriteAll(fd, data, sizeBytes);
+	close(fd);
+
+	return written ? FILE_OPEN_RESULT_OK : FILE_OPEN_RESULT_UNKNOWN_ERROR;
+}
+
+EFileOpenResult FileSystem::OverwriteFileBinary(const std::string& path, const void* data, size_t sizeBytes, size_t offset)
+{
+	int fd = open(path.c_str(), O_WRONLY);
+	if (fd == -1)
+	{
+		GROOVY_LOG_ERR("FileSystem::OverwriteFileBinary Unable to overwrite file %s", path.c_str());
+		return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+	}
+
+	bool written = lseek(fd, (off_t)offset, SEEK_SET) != -1 && WriteAll(fd, data, sizeBytes);
+	close(fd);
+
+	return written ? FILE_OPEN_RESULT_OK : FILE_OPEN_RESULT_UNKNOWN_ERROR;
+}
+
+EFileOpenResult FileSystem::DeleteFile(const std::string& path)
+{
+	if (unlink(path.c_str()) == 0)
+		return FILE_OPEN_RESULT_OK;
+
+	GROOVY_LOG_ERR("FileSystem::DeleteFile Unable to delete file %s", path.c_str());
+	return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+}
+
+bool FileSystem::FileExists(const std::string& path)
+{
+	return access(path.c_str(), F_OK) == 0;
+}
+
+bool FileSystem::Rename(const std::string& path, const std::string& newPath)
+{
+	return rename(path.c_str(), newPath.c_str()) == 0;
+}
+
+bool FileSystem::Copy(const std::string& path, const std::string& newPath)
+{
+	// same semantics as CopyFileA(..., failIfExists = true)
+	std::error_code error;
+	return std::filesystem::copy_file(path, newPath, std::filesystem::copy_options::none, error);
+}
+
+#endif
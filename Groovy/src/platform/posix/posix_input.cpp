@@ -0,0 +1,71 @@
+#if PLATFORM_LINUX
+
+#include "platform/input.h"
+#include "core/core.h"
+
+// there is no window on linux, input never arrives, every query reports an idle keyboard and mouse
+
+void Input::Init()
+{
+}
+
+void Input::Clear()
+{
+}
+
+void Input::Shutdown()
+{
+}
+
+void Input::OnKeyDown(byte key)
+{
+}
+
+void Input::OnKeyUp(byte key)
+{
+}
+
+void Input::OnMouseMove(int32 x, int32 y)
+{
+}
+
+#if WITH_EDITOR
+
+void Input::Editor_BlockInput(bool block)
+{
+}
+
+bool Input::Editor_IsInputBlocked()
+{
+	return true;
+}
+
+#endif
+
+bool Input::IsKeyDown(EKeyCode key)
+{
+	return false;
+}
+
+bool Input::IsKeyPressed(EKeyCode key)
+{
+	return false;
+}
+
+bool Input::IsKeyReleased(EKeyCode key)
+{
+	return false;
+}
+
+void Input::GetRawMouseDelta(int32* xy)
+{
+	xy[0] = 0;
+	xy[1] = 0;
+}
+
+MouseDelta Input::GetMouseDelta()
+{
+	return { 0.0f, 0.0f };
+}
+
+#endif
@@ -0,0 +1,32 @@
+#if PLATFORM_LINUX
+
+#include "platform/lib.h"
+
+#include <dlfcn.h>
+
+void* Lib::LoadDll(const std::string& path)
+{
+	void* lib = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (!lib)
+	{
+		GROOVY_LOG_ERR("Lib::LoadDll Unable to load dll: %s", dlerror());
+	}
+	return lib;
+}
+
+void Lib::UnloadDll(void* dll)
+{
+	check(dll);
+
+	if (dlclose(dll) != 0)
+	{
+		GROOVY_LOG_ERR("Lib::UnloadDll Unable to unload dll");
+	}
+}
+
+void* Lib::GetSymbol(void* program, const std::string& symbolName)
+{
+	return dlsym(program, symbolName.c_str());
+}
+
+#endif
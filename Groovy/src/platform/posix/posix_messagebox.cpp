@@ -0,0 +1,33 @@
+#if PLATFORM_LINUX
+
+#include "core/core.h"
+#include "platform/messagebox.h"
+
+#include <stdio.h>
+
+// no windowing system on the targets we care about (servers, build agents), everything goes to stderr
+EMessageBoxResponse SysMessageBox::Show(const std::string& caption, const std::string& msg, EMessageBoxType type, EMessageBoxOptions options)
+{
+	const char* severity = "Info";
+	switch (type)
+	{
+		case MESSAGE_BOX_TYPE_WARNING:	severity = "Warning";	break;
+		case MESSAGE_BOX_TYPE_ERROR:	severity = "Error";		break;
+		default:						break;
+	}
+
+	fprintf(stderr, "[%s] %s: %s\n", severity, caption.c_str(), msg.c_str());
+
+	// nobody can answer, pick the affirmative option
+	switch (options)
+	{
+		case MESSAGE_BOX_OPTIONS_YESNO:
+		case MESSAGE_BOX_OPTIONS_YESNOCANCEL:
+			return MESSAGE_BOX_RESPONSE_YES;
+		default:
+			break;
+	}
+	return MESSAGE_BOX_RESPONSE_OK;
+}
+
+#endif
@@ -0,0 +1,21 @@
+#if PLATFORM_LINUX
+
+#include "platform/tick.h"
+
+#include <time.h>
+
+static timespec sStartTime;
+
+void TickTimer::Init()
+{
+	clock_gettime(CLOCK_MONOTONIC, &sStartTime);
+}
+
+double TickTimer::GetTimeSeconds()
+{
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)(now.tv_sec - sStartTime.tv_sec) + (double)(now.tv_nsec - sStartTime.tv_nsec) / 1000000000.0;
+}
+
+#endif
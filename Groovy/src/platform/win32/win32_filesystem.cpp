@@ -106,6 +106,79 @@ EFileOpenResult FileSystem::ReadFileBinary(const std::string& path, Buffer& outB
 	return FILE_OPEN_RESULT_OK;
 }
 
+EFileOpenResult FileSystem::MapFileReadOnly(const std::string& path, MappedFile& outFile, EFileAccessHint hint)
+{
+	outFile.Unmap();
+
+	DWORD flags = FILE_ATTRIBUTE_NORMAL;
+	if (hint == FILE_ACCESS_HINT_SEQUENTIAL)
+		flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+	else if (hint == FILE_ACCESS_HINT_RANDOM)
+		flags |= FILE_FLAG_RANDOM_ACCESS;
+
+	HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		GROOVY_LOG_ERR("FileSystem::MapFileReadOnly Unable to open file %s", path.c_str());
+		return FILE_OPEN_RESULT_FILE_NOT_FOUND;
+	}
+
+	LARGE_INTEGER fileSize = {};
+	GetFileSizeEx(handle, &fileSize);
+
+	if (fileSize.QuadPart)
+	{
+		HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+		// the view keeps both the mapping and the file alive
+		if (mapping)
+			CloseHandle(mapping);
+
+		if (!data)
+		{
+			CloseHandle(handle);
+			return FILE_OPEN_RESULT_UNKNOWN_ERROR;
+		}
+
+		outFile.mData = (byte*)data;
+		outFile.mSize = (size_t)fileSize.QuadPart;
+		outFile.Advise(hint);
+	}
+
+	CloseHandle(handle);
+
+	return FILE_OPEN_RESULT_OK;
+}
+
+void MappedFile::Unmap()
+{
+	if (mData)
+		UnmapViewOfFile(mData);
+
+	mData = nullptr;
+	mSize = 0;
+}
+
+void MappedFile::Advise(EFileAccessHint hint) const
+{
+	// the cache manager already got the hint from the file flags, a sequential read is prefetched upfront
+	if (hint == FILE_ACCESS_HINT_SEQUENTIAL)
+		Prefetch(0, mSize);
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const
+{
+	if (!mData || offset >= mSize)
+		return;
+
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = mData + offset;
+	range.NumberOfBytes = offset + size < mSize ? size : mSize - offset;
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
 EFileOpenResult FileSystem::WriteFileBinary(const std::string& path, const void* data, size_t sizeBytes)
 {
 	HANDLE handle = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
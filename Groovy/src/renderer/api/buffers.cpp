@@ -2,6 +2,8 @@
 #include "renderer_api.h"
 
 #include "d3d11/d3d11_buffers.h"
+#include "null/null_buffers.h"
+#include "software/software_buffers.h"
 
 VertexBuffer* VertexBuffer::Create(size_t size, const void* data, uint32 stride)
 {
@@ -10,6 +12,9 @@ VertexBuffer* VertexBuffer::Create(size_t size, const void* data, uint32 stride)
 #if PLATFORM_WIN32
         case RENDERER_API_D3D11:    return new D3D11VertexBuffer(size, data, stride);
 #endif
+        case RENDERER_API_NULL:     return new NullVertexBuffer(size, data, stride);
+        case RENDERER_API_SOFTWARE: return new SoftwareVertexBuffer(size, data, stride);
+        default:                    break;
     }
     checkslow("?!?");
     return nullptr;
@@ -22,6 +27,9 @@ IndexBuffer* IndexBuffer::Create(size_t size, const void* data)
 #if PLATFORM_WIN32
         case RENDERER_API_D3D11:    return new D3D11IndexBuffer(size, data);
 #endif
+        case RENDERER_API_NULL:     return new NullIndexBuffer(size, data);
+        case RENDERER_API_SOFTWARE: return new SoftwareIndexBuffer(size, data);
+        default:                    break;
     }
     checkslow("?!?");
     return nullptr;
@@ -34,6 +42,9 @@ ConstBuffer* ConstBuffer::Create(size_t size, const void* data)
 #if PLATFORM_WIN32
     case RENDERER_API_D3D11:    return new D3D11ConstBuffer(size, data);
 #endif
+    case RENDERER_API_NULL:     return new NullConstBuffer(size, data);
+    case RENDERER_API_SOFTWARE: return new SoftwareConstBuffer(size, data);
+    default:                    break;
     }
     checkslow("?!?");
     return nullptr;
@@ -83,6 +83,11 @@ void D3D11RendererAPI::DrawIndexed(uint32 vertexOffset, uint32 indexOffset, uint
     d3d11Utils::gContext->DrawIndexed(indexCount, indexOffset, vertexOffset);
 }
 
+void D3D11RendererAPI::DrawIndexedInstanced(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount, uint32 instanceCount)
+{
+    d3d11Utils::gContext->DrawIndexedInstanced(indexCount, instanceCount, indexOffset, vertexOffset, 0);
+}
+
 void D3D11RendererAPI::Present()
 {
     d3d11Utils::gSwapChain->Present(mSpec.vsync, 0);
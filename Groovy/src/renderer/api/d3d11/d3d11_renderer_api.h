@@ -9,6 +9,7 @@ public:
 	virtual ~D3D11RendererAPI();
 
 	virtual void DrawIndexed(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount) override;
+	virtual void DrawIndexedInstanced(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount, uint32 instanceCount) override;
 	virtual void Present() override;
 	virtual void SetFullscreen(bool fullscreen) override;
 	virtual void SetVSync(uint32 syncInterval) override;
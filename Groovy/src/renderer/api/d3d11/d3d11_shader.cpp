@@ -180,19 +180,24 @@ D3D11Shader::D3D11Shader(const void* vertexSrc, size_t vertexSize, const void* p
 	// vertex input layout
 	D3D11_SIGNATURE_PARAMETER_DESC inputDesc;
 	std::vector<D3D11_INPUT_ELEMENT_DESC> layout;
-	layout.resize(vertexDesc.InputParameters);
+	layout.reserve(vertexDesc.InputParameters);
 
 	for (uint32 i = 0; i < vertexDesc.InputParameters; i++)
 	{
 		d3dcheckslow(vertexReflector->GetInputParameterDesc(i, &inputDesc));
 
-		layout[i].SemanticName = inputDesc.SemanticName;
-		layout[i].SemanticIndex = inputDesc.SemanticIndex;
-		layout[i].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-		layout[i].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-		layout[i].Format = GetNativeVarType(inputDesc);
-		layout[i].InputSlot = 0;
-		layout[i].InstanceDataStepRate = 0;
+		// generated by the input assembler (SV_InstanceID, SV_VertexID), not read from the vertex buffer
+		if (inputDesc.SystemValueType != D3D_NAME_UNDEFINED)
+			continue;
+
+		D3D11_INPUT_ELEMENT_DESC& element = layout.emplace_back();
+		element.SemanticName = inputDesc.SemanticName;
+		element.SemanticIndex = inputDesc.SemanticIndex;
+		element.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+		element.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+		element.Format = GetNativeVarType(inputDesc);
+		element.InputSlot = 0;
+		element.InstanceDataStepRate = 0;
 	}
 
 	d3dcheckslow(d3d11Utils::gDevice->CreateInputLayout(layout.data(), (UINT)layout.size(), vertexBytecode->GetBufferPointer(), vertexBytecode->GetBufferSize(), &mInputLayout));
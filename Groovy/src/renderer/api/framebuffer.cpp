@@ -2,6 +2,8 @@
 #include "renderer_api.h"
 
 #include "d3d11/d3d11_framebuffer.h"
+#include "null/null_framebuffer.h"
+#include "software/software_framebuffer.h"
 
 FrameBuffer* FrameBuffer::Create(const FrameBufferSpec& specs)
 {
@@ -10,6 +12,9 @@ FrameBuffer* FrameBuffer::Create(const FrameBufferSpec& specs)
 #if PLATFORM_WIN32
         case RENDERER_API_D3D11:    return new D3D11FrameBuffer(specs);
 #endif
+        case RENDERER_API_NULL:     return new NullFrameBuffer(specs);
+        case RENDERER_API_SOFTWARE: return new SoftwareFrameBuffer(specs);
+        default:                    break;
     }
     checkslow("?!?");
     return nullptr;
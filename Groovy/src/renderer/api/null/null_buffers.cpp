@@ -0,0 +1,79 @@
+#include "null_buffers.h"
+#include "null_renderer_api.h"
+
+// initial data counts as an upload, like it would on a real gpu
+static void InitBufferData(Buffer& buffer, size_t size, const void* data)
+{
+	buffer.resize(size);
+
+	if (data)
+	{
+		memcpy(buffer.data(), data, size);
+		NullRendererAPI::__internal_RecordUpload(size);
+	}
+	else if (size)
+	{
+		memset(buffer.data(), 0, size);
+	}
+}
+
+NullVertexBuffer::NullVertexBuffer(size_t size, const void* data, uint32 stride)
+	: mStride(stride)
+{
+	InitBufferData(mData, size, data);
+}
+
+NullVertexBuffer::~NullVertexBuffer()
+{
+	NullRendererAPI::__internal_Unbind(this);
+}
+
+void NullVertexBuffer::Bind()
+{
+	NullRendererAPI::__internal_RecordBind(NullRendererAPI::sBoundVertexBuffer, this);
+}
+
+NullIndexBuffer::NullIndexBuffer(size_t size, const void* data)
+{
+	InitBufferData(mData, size, data);
+}
+
+NullIndexBuffer::~NullIndexBuffer()
+{
+	NullRendererAPI::__internal_Unbind(this);
+}
+
+void NullIndexBuffer::Bind()
+{
+	NullRendererAPI::__internal_RecordBind(NullRendererAPI::sBoundIndexBuffer, this);
+}
+
+NullConstBuffer::NullConstBuffer(size_t size, const void* data)
+{
+	InitBufferData(mData, size, data);
+}
+
+NullConstBuffer::~NullConstBuffer()
+{
+	NullRendererAPI::__internal_Unbind(this);
+}
+
+void NullConstBuffer::Overwrite(void* data, size_t size)
+{
+	check(size <= mData.size());
+
+	memcpy(mData.data(), data, size);
+	NullRendererAPI::__internal_RecordUpload(size);
+}
+
+void NullConstBuffer::BindForVertexShader(uint32 slot)
+{
+	check(slot < NULL_RENDERER_MAX_BIND_SLOTS);
+	NullRendererAPI::__internal_RecordBind(NullRendererAPI::sBoundVertexConstBuffers[slot], this);
+}
+
+void NullConstBuffer::BindForPixelShader(uint32 slot)
+{
+	check(slot < NULL_RENDERER_MAX_BIND_SLOTS);
+	NullRendererAPI::__internal_RecordBind(NullRendererAPI::sBoundPixelConstBuffers[slot], this);
+}
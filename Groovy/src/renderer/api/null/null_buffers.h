@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../buffers.h"
+
+class NullVertexBuffer : public VertexBuffer
+{
+public:
+	NullVertexBuffer(size_t size, const void* data, uint32 stride);
+	virtual ~NullVertexBuffer();
+
+	virtual void Bind() override;
+	virtual size_t GetSize() const override { return mData.size(); }
+
+	const Buffer& GetData() const { return mData; }
+	uint32 GetStride() const { return mStride; }
+
+private:
+	Buffer mData;
+	uint32 mStride;
+};
+
+class NullIndexBuffer : public IndexBuffer
+{
+public:
+	NullIndexBuffer(size_t size, const void* data);
+	virtual ~NullIndexBuffer();
+
+	virtual void Bind() override;
+	virtual size_t GetSize() const override { return mData.size(); }
+
+	const Buffer& GetData() const { return mData; }
+
+private:
+	Buffer mData;
+};
+
+class NullConstBuffer : public ConstBuffer
+{
+public:
+	NullConstBuffer(size_t size, const void* data);
+	virtual ~NullConstBuffer();
+
+	virtual size_t GetSize() const override { return mData.size(); }
+	virtual void Overwrite(void* data, size_t size) override;
+
+	virtual void BindForVertexShader(uint32 slot) override;
+	virtual void BindForPixelShader(uint32 slot) override;
+
+	const Buffer& GetData() const { return mData; }
+
+private:
+	Buffer mData;
+};
@@ -0,0 +1,36 @@
+#include "null_framebuffer.h"
+#include "null_renderer_api.h"
+
+NullFrameBuffer::NullFrameBuffer(const FrameBufferSpec& spec)
+	: mSpec(spec)
+{
+}
+
+NullFrameBuffer::~NullFrameBuffer()
+{
+	NullRendererAPI::__internal_Unbind(this);
+}
+
+void NullFrameBuffer::Bind()
+{
+	NullRendererAPI::__internal_RecordBind(NullRendererAPI::sBoundFrameBuffer, this);
+}
+
+void NullFrameBuffer::Resize(uint32 width, uint32 height)
+{
+	mSpec.width = width;
+	mSpec.height = height;
+}
+
+void NullFrameBuffer::ClearColorAttachment(uint32 colorIndex, ClearColor clearColor)
+{
+	check(colorIndex < mSpec.colorAttachments.size());
+}
+
+void NullFrameBuffer::ClearColorAttachments(ClearColor clearColor)
+{
+}
+
+void NullFrameBuffer::ClearDepthAttachment()
+{
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../framebuffer.h"
+
+class NullFrameBuffer : public FrameBuffer
+{
+public:
+	NullFrameBuffer(const FrameBufferSpec& spec);
+	virtual ~NullFrameBuffer();
+
+	virtual const FrameBufferSpec& GetSpecs() const override { return mSpec; }
+	virtual void Bind() override;
+	virtual void Resize(uint32 width, uint32 height) override;
+	virtual void ClearColorAttachment(uint32 colorIndex, ClearColor clearColor) override;
+	virtual void ClearColorAttachments(ClearColor clearColor) override;
+	virtual void ClearDepthAttachment() override;
+	virtual void* GetRendererID(uint32 colorIndex) const override { return nullptr; }
+
+private:
+	FrameBufferSpec mSpec;
+};
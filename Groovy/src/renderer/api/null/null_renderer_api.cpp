@@ -0,0 +1,147 @@
+#include "null_renderer_api.h"
+
+const void* NullRendererAPI::sBoundShader = nullptr;
+const void* NullRendererAPI::sBoundVertexBuffer = nullptr;
+const void* NullRendererAPI::sBoundIndexBuffer = nullptr;
+const void* NullRendererAPI::sBoundFrameBuffer = nullptr;
+const void* NullRendererAPI::sBoundVertexConstBuffers[NULL_RENDERER_MAX_BIND_SLOTS] = {};
+const void* NullRendererAPI::sBoundPixelConstBuffers[NULL_RENDERER_MAX_BIND_SLOTS] = {};
+const void* NullRendererAPI::sBoundTextures[NULL_RENDERER_MAX_BIND_SLOTS] = {};
+
+RendererFrameStats NullRendererAPI::sFrameStats = {};
+RendererFrameStats NullRendererAPI::sLastFrameStats = {};
+RendererFrameStats NullRendererAPI::sTotalStats = {};
+uint64 NullRendererAPI::sFramesCount = 0;
+
+static void ClearBindings()
+{
+	NullRendererAPI::sBoundShader = nullptr;
+	NullRendererAPI::sBoundVertexBuffer = nullptr;
+	NullRendererAPI::sBoundIndexBuffer = nullptr;
+	NullRendererAPI::sBoundFrameBuffer = nullptr;
+
+	for (uint32 i = 0; i < NULL_RENDERER_MAX_BIND_SLOTS; i++)
+	{
+		NullRendererAPI::sBoundVertexConstBuffers[i] = nullptr;
+		NullRendererAPI::sBoundPixelConstBuffers[i] = nullptr;
+		NullRendererAPI::sBoundTextures[i] = nullptr;
+	}
+}
+
+NullRendererAPI::NullRendererAPI(RendererAPISpec spec)
+	: mSpec(spec)
+{
+	mRasterizerState.fillMode = RASTERIZER_FILL_MODE_SOLID;
+	mRasterizerState.cullMode = RASTERIZER_CULL_MODE_BACK;
+
+	ClearBindings();
+	ResetStats();
+}
+
+NullRendererAPI::~NullRendererAPI()
+{
+	ClearBindings();
+}
+
+void NullRendererAPI::DrawIndexed(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount)
+{
+	checkslowf(sBoundVertexBuffer && sBoundIndexBuffer, "Draw call without vertex or index buffer bound");
+
+	sFrameStats.drawCalls++;
+	sFrameStats.instances++;
+	sFrameStats.indices += indexCount;
+}
+
+void NullRendererAPI::DrawIndexedInstanced(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount, uint32 instanceCount)
+{
+	checkslowf(sBoundVertexBuffer && sBoundIndexBuffer, "Draw call without vertex or index buffer bound");
+
+	sFrameStats.drawCalls++;
+	sFrameStats.instances += instanceCount;
+	sFrameStats.indices += (uint64)indexCount * instanceCount;
+}
+
+void NullRendererAPI::Present()
+{
+	sLastFrameStats = sFrameStats;
+
+	sTotalStats.drawCalls += sFrameStats.drawCalls;
+	sTotalStats.instances += sFrameStats.instances;
+	sTotalStats.indices += sFrameStats.indices;
+	sTotalStats.stateChanges += sFrameStats.stateChanges;
+	sTotalStats.redundantBinds += sFrameStats.redundantBinds;
+	sTotalStats.bufferUploads += sFrameStats.bufferUploads;
+	sTotalStats.bytesUploaded += sFrameStats.bytesUploaded;
+	sFramesCount++;
+
+	sFrameStats = {};
+}
+
+void NullRendererAPI::SetFullscreen(bool fullscreen)
+{
+}
+
+void NullRendererAPI::SetVSync(uint32 syncInterval)
+{
+	mSpec.vsync = syncInterval;
+}
+
+void NullRendererAPI::SetRasterizerState(RasterizerState newState)
+{
+	if (newState.fillMode == mRasterizerState.fillMode && newState.cullMode == mRasterizerState.cullMode)
+	{
+		sFrameStats.redundantBinds++;
+		return;
+	}
+
+	mRasterizerState = newState;
+	sFrameStats.stateChanges++;
+}
+
+void NullRendererAPI::ResetStats()
+{
+	sFrameStats = {};
+	sLastFrameStats = {};
+	sTotalStats = {};
+	sFramesCount = 0;
+}
+
+void NullRendererAPI::__internal_RecordBind(const void*& boundSlot, const void* resource)
+{
+	if (boundSlot == resource)
+	{
+		sFrameStats.redundantBinds++;
+		return;
+	}
+
+	boundSlot = resource;
+	sFrameStats.stateChanges++;
+}
+
+void NullRendererAPI::__internal_RecordUpload(size_t size)
+{
+	sFrameStats.bufferUploads++;
+	sFrameStats.bytesUploaded += size;
+}
+
+void NullRendererAPI::__internal_Unbind(const void* resource)
+{
+	if (sBoundShader == resource)
+		sBoundShader = nullptr;
+	if (sBoundVertexBuffer == resource)
+		sBoundVertexBuffer = nullptr;
+	if (sBoundIndexBuffer == resource)
+		sBoundIndexBuffer = nullptr;
+	if (sBoundFrameBuffer == resource)
+		sBoundFrameBuffer = nullptr;
+
+	for (uint32 i = 0; i < NULL_RENDERER_MAX_BIND_SLOTS; i++)
+	{
+		if (sBoundVertexConstBuffers[i] == resource)
+			sBoundVertexConstBuffers[i] = nullptr;
+		if (sBoundPixelConstBuffers[i] == resource)
+			sBoundPixelConstBuffers[i] = nullptr;
+		if (sBoundTextures[i] == resource)
+			sBoundTextures[i] = nullptr;
+	}
+}
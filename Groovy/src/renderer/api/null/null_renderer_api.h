@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../renderer_api.h"
+
+#define NULL_RENDERER_MAX_BIND_SLOTS 16
+
+struct RendererFrameStats
+{
+	uint32 drawCalls;
+	// instances of every draw call, a non instanced draw is one instance
+	uint32 instances;
+	// indices of every instance
+	uint64 indices;
+	// binds that actually changed something (shader, buffers, textures, render target, rasterizer)
+	uint32 stateChanges;
+	// binds of something that was already bound
+	uint32 redundantBinds;
+	uint32 bufferUploads;
+	uint64 bytesUploaded;
+};
+
+/*
+	Renderer api with no gpu behind it, used by headless runs and cpu benchmarks.
+	Resources keep a cpu copy of their data, every draw, bind and upload is counted.
+	Stats are accumulated per frame and rolled over in Present.
+*/
+class CORE_API NullRendererAPI : public RendererAPI
+{
+public:
+	NullRendererAPI(RendererAPISpec spec);
+	virtual ~NullRendererAPI();
+
+	virtual void DrawIndexed(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount) override;
+	virtual void DrawIndexedInstanced(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount, uint32 instanceCount) override;
+	virtual void Present() override;
+	virtual void SetFullscreen(bool fullscreen) override;
+	virtual void SetVSync(uint32 syncInterval) override;
+	virtual RendererAPISpec GetSpec() const override { return mSpec; }
+	virtual RasterizerState GetRasterizerState() const override { return mRasterizerState; }
+	virtual void SetRasterizerState(RasterizerState newState) override;
+
+	// stats of the last presented frame
+	static const RendererFrameStats& GetLastFrameStats() { return sLastFrameStats; }
+	// stats accumulated since the last reset, frames are counted in Present
+	static const RendererFrameStats& GetTotalStats() { return sTotalStats; }
+	static uint64 GetFramesCount() { return sFramesCount; }
+	static void ResetStats();
+
+	// for internal use, called by the null resources
+	static void __internal_RecordBind(const void*& boundSlot, const void* resource);
+	static void __internal_RecordUpload(size_t size);
+	// a destroyed resource must not be mistaken for a new one allocated at the same address
+	static void __internal_Unbind(const void* resource);
+
+	// currently bound resources, compared against to detect redundant binds
+	static const void* sBoundShader;
+	static const void* sBoundVertexBuffer;
+	static const void* sBoundIndexBuffer;
+	static const void* sBoundFrameBuffer;
+	static const void* sBoundVertexConstBuffers[NULL_RENDERER_MAX_BIND_SLOTS];
+	static const void* sBoundPixelConstBuffers[NULL_RENDERER_MAX_BIND_SLOTS];
+	static const void* sBoundTextures[NULL_RENDERER_MAX_BIND_SLOTS];
+
+private:
+	RendererAPISpec mSpec;
+	RasterizerState mRasterizerState;
+
+	static RendererFrameStats sFrameStats;
+	static RendererFrameStats sLastFrameStats;
+	static RendererFrameStats sTotalStats;
+	static uint64 sFramesCount;
+};
@@ -0,0 +1,32 @@
+#include "null_shader.h"
+#include "null_renderer_api.h"
+
+NullShader::NullShader(const void* vertexSrc, size_t vertexSize, const void* pixelSrc, size_t pixelSize)
+	: mUUID(0)
+{
+}
+
+NullShader::~NullShader()
+{
+	NullRendererAPI::__internal_Unbind(this);
+}
+
+void NullShader::Bind()
+{
+	NullRendererAPI::__internal_RecordBind(NullRendererAPI::sBoundShader, this);
+}
+
+uint32 NullShader::GetVertexConstBufferIndex(const std::string& bufferName)
+{
+	return ~((uint32)0);
+}
+
+uint32 NullShader::GetPixelConstBufferIndex(const std::string& bufferName)
+{
+	return ~((uint32)0);
+}
+
+void NullShader::OverwritePixelConstBuffer(uint32 index, void* data)
+{
+	checkslowf(index < mPixelConstBuffersDesc.size(), "Pixel const buffer index out of range");
+}
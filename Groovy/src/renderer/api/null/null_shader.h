@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../shader.h"
+
+// no shader compiler here, the shader exposes no const buffers and no resources
+class NullShader : public Shader
+{
+public:
+	NullShader(const void* vertexSrc, size_t vertexSize, const void* pixelSrc, size_t pixelSize);
+	virtual ~NullShader();
+
+	virtual void __internal_SetUUID(AssetUUID uuid) override { mUUID = uuid; }
+	virtual AssetUUID GetUUID() const override { return mUUID; }
+
+	virtual void Bind() override;
+
+	virtual const std::vector<ConstBufferDesc>& GetVertexConstBuffersDesc() const override { return mVertexConstBuffersDesc; }
+	virtual const std::vector<ConstBufferDesc>& GetPixelConstBuffersDesc() const override { return mPixelConstBuffersDesc; }
+	virtual const std::vector<ShaderResTexture>& GetPixelTexturesRes() const override { return mResTextures; }
+
+	virtual uint32 GetVertexConstBufferIndex(const std::string& bufferName) override;
+	virtual uint32 GetPixelConstBufferIndex(const std::string& bufferName) override;
+
+	virtual void OverwritePixelConstBuffer(uint32 index, void* data) override;
+
+private:
+	std::vector<ConstBufferDesc> mVertexConstBuffersDesc;
+	std::vector<ConstBufferDesc> mPixelConstBuffersDesc;
+	std::vector<ShaderResTexture> mResTextures;
+
+	AssetUUID mUUID;
+};
@@ -0,0 +1,29 @@
+#include "null_texture.h"
+#include "null_renderer_api.h"
+
+NullTexture::NullTexture(TextureSpec specs, const void* data, size_t size)
+	: mSpecs(specs), mUUID(0)
+{
+	if (data && size)
+		SetData((void*)data, size);
+}
+
+NullTexture::~NullTexture()
+{
+	NullRendererAPI::__internal_Unbind(this);
+}
+
+void NullTexture::Bind(uint32 slot)
+{
+	check(slot < NULL_RENDERER_MAX_BIND_SLOTS);
+	NullRendererAPI::__internal_RecordBind(NullRendererAPI::sBoundTextures[slot], this);
+}
+
+void NullTexture::SetData(void* data, size_t size)
+{
+	if (mData.size() != size)
+		mData.resize(size);
+
+	memcpy(mData.data(), data, size);
+	NullRendererAPI::__internal_RecordUpload(size);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../texture.h"
+
+class NullTexture : public Texture
+{
+public:
+	NullTexture(TextureSpec specs, const void* data, size_t size);
+	virtual ~NullTexture();
+
+	virtual void __internal_SetUUID(AssetUUID uuid) override { mUUID = uuid; }
+	virtual AssetUUID GetUUID() const override { return mUUID; }
+
+	virtual void Bind(uint32 slot) override;
+	virtual void* GetRendererID() const override { return nullptr; }
+	virtual void SetData(void* data, size_t size) override;
+	virtual TextureSpec GetSpecs() const override { return mSpecs; }
+
+	const Buffer& GetData() const { return mData; }
+
+private:
+	TextureSpec mSpecs;
+	Buffer mData;
+
+	AssetUUID mUUID;
+};
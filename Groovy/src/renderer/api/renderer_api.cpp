@@ -2,6 +2,8 @@
 #include "platform/window.h"
 
 #include "d3d11/d3d11_renderer_api.h"
+#include "null/null_renderer_api.h"
+#include "software/software_renderer_api.h"
 
 RendererAPI* RendererAPI::sInstance = nullptr;
 ERendererAPI RendererAPI::sSelectedAPI = RENDERER_API_NONE;
@@ -18,6 +20,20 @@ void RendererAPI::Create(ERendererAPI api, RendererAPISpec spec, Window* wnd)
 		return;
 	}
 #endif
+	case RENDERER_API_NULL:
+	{
+		sInstance = new NullRendererAPI(spec);
+		sSelectedAPI = RENDERER_API_NULL;
+		return;
+	}
+	case RENDERER_API_SOFTWARE:
+	{
+		sInstance = new SoftwareRendererAPI(spec);
+		sSelectedAPI = RENDERER_API_SOFTWARE;
+		return;
+	}
+	default:
+		break;
 	}
 	checkslowf(0, "No supported renderer API selected!");
 }
@@ -25,4 +41,6 @@ void RendererAPI::Create(ERendererAPI api, RendererAPISpec spec, Window* wnd)
 void RendererAPI::Destroy()
 {
 	delete sInstance;
+	sInstance = nullptr;
+	sSelectedAPI = RENDERER_API_NONE;
 }
@@ -5,7 +5,9 @@
 enum ERendererAPI
 {
 	RENDERER_API_NONE,
-	RENDERER_API_D3D11
+	RENDERER_API_D3D11,
+	RENDERER_API_NULL,
+	RENDERER_API_SOFTWARE
 };
 
 enum ERasterizerFillMode
@@ -39,6 +41,8 @@ public:
 	virtual ~RendererAPI() = default;
 
 	virtual void DrawIndexed(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount) = 0;
+	// SV_InstanceID goes from 0 to instanceCount - 1
+	virtual void DrawIndexedInstanced(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount, uint32 instanceCount) = 0;
 	virtual void Present() = 0;
 	virtual void SetFullscreen(bool fullscreen) = 0;
 	virtual void SetVSync(uint32 syncInterval) = 0;
@@ -2,6 +2,8 @@
 #include "renderer_api.h"
 
 #include "d3d11/d3d11_shader.h"
+#include "null/null_shader.h"
+#include "software/software_shader.h"
 
 Shader* Shader::Create(const void* vertexSrc, size_t vertexSize, const void* pixelSrc, size_t pixelSize)
 {
@@ -10,6 +12,9 @@ Shader* Shader::Create(const void* vertexSrc, size_t vertexSize, const void* pix
 #if PLATFORM_WIN32
         case RENDERER_API_D3D11:    return new D3D11Shader(vertexSrc, vertexSize, pixelSrc, pixelSize);
 #endif
+        case RENDERER_API_NULL:     return new NullShader(vertexSrc, vertexSize, pixelSrc, pixelSize);
+        case RENDERER_API_SOFTWARE: return new SoftwareShader(vertexSrc, vertexSize, pixelSrc, pixelSize);
+        default:                    break;
     }
     checkslow("?!?");
     return nullptr;
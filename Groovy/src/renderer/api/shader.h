@@ -40,6 +40,8 @@ public:
 
 	virtual bool IsLoaded() const override { return true; }
 	virtual void Load() override {}
+	// destroyed by the asset manager instead
+	virtual void Unload() override {}
 	virtual void Save() override {}
 
 	virtual void Serialize(DynamicBuffer& fileData) const override {}
@@ -0,0 +1,73 @@
+#include "software_buffers.h"
+#include "software_renderer_api.h"
+
+static void InitBufferData(Buffer& buffer, size_t size, const void* data)
+{
+	buffer.resize(size);
+
+	if (data)
+		memcpy(buffer.data(), data, size);
+	else if (size)
+		memset(buffer.data(), 0, size);
+}
+
+// draws read vertices, indices and const buffers when they are submitted, nothing to flush here
+
+SoftwareVertexBuffer::SoftwareVertexBuffer(size_t size, const void* data, uint32 stride)
+	: mStride(stride)
+{
+	InitBufferData(mData, size, data);
+}
+
+SoftwareVertexBuffer::~SoftwareVertexBuffer()
+{
+	SoftwareRendererAPI::__internal_Unbind(this);
+}
+
+void SoftwareVertexBuffer::Bind()
+{
+	SoftwareRendererAPI::sBoundVertexBuffer = this;
+}
+
+SoftwareIndexBuffer::SoftwareIndexBuffer(size_t size, const void* data)
+{
+	InitBufferData(mData, size, data);
+}
+
+SoftwareIndexBuffer::~SoftwareIndexBuffer()
+{
+	SoftwareRendererAPI::__internal_Unbind(this);
+}
+
+void SoftwareIndexBuffer::Bind()
+{
+	SoftwareRendererAPI::sBoundIndexBuffer = this;
+}
+
+SoftwareConstBuffer::SoftwareConstBuffer(size_t size, const void* data)
+{
+	InitBufferData(mData, size, data);
+}
+
+SoftwareConstBuffer::~SoftwareConstBuffer()
+{
+	SoftwareRendererAPI::__internal_Unbind(this);
+}
+
+void SoftwareConstBuffer::Overwrite(void* data, size_t size)
+{
+	check(size <= mData.size());
+	memcpy(mData.data(), data, size);
+}
+
+void SoftwareConstBuffer::BindForVertexShader(uint32 slot)
+{
+	check(slot < SOFTWARE_RENDERER_MAX_BIND_SLOTS);
+	SoftwareRendererAPI::sBoundVertexConstBuffers[slot] = this;
+}
+
+void SoftwareConstBuffer::BindForPixelShader(uint32 slot)
+{
+	check(slot < SOFTWARE_RENDERER_MAX_BIND_SLOTS);
+	SoftwareRendererAPI::sBoundPixelConstBuffers[slot] = this;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../buffers.h"
+
+class SoftwareVertexBuffer : public VertexBuffer
+{
+public:
+	SoftwareVertexBuffer(size_t size, const void* data, uint32 stride);
+	virtual ~SoftwareVertexBuffer();
+
+	virtual void Bind() override;
+	virtual size_t GetSize() const override { return mData.size(); }
+
+	const Buffer& GetData() const { return mData; }
+	uint32 GetStride() const { return mStride; }
+
+private:
+	Buffer mData;
+	uint32 mStride;
+};
+
+class SoftwareIndexBuffer : public IndexBuffer
+{
+public:
+	SoftwareIndexBuffer(size_t size, const void* data);
+	virtual ~SoftwareIndexBuffer();
+
+	virtual void Bind() override;
+	virtual size_t GetSize() const override { return mData.size(); }
+
+	const Buffer& GetData() const { return mData; }
+
+private:
+	Buffer mData;
+};
+
+class SoftwareConstBuffer : public ConstBuffer
+{
+public:
+	SoftwareConstBuffer(size_t size, const void* data);
+	virtual ~SoftwareConstBuffer();
+
+	virtual size_t GetSize() const override { return mData.size(); }
+	virtual void Overwrite(void* data, size_t size) override;
+
+	virtual void BindForVertexShader(uint32 slot) override;
+	virtual void BindForPixelShader(uint32 slot) override;
+
+	const Buffer& GetData() const { return mData; }
+
+private:
+	Buffer mData;
+};
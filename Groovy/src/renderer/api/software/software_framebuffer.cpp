@@ -0,0 +1,158 @@
+#include "software_framebuffer.h"
+#include "software_renderer_api.h"
+
+static uint32 GetBytesPerPixel(EColorFormat format)
+{
+	switch (format)
+	{
+		case COLOR_FORMAT_R8G8B8A8_UNORM:		return 4;
+		case COLOR_FORMAT_R8G8B8_UNORM:			return 3;
+		case COLOR_FORMAT_R32G32B32A32_FLOAT:	return 16;
+		case COLOR_FORMAT_R32G32B32_FLOAT:		return 12;
+		case COLOR_FORMAT_R32G32_FLOAT:			return 8;
+		case COLOR_FORMAT_R32_FLOAT:			return 4;
+		case COLOR_FORMAT_R32_UINT:				return 4;
+		case COLOR_FORMAT_D24S8_UNORM_UINT:		return 4;
+	}
+	checkf(0, "Unknown EColorFormat value");
+	return 4;
+}
+
+static uint8 ToUnorm8(float f)
+{
+	f = f < 0.0f ? 0.0f : (f > 1.0f ? 1.0f : f);
+	return (uint8)(f * 255.0f + 0.5f);
+}
+
+SoftwareFrameBuffer::SoftwareFrameBuffer(const FrameBufferSpec& spec)
+	: mSpec(spec), mPitch(0)
+{
+	checkslow(spec.colorAttachments.size());
+
+	mColorAttachments.resize(spec.colorAttachments.size());
+	Create();
+}
+
+SoftwareFrameBuffer::~SoftwareFrameBuffer()
+{
+	SoftwareRendererAPI::__internal_FlushPendingWork();
+	SoftwareRendererAPI::__internal_Unbind(this);
+}
+
+void SoftwareFrameBuffer::Bind()
+{
+	SoftwareRendererAPI::sBoundFrameBuffer = this;
+}
+
+void SoftwareFrameBuffer::Resize(uint32 width, uint32 height)
+{
+	SoftwareRendererAPI::__internal_FlushPendingWork();
+
+	mSpec.width = width;
+	mSpec.height = height;
+	Create();
+}
+
+void SoftwareFrameBuffer::ClearColorAttachment(uint32 colorIndex, ClearColor clearColor)
+{
+	check(colorIndex < mColorAttachments.size());
+
+	SoftwareRendererAPI::__internal_FlushPendingWork();
+
+	Buffer& attachment = mColorAttachments[colorIndex];
+	uint32 bytesPerPixel = GetBytesPerPixel(mSpec.colorAttachments[colorIndex]);
+
+	byte pixel[16];
+	switch (mSpec.colorAttachments[colorIndex])
+	{
+		case COLOR_FORMAT_R8G8B8A8_UNORM:
+		case COLOR_FORMAT_R8G8B8_UNORM:
+			pixel[0] = ToUnorm8(clearColor.x);
+			pixel[1] = ToUnorm8(clearColor.y);
+			pixel[2] = ToUnorm8(clearColor.z);
+			pixel[3] = ToUnorm8(clearColor.w);
+			break;
+
+		case COLOR_FORMAT_R32_UINT:
+		{
+			uint32 value = (uint32)clearColor.x;
+			memcpy(pixel, &value, 4);
+			break;
+		}
+
+		default:
+			memcpy(pixel, &clearColor, bytesPerPixel);
+			break;
+	}
+
+	byte* data = attachment.data();
+	size_t pixelCount = attachment.size() / bytesPerPixel;
+
+	if (bytesPerPixel == 4)
+	{
+		uint32 value;
+		memcpy(&value, pixel, 4);
+		std::fill((uint32*)data, (uint32*)data + pixelCount, value);
+	}
+	else
+	{
+		for (size_t i = 0; i < pixelCount; i++)
+			memcpy(data + i * bytesPerPixel, pixel, bytesPerPixel);
+	}
+}
+
+void SoftwareFrameBuffer::ClearColorAttachments(ClearColor clearColor)
+{
+	for (uint32 i = 0; i < mColorAttachments.size(); i++)
+		ClearColorAttachment(i, clearColor);
+}
+
+void SoftwareFrameBuffer::ClearDepthAttachment()
+{
+	check(mSpec.hasDepthAttachment);
+
+	SoftwareRendererAPI::__internal_FlushPendingWork();
+
+	float* depth = (float*)mDepthAttachment.data();
+	std::fill(depth, depth + (size_t)mPitch * mSpec.height, 1.0f);
+}
+
+void* SoftwareFrameBuffer::GetRendererID(uint32 colorIndex) const
+{
+	check(colorIndex < mColorAttachments.size());
+
+	SoftwareRendererAPI::__internal_FlushPendingWork();
+	return (void*)mColorAttachments[colorIndex].data();
+}
+
+SoftwareRenderTarget SoftwareFrameBuffer::GetRenderTarget() const
+{
+	SoftwareRenderTarget target = {};
+	target.width = mSpec.width;
+	target.height = mSpec.height;
+	target.pitch = mPitch;
+	target.color = mSpec.colorAttachments[0] == COLOR_FORMAT_R8G8B8A8_UNORM ? (uint32*)mColorAttachments[0].data() : nullptr;
+	target.depth = mSpec.hasDepthAttachment ? (float*)mDepthAttachment.data() : nullptr;
+	return target;
+}
+
+void SoftwareFrameBuffer::Create()
+{
+	mPitch = (mSpec.width + SOFTWARE_RASTERIZER_ROW_ALIGNMENT - 1) & ~(SOFTWARE_RASTERIZER_ROW_ALIGNMENT - 1);
+	size_t pixelCount = (size_t)mPitch * mSpec.height;
+
+	for (uint32 i = 0; i < mColorAttachments.size(); i++)
+	{
+		size_t size = pixelCount * GetBytesPerPixel(mSpec.colorAttachments[i]);
+		mColorAttachments[i].resize(size);
+		if (size)
+			memset(mColorAttachments[i].data(), 0, size);
+	}
+
+	if (mSpec.hasDepthAttachment)
+	{
+		mDepthAttachment.resize(pixelCount * sizeof(float));
+		if (pixelCount)
+			std::fill((float*)mDepthAttachment.data(), (float*)mDepthAttachment.data() + pixelCount, 1.0f);
+	}
+}
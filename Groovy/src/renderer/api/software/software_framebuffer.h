@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../framebuffer.h"
+#include "software_rasterizer.h"
+
+// attachments live in memory, rows are padded to SOFTWARE_RASTERIZER_ROW_ALIGNMENT pixels
+class SoftwareFrameBuffer : public FrameBuffer
+{
+public:
+	SoftwareFrameBuffer(const FrameBufferSpec& spec);
+	virtual ~SoftwareFrameBuffer();
+
+	virtual const FrameBufferSpec& GetSpecs() const override { return mSpec; }
+	virtual void Bind() override;
+	virtual void Resize(uint32 width, uint32 height) override;
+	virtual void ClearColorAttachment(uint32 colorIndex, ClearColor clearColor) override;
+	virtual void ClearColorAttachments(ClearColor clearColor) override;
+	virtual void ClearDepthAttachment() override;
+	// pixels of the attachment, pending draws are flushed first
+	virtual void* GetRendererID(uint32 colorIndex) const override;
+
+	// pixels per row
+	uint32 GetPitch() const { return mPitch; }
+
+	// draws land in the first color attachment (if RGBA8) and in the depth attachment
+	SoftwareRenderTarget GetRenderTarget() const;
+
+private:
+	void Create();
+
+private:
+	FrameBufferSpec mSpec;
+	uint32 mPitch;
+	std::vector<Buffer> mColorAttachments;
+	Buffer mDepthAttachment;
+};
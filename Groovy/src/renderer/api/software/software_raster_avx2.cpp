@@ -0,0 +1,61 @@
+#include "software_raster_internal.h"
+
+// built with avx2 code generation (see Groovy/premake5.lua), only called after checking the cpu supports it
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#define SR_LANES 8
+#define SR_KERNEL_NAME RasterizeTile_AVX2
+
+typedef __m256 vfloat;
+typedef __m256 vmask;
+typedef __m256i vint;
+
+static inline vfloat vSet1(float f) { return _mm256_set1_ps(f); }
+static inline vfloat vLaneOffsets() { return _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f); }
+static inline vfloat vLoad(const float* p) { return _mm256_loadu_ps(p); }
+static inline void vStore(float* p, vfloat v) { _mm256_storeu_ps(p, v); }
+static inline vfloat vAdd(vfloat a, vfloat b) { return _mm256_add_ps(a, b); }
+static inline vfloat vSub(vfloat a, vfloat b) { return _mm256_sub_ps(a, b); }
+static inline vfloat vFloor(vfloat v) { return _mm256_floor_ps(v); }
+static inline vfloat vMul(vfloat a, vfloat b) { return _mm256_mul_ps(a, b); }
+static inline vfloat vDiv(vfloat a, vfloat b) { return _mm256_div_ps(a, b); }
+static inline vfloat vMin(vfloat a, vfloat b) { return _mm256_min_ps(a, b); }
+static inline vfloat vMax(vfloat a, vfloat b) { return _mm256_max_ps(a, b); }
+
+static inline vmask vCmpGe(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+static inline vmask vCmpLe(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+static inline vmask vCmpLt(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+static inline vmask vMaskAnd(vmask a, vmask b) { return _mm256_and_ps(a, b); }
+static inline uint32 vMaskBits(vmask m) { return (uint32)_mm256_movemask_ps(m); }
+static inline vfloat vSelect(vmask m, vfloat a, vfloat b) { return _mm256_blendv_ps(b, a, m); }
+
+static inline vint vToInt(vfloat v) { return _mm256_cvtps_epi32(v); }
+static inline vint vIntOr(vint a, vint b) { return _mm256_or_si256(a, b); }
+template<int Shift> static inline vint vIntShl(vint v) { return _mm256_slli_epi32(v, Shift); }
+template<int Shift> static inline vint vIntShr(vint v) { return _mm256_srli_epi32(v, Shift); }
+static inline vint vIntSet1(uint32 i) { return _mm256_set1_epi32((int32)i); }
+static inline vint vIntAnd(vint a, vint b) { return _mm256_and_si256(a, b); }
+static inline vint vToIntTrunc(vfloat v) { return _mm256_cvttps_epi32(v); }
+static inline vfloat vIntToFloat(vint v) { return _mm256_cvtepi32_ps(v); }
+static inline vint vLoadInt(const uint32* p) { return _mm256_loadu_si256((const __m256i*)p); }
+static inline void vStoreInt(uint32* p, vint v) { _mm256_storeu_si256((__m256i*)p, v); }
+static inline vint vSelectInt(vmask m, vint a, vint b) { return _mm256_castps_si256(vSelect(m, _mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+static inline vint vGather(const uint32* base, vint indices) { return _mm256_i32gather_epi32((const int*)base, indices, 4); }
+
+#include "software_raster_kernel.inl"
+
+RasterizeTileFunc GetRasterizeTileKernel_AVX2()
+{
+	return RasterizeTile_AVX2;
+}
+
+#else
+
+RasterizeTileFunc GetRasterizeTileKernel_AVX2()
+{
+	return nullptr;
+}
+
+#endif
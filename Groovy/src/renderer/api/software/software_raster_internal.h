@@ -0,0 +1,67 @@
+#pragma once
+
+#include "software_rasterizer.h"
+
+// shared by the rasterizer front end and the simd kernels
+
+enum ERasterAttribute
+{
+	RASTER_ATTRIBUTE_Z,
+	RASTER_ATTRIBUTE_INV_W,
+	// divided by w, interpolated linearly in screen space
+	RASTER_ATTRIBUTE_R,
+	RASTER_ATTRIBUTE_G,
+	RASTER_ATTRIBUTE_B,
+	RASTER_ATTRIBUTE_A,
+	RASTER_ATTRIBUTE_U,
+	RASTER_ATTRIBUTE_V,
+
+	RASTER_ATTRIBUTE_COUNT
+};
+
+struct RasterTriangle
+{
+	// edge = a * x + b * y + c, pixel centers with every edge >= 0 are inside (fill rule bias already in c)
+	float edgeA[3], edgeB[3], edgeC[3];
+	// 1 / length of (a, b), turns edge values into pixel distances for wireframe
+	float edgeInvLength[3];
+	// attribute = dx * x + dy * y + base
+	float planeDx[RASTER_ATTRIBUTE_COUNT];
+	float planeDy[RASTER_ATTRIBUTE_COUNT];
+	float planeBase[RASTER_ATTRIBUTE_COUNT];
+	// inclusive, clamped to the render target
+	int32 minX, minY, maxX, maxY;
+	uint32 drawState;
+};
+
+struct RasterDrawState
+{
+	SoftwareTextureView texture;
+	ERasterizerFillMode fillMode;
+};
+
+struct RasterTileJob
+{
+	const SoftwareRenderTarget* target;
+	const RasterTriangle* triangles;
+	const RasterDrawState* drawStates;
+	const uint32* triangleIndices;
+	uint32 triangleCount;
+	// tile rect, end exclusive, clamped to the render target
+	int32 x0, y0, x1, y1;
+};
+
+// returns the number of pixels written
+typedef uint64(*RasterizeTileFunc)(const RasterTileJob& job);
+
+// nullptr when the kernel is not compiled in
+RasterizeTileFunc GetRasterizeTileKernel_Scalar();
+RasterizeTileFunc GetRasterizeTileKernel_SSE();
+RasterizeTileFunc GetRasterizeTileKernel_AVX2();
+
+inline uint32 RasterCountBits(uint32 v)
+{
+	v = v - ((v >> 1) & 0x55555555);
+	v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+	return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
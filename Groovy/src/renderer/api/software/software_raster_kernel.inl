@@ -0,0 +1,181 @@
+/*
+	Tile rasterization kernel, included by every software_raster_<isa>.cpp after the lane primitives are defined:
+	SR_LANES, SR_KERNEL_NAME, vfloat, vint, vmask and the v* functions.
+	Processes SR_LANES pixels of a row at a time.
+*/
+
+static uint64 SR_KERNEL_NAME(const RasterTileJob& job)
+{
+	const SoftwareRenderTarget& target = *job.target;
+	uint64 pixelsWritten = 0;
+
+	const vfloat laneOffsets = vLaneOffsets();
+	const vfloat zero = vSet1(0.0f);
+	const vfloat one = vSet1(1.0f);
+	const vfloat half = vSet1(0.5f);
+	const vfloat unormScale = vSet1(255.0f);
+	const vfloat unormToFloat = vSet1(1.0f / 255.0f);
+	const vint byteMask = vIntSet1(0xFF);
+
+	for (uint32 t = 0; t < job.triangleCount; t++)
+	{
+		const RasterTriangle& tri = job.triangles[job.triangleIndices[t]];
+		const RasterDrawState& state = job.drawStates[tri.drawState];
+
+		int32 minX = tri.minX > job.x0 ? tri.minX : job.x0;
+		int32 minY = tri.minY > job.y0 ? tri.minY : job.y0;
+		int32 maxX = tri.maxX < job.x1 - 1 ? tri.maxX : job.x1 - 1;
+		int32 maxY = tri.maxY < job.y1 - 1 ? tri.maxY : job.y1 - 1;
+		if (minX > maxX || minY > maxY)
+			continue;
+
+		// tiles start at multiples of SR_LANES, so does every aligned start
+		int32 startX = minX & ~(SR_LANES - 1);
+		const vfloat minXf = vSet1((float)minX);
+		const vfloat maxXf = vSet1((float)maxX);
+
+		const vfloat edgeA0 = vSet1(tri.edgeA[0]), edgeA1 = vSet1(tri.edgeA[1]), edgeA2 = vSet1(tri.edgeA[2]);
+		const vfloat edgeInvLength0 = vSet1(tri.edgeInvLength[0]), edgeInvLength1 = vSet1(tri.edgeInvLength[1]), edgeInvLength2 = vSet1(tri.edgeInvLength[2]);
+
+		vfloat planeDx[RASTER_ATTRIBUTE_COUNT];
+		for (uint32 i = 0; i < RASTER_ATTRIBUTE_COUNT; i++)
+			planeDx[i] = vSet1(tri.planeDx[i]);
+
+		const bool wireframe = state.fillMode == RASTERIZER_FILL_MODE_WIREFRAME;
+		const bool textured = state.texture.texels != nullptr;
+
+		const vfloat textureWidth = vSet1((float)state.texture.width);
+		const vfloat textureHeight = vSet1((float)state.texture.height);
+		const vfloat textureInvWidth = vSet1(textured ? 1.0f / (float)state.texture.width : 0.0f);
+		const vfloat textureInvHeight = vSet1(textured ? 1.0f / (float)state.texture.height : 0.0f);
+		const vfloat textureLastTexel = vSet1(textured ? (float)(state.texture.width * state.texture.height - 1) : 0.0f);
+
+		for (int32 y = minY; y <= maxY; y++)
+		{
+			float py = (float)y + 0.5f;
+
+			const vfloat rowEdge0 = vSet1(tri.edgeB[0] * py + tri.edgeC[0]);
+			const vfloat rowEdge1 = vSet1(tri.edgeB[1] * py + tri.edgeC[1]);
+			const vfloat rowEdge2 = vSet1(tri.edgeB[2] * py + tri.edgeC[2]);
+
+			vfloat rowPlane[RASTER_ATTRIBUTE_COUNT];
+			for (uint32 i = 0; i < RASTER_ATTRIBUTE_COUNT; i++)
+				rowPlane[i] = vSet1(tri.planeDy[i] * py + tri.planeBase[i]);
+
+			float* depthRow = target.depth ? target.depth + (size_t)y * target.pitch : nullptr;
+			uint32* colorRow = target.color ? target.color + (size_t)y * target.pitch : nullptr;
+
+			for (int32 x = startX; x <= maxX; x += SR_LANES)
+			{
+				vfloat px = vAdd(vSet1((float)x), laneOffsets);
+				vmask mask = vMaskAnd(vCmpGe(px, minXf), vCmpLe(px, maxXf));
+				px = vAdd(px, half);
+
+				vfloat e0 = vAdd(vMul(edgeA0, px), rowEdge0);
+				vfloat e1 = vAdd(vMul(edgeA1, px), rowEdge1);
+				vfloat e2 = vAdd(vMul(edgeA2, px), rowEdge2);
+				mask = vMaskAnd(mask, vMaskAnd(vCmpGe(e0, zero), vMaskAnd(vCmpGe(e1, zero), vCmpGe(e2, zero))));
+				if (!vMaskBits(mask))
+					continue;
+
+				if (wireframe)
+				{
+					// only pixels within one pixel from an edge
+					vfloat distance = vMin(vMul(e0, edgeInvLength0), vMin(vMul(e1, edgeInvLength1), vMul(e2, edgeInvLength2)));
+					mask = vMaskAnd(mask, vCmpLt(distance, one));
+					if (!vMaskBits(mask))
+						continue;
+				}
+
+				// depth clip and depth test
+				vfloat z = vAdd(vMul(planeDx[RASTER_ATTRIBUTE_Z], px), rowPlane[RASTER_ATTRIBUTE_Z]);
+				mask = vMaskAnd(mask, vMaskAnd(vCmpGe(z, zero), vCmpLe(z, one)));
+
+				if (depthRow)
+				{
+					vfloat depth = vLoad(depthRow + x);
+					mask = vMaskAnd(mask, vCmpLt(z, depth));
+					vStore(depthRow + x, vSelect(mask, z, depth));
+				}
+
+				uint32 maskBits = vMaskBits(mask);
+				if (!maskBits)
+					continue;
+
+				pixelsWritten += RasterCountBits(maskBits);
+
+				if (!colorRow)
+					continue;
+
+				// perspective correct attributes
+				vfloat w = vDiv(one, vAdd(vMul(planeDx[RASTER_ATTRIBUTE_INV_W], px), rowPlane[RASTER_ATTRIBUTE_INV_W]));
+				vfloat r = vMul(vAdd(vMul(planeDx[RASTER_ATTRIBUTE_R], px), rowPlane[RASTER_ATTRIBUTE_R]), w);
+				vfloat g = vMul(vAdd(vMul(planeDx[RASTER_ATTRIBUTE_G], px), rowPlane[RASTER_ATTRIBUTE_G]), w);
+				vfloat b = vMul(vAdd(vMul(planeDx[RASTER_ATTRIBUTE_B], px), rowPlane[RASTER_ATTRIBUTE_B]), w);
+				vfloat a = vMul(vAdd(vMul(planeDx[RASTER_ATTRIBUTE_A], px), rowPlane[RASTER_ATTRIBUTE_A]), w);
+
+				if (textured)
+				{
+					vfloat u = vMul(vAdd(vMul(planeDx[RASTER_ATTRIBUTE_U], px), rowPlane[RASTER_ATTRIBUTE_U]), w);
+					vfloat v = vMul(vAdd(vMul(planeDx[RASTER_ATTRIBUTE_V], px), rowPlane[RASTER_ATTRIBUTE_V]), w);
+
+					// bilinear, wrap addressing, same as the d3d11 sampler
+					vfloat texelX = vSub(vMul(u, textureWidth), half);
+					vfloat texelY = vSub(vMul(v, textureHeight), half);
+					vfloat x0 = vFloor(texelX);
+					vfloat y0 = vFloor(texelY);
+					vfloat fracX = vSub(texelX, x0);
+					vfloat fracY = vSub(texelY, y0);
+
+					x0 = vSub(x0, vMul(vFloor(vMul(x0, textureInvWidth)), textureWidth));
+					y0 = vSub(y0, vMul(vFloor(vMul(y0, textureInvHeight)), textureHeight));
+					x0 = vSelect(vCmpGe(x0, textureWidth), zero, x0);
+					y0 = vSelect(vCmpGe(y0, textureHeight), zero, y0);
+					vfloat x1 = vAdd(x0, one);
+					vfloat y1 = vAdd(y0, one);
+					x1 = vSelect(vCmpGe(x1, textureWidth), zero, x1);
+					y1 = vSelect(vCmpGe(y1, textureHeight), zero, y1);
+
+					// indices are computed in float (exact up to 2^24 texels), clamped so garbage lanes can't read out of bounds
+					vfloat row0 = vMul(y0, textureWidth);
+					vfloat row1 = vMul(y1, textureWidth);
+					vint t00 = vGather(state.texture.texels, vToIntTrunc(vMin(vMax(vAdd(row0, x0), zero), textureLastTexel)));
+					vint t10 = vGather(state.texture.texels, vToIntTrunc(vMin(vMax(vAdd(row0, x1), zero), textureLastTexel)));
+					vint t01 = vGather(state.texture.texels, vToIntTrunc(vMin(vMax(vAdd(row1, x0), zero), textureLastTexel)));
+					vint t11 = vGather(state.texture.texels, vToIntTrunc(vMin(vMax(vAdd(row1, x1), zero), textureLastTexel)));
+
+					vfloat invFracX = vSub(one, fracX);
+					vfloat invFracY = vSub(one, fracY);
+					vfloat w00 = vMul(vMul(invFracX, invFracY), unormToFloat);
+					vfloat w10 = vMul(vMul(fracX, invFracY), unormToFloat);
+					vfloat w01 = vMul(vMul(invFracX, fracY), unormToFloat);
+					vfloat w11 = vMul(vMul(fracX, fracY), unormToFloat);
+
+					#define SR_BILERP_CHANNEL(Shift)																\
+						vAdd(vAdd(vMul(vIntToFloat(vIntAnd(vIntShr<Shift>(t00), byteMask)), w00),					\
+							vMul(vIntToFloat(vIntAnd(vIntShr<Shift>(t10), byteMask)), w10)),						\
+							vAdd(vMul(vIntToFloat(vIntAnd(vIntShr<Shift>(t01), byteMask)), w01),					\
+							vMul(vIntToFloat(vIntAnd(vIntShr<Shift>(t11), byteMask)), w11)))
+
+					r = vMul(r, SR_BILERP_CHANNEL(0));
+					g = vMul(g, SR_BILERP_CHANNEL(8));
+					b = vMul(b, SR_BILERP_CHANNEL(16));
+					a = vMul(a, SR_BILERP_CHANNEL(24));
+
+					#undef SR_BILERP_CHANNEL
+				}
+
+				vint ri = vToInt(vMul(vMin(vMax(r, zero), one), unormScale));
+				vint gi = vToInt(vMul(vMin(vMax(g, zero), one), unormScale));
+				vint bi = vToInt(vMul(vMin(vMax(b, zero), one), unormScale));
+				vint ai = vToInt(vMul(vMin(vMax(a, zero), one), unormScale));
+				vint packed = vIntOr(vIntOr(ri, vIntShl<8>(gi)), vIntOr(vIntShl<16>(bi), vIntShl<24>(ai)));
+
+				vint old = vLoadInt(colorRow + x);
+				vStoreInt(colorRow + x, vSelectInt(mask, packed, old));
+			}
+		}
+	}
+
+	return pixelsWritten;
+}
@@ -0,0 +1,53 @@
+#include "software_raster_internal.h"
+
+#include <math.h>
+
+// portable fallback with the same lane layout as the sse kernel, the compiler is free to vectorize the loops
+
+#define SR_LANES 4
+#define SR_KERNEL_NAME RasterizeTile_Scalar
+
+struct vfloat { float v[SR_LANES]; };
+struct vmask { uint32 v[SR_LANES]; };
+struct vint { uint32 v[SR_LANES]; };
+
+#define SR_FOR_LANES for (uint32 i = 0; i < SR_LANES; i++)
+
+static inline vfloat vSet1(float f) { vfloat r; SR_FOR_LANES r.v[i] = f; return r; }
+static inline vfloat vLaneOffsets() { vfloat r; SR_FOR_LANES r.v[i] = (float)i; return r; }
+static inline vfloat vLoad(const float* p) { vfloat r; SR_FOR_LANES r.v[i] = p[i]; return r; }
+static inline void vStore(float* p, vfloat v) { SR_FOR_LANES p[i] = v.v[i]; }
+static inline vfloat vAdd(vfloat a, vfloat b) { vfloat r; SR_FOR_LANES r.v[i] = a.v[i] + b.v[i]; return r; }
+static inline vfloat vSub(vfloat a, vfloat b) { vfloat r; SR_FOR_LANES r.v[i] = a.v[i] - b.v[i]; return r; }
+static inline vfloat vFloor(vfloat v) { vfloat r; SR_FOR_LANES r.v[i] = floorf(v.v[i]); return r; }
+static inline vfloat vMul(vfloat a, vfloat b) { vfloat r; SR_FOR_LANES r.v[i] = a.v[i] * b.v[i]; return r; }
+static inline vfloat vDiv(vfloat a, vfloat b) { vfloat r; SR_FOR_LANES r.v[i] = a.v[i] / b.v[i]; return r; }
+static inline vfloat vMin(vfloat a, vfloat b) { vfloat r; SR_FOR_LANES r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i]; return r; }
+static inline vfloat vMax(vfloat a, vfloat b) { vfloat r; SR_FOR_LANES r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; return r; }
+
+static inline vmask vCmpGe(vfloat a, vfloat b) { vmask r; SR_FOR_LANES r.v[i] = a.v[i] >= b.v[i] ? ~0u : 0u; return r; }
+static inline vmask vCmpLe(vfloat a, vfloat b) { vmask r; SR_FOR_LANES r.v[i] = a.v[i] <= b.v[i] ? ~0u : 0u; return r; }
+static inline vmask vCmpLt(vfloat a, vfloat b) { vmask r; SR_FOR_LANES r.v[i] = a.v[i] < b.v[i] ? ~0u : 0u; return r; }
+static inline vmask vMaskAnd(vmask a, vmask b) { vmask r; SR_FOR_LANES r.v[i] = a.v[i] & b.v[i]; return r; }
+static inline uint32 vMaskBits(vmask m) { uint32 bits = 0; SR_FOR_LANES bits |= (m.v[i] & 1) << i; return bits; }
+static inline vfloat vSelect(vmask m, vfloat a, vfloat b) { vfloat r; SR_FOR_LANES r.v[i] = m.v[i] ? a.v[i] : b.v[i]; return r; }
+
+static inline vint vToInt(vfloat v) { vint r; SR_FOR_LANES r.v[i] = (uint32)(int32)lrintf(v.v[i]); return r; }
+static inline vint vIntOr(vint a, vint b) { vint r; SR_FOR_LANES r.v[i] = a.v[i] | b.v[i]; return r; }
+template<int Shift> static inline vint vIntShl(vint v) { vint r; SR_FOR_LANES r.v[i] = v.v[i] << Shift; return r; }
+template<int Shift> static inline vint vIntShr(vint v) { vint r; SR_FOR_LANES r.v[i] = v.v[i] >> Shift; return r; }
+static inline vint vIntSet1(uint32 value) { vint r; SR_FOR_LANES r.v[i] = value; return r; }
+static inline vint vIntAnd(vint a, vint b) { vint r; SR_FOR_LANES r.v[i] = a.v[i] & b.v[i]; return r; }
+static inline vint vToIntTrunc(vfloat v) { vint r; SR_FOR_LANES r.v[i] = (uint32)(int32)v.v[i]; return r; }
+static inline vfloat vIntToFloat(vint v) { vfloat r; SR_FOR_LANES r.v[i] = (float)(int32)v.v[i]; return r; }
+static inline vint vGather(const uint32* base, vint indices) { vint r; SR_FOR_LANES r.v[i] = base[indices.v[i]]; return r; }
+static inline vint vLoadInt(const uint32* p) { vint r; SR_FOR_LANES r.v[i] = p[i]; return r; }
+static inline void vStoreInt(uint32* p, vint v) { SR_FOR_LANES p[i] = v.v[i]; }
+static inline vint vSelectInt(vmask m, vint a, vint b) { vint r; SR_FOR_LANES r.v[i] = m.v[i] ? a.v[i] : b.v[i]; return r; }
+
+#include "software_raster_kernel.inl"
+
+RasterizeTileFunc GetRasterizeTileKernel_Scalar()
+{
+	return RasterizeTile_Scalar;
+}
@@ -0,0 +1,73 @@
+#include "software_raster_internal.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+
+#include <emmintrin.h>
+
+#define SR_LANES 4
+#define SR_KERNEL_NAME RasterizeTile_SSE
+
+typedef __m128 vfloat;
+typedef __m128 vmask;
+typedef __m128i vint;
+
+static inline vfloat vSet1(float f) { return _mm_set1_ps(f); }
+static inline vfloat vLaneOffsets() { return _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f); }
+static inline vfloat vLoad(const float* p) { return _mm_loadu_ps(p); }
+static inline void vStore(float* p, vfloat v) { _mm_storeu_ps(p, v); }
+static inline vfloat vAdd(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+static inline vfloat vSub(vfloat a, vfloat b) { return _mm_sub_ps(a, b); }
+static inline vfloat vMul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+static inline vfloat vDiv(vfloat a, vfloat b) { return _mm_div_ps(a, b); }
+static inline vfloat vMin(vfloat a, vfloat b) { return _mm_min_ps(a, b); }
+static inline vfloat vMax(vfloat a, vfloat b) { return _mm_max_ps(a, b); }
+
+static inline vmask vCmpGe(vfloat a, vfloat b) { return _mm_cmpge_ps(a, b); }
+static inline vmask vCmpLe(vfloat a, vfloat b) { return _mm_cmple_ps(a, b); }
+static inline vmask vCmpLt(vfloat a, vfloat b) { return _mm_cmplt_ps(a, b); }
+static inline vmask vMaskAnd(vmask a, vmask b) { return _mm_and_ps(a, b); }
+static inline uint32 vMaskBits(vmask m) { return (uint32)_mm_movemask_ps(m); }
+static inline vfloat vSelect(vmask m, vfloat a, vfloat b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+
+static inline vint vToInt(vfloat v) { return _mm_cvtps_epi32(v); }
+static inline vint vIntOr(vint a, vint b) { return _mm_or_si128(a, b); }
+template<int Shift> static inline vint vIntShl(vint v) { return _mm_slli_epi32(v, Shift); }
+template<int Shift> static inline vint vIntShr(vint v) { return _mm_srli_epi32(v, Shift); }
+static inline vint vIntSet1(uint32 i) { return _mm_set1_epi32((int32)i); }
+static inline vint vIntAnd(vint a, vint b) { return _mm_and_si128(a, b); }
+static inline vint vToIntTrunc(vfloat v) { return _mm_cvttps_epi32(v); }
+static inline vfloat vIntToFloat(vint v) { return _mm_cvtepi32_ps(v); }
+static inline vint vLoadInt(const uint32* p) { return _mm_loadu_si128((const __m128i*)p); }
+static inline void vStoreInt(uint32* p, vint v) { _mm_storeu_si128((__m128i*)p, v); }
+static inline vint vSelectInt(vmask m, vint a, vint b) { return _mm_castps_si128(vSelect(m, _mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+
+// sse2 has no floor, truncate and fix negative values (fine for |v| < 2^31)
+static inline vfloat vFloor(vfloat v)
+{
+	vfloat truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+	return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v), _mm_set1_ps(1.0f)));
+}
+
+// no gather before avx2
+static inline vint vGather(const uint32* base, vint indices)
+{
+	alignas(16) uint32 i[4];
+	_mm_store_si128((__m128i*)i, indices);
+	return _mm_setr_epi32((int32)base[i[0]], (int32)base[i[1]], (int32)base[i[2]], (int32)base[i[3]]);
+}
+
+#include "software_raster_kernel.inl"
+
+RasterizeTileFunc GetRasterizeTileKernel_SSE()
+{
+	return RasterizeTile_SSE;
+}
+
+#else
+
+RasterizeTileFunc GetRasterizeTileKernel_SSE()
+{
+	return nullptr;
+}
+
+#endif
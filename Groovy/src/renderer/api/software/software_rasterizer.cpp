@@ -0,0 +1,410 @@
+#include "software_raster_internal.h"
+#include "platform/cpu.h"
+#include "core/jobs.h"
+
+#include <atomic>
+
+#include <math.h>
+
+// screen positions are snapped to 1/16 of a pixel
+static constexpr float SUBPIXEL_STEPS = 16.0f;
+// with snapped positions edge values at pixel centers are multiples of 1/256, a smaller bias only excludes pixels lying exactly on non top-left edges
+static constexpr float FILL_RULE_BIAS = 1.0f / 1024.0f;
+
+// floorf/ceilf are library calls without sse4.1, |v| stays far below 2^31 because screen positions are clamped
+static inline float FastFloor(float v)
+{
+	float truncated = (float)(int32)v;
+	return truncated > v ? truncated - 1.0f : truncated;
+}
+
+static inline float FastCeil(float v)
+{
+	return -FastFloor(-v);
+}
+
+// pixels, beyond this float precision is long gone anyway
+static constexpr float MAX_SCREEN_COORD = 16777216.0f;
+
+static inline float ClampScreenCoord(float v)
+{
+	return v < -MAX_SCREEN_COORD ? -MAX_SCREEN_COORD : (v > MAX_SCREEN_COORD ? MAX_SCREEN_COORD : v);
+}
+
+static RasterizeTileFunc GetKernelFunc(ESoftwareRasterizerKernel kernel)
+{
+	switch (kernel)
+	{
+		case SOFTWARE_RASTERIZER_KERNEL_SCALAR:	return GetRasterizeTileKernel_Scalar();
+		case SOFTWARE_RASTERIZER_KERNEL_SSE:	return GetRasterizeTileKernel_SSE();
+		case SOFTWARE_RASTERIZER_KERNEL_AVX2:	return CpuInfo::SupportsAVX2() ? GetRasterizeTileKernel_AVX2() : nullptr;
+		// auto is resolved by the constructor
+		default:								break;
+	}
+	return nullptr;
+}
+
+bool SoftwareRasterizer::IsKernelSupported(ESoftwareRasterizerKernel kernel)
+{
+	return kernel == SOFTWARE_RASTERIZER_KERNEL_AUTO || GetKernelFunc(kernel);
+}
+
+const char* SoftwareRasterizer::GetKernelName(ESoftwareRasterizerKernel kernel)
+{
+	switch (kernel)
+	{
+		case SOFTWARE_RASTERIZER_KERNEL_AUTO:	return "auto";
+		case SOFTWARE_RASTERIZER_KERNEL_SCALAR:	return "scalar";
+		case SOFTWARE_RASTERIZER_KERNEL_SSE:	return "sse";
+		case SOFTWARE_RASTERIZER_KERNEL_AVX2:	return "avx2";
+	}
+	return "unknown";
+}
+
+SoftwareRasterizer::SoftwareRasterizer(ESoftwareRasterizerKernel kernel)
+	: mTarget(), mTexture(), mDrawStateDirty(true), mTilesX(0), mTilesY(0), mStats()
+{
+	mRasterizerState.fillMode = RASTERIZER_FILL_MODE_SOLID;
+	mRasterizerState.cullMode = RASTERIZER_CULL_MODE_BACK;
+
+	if (kernel == SOFTWARE_RASTERIZER_KERNEL_AUTO)
+	{
+		if (GetKernelFunc(SOFTWARE_RASTERIZER_KERNEL_AVX2))
+			kernel = SOFTWARE_RASTERIZER_KERNEL_AVX2;
+		else if (GetKernelFunc(SOFTWARE_RASTERIZER_KERNEL_SSE))
+			kernel = SOFTWARE_RASTERIZER_KERNEL_SSE;
+		else
+			kernel = SOFTWARE_RASTERIZER_KERNEL_SCALAR;
+	}
+
+	checkf(GetKernelFunc(kernel), "Software rasterizer kernel not supported on this cpu");
+	mKernelType = kernel;
+	mKernel = (void*)GetKernelFunc(kernel);
+}
+
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+}
+
+uint32 SoftwareRasterizer::GetThreadCount() const
+{
+	return Jobs::GetThreadCount();
+}
+
+void SoftwareRasterizer::SetRenderTarget(const SoftwareRenderTarget& target)
+{
+	if (target.color == mTarget.color && target.depth == mTarget.depth && target.width == mTarget.width && target.height == mTarget.height && target.pitch == mTarget.pitch)
+		return;
+
+	Flush();
+
+	checkslowf(target.pitch % SOFTWARE_RASTERIZER_ROW_ALIGNMENT == 0 && target.pitch >= target.width, "Software render target rows must be padded to SOFTWARE_RASTERIZER_ROW_ALIGNMENT pixels");
+
+	mTarget = target;
+	mTilesX = (target.width + SOFTWARE_RASTERIZER_TILE_SIZE - 1) / SOFTWARE_RASTERIZER_TILE_SIZE;
+	mTilesY = (target.height + SOFTWARE_RASTERIZER_TILE_SIZE - 1) / SOFTWARE_RASTERIZER_TILE_SIZE;
+	mBins.resize((size_t)mTilesX * mTilesY);
+}
+
+void SoftwareRasterizer::SetRasterizerState(RasterizerState state)
+{
+	if (state.fillMode != mRasterizerState.fillMode)
+		mDrawStateDirty = true;
+	mRasterizerState = state;
+}
+
+void SoftwareRasterizer::SetTexture(SoftwareTextureView texture)
+{
+	if (texture.texels != mTexture.texels || texture.width != mTexture.width || texture.height != mTexture.height)
+		mDrawStateDirty = true;
+	mTexture = texture;
+}
+
+bool SoftwareRasterizer::HasPendingWork() const
+{
+	return mTriangles.size();
+}
+
+void SoftwareRasterizer::DrawIndexed(const float* clipFromObject, const MeshVertex* vertices, uint32 vertexCount, const MeshIndex* indices, uint32 indexCount)
+{
+	check(clipFromObject && vertices && indices);
+
+	if (!mTarget.width || !mTarget.height || indexCount < 3)
+		return;
+
+	// only transform the vertices this draw can reach
+	uint32 maxIndex = 0;
+	for (uint32 i = 0; i < indexCount; i++)
+		maxIndex = indices[i] > maxIndex ? indices[i] : maxIndex;
+
+	checkf(maxIndex < vertexCount, "Index out of the vertex buffer range");
+	if (maxIndex >= vertexCount)
+		return;
+
+	const float* m = clipFromObject;
+
+	mClipVertices.resize(maxIndex + 1);
+	for (uint32 i = 0; i <= maxIndex; i++)
+	{
+		const MeshVertex& in = vertices[i];
+		ClipVertex& out = mClipVertices[i];
+
+		const Vec4& p = in.position;
+		out.x = m[0] * p.x + m[1] * p.y + m[2] * p.z + m[3] * p.w;
+		out.y = m[4] * p.x + m[5] * p.y + m[6] * p.z + m[7] * p.w;
+		out.z = m[8] * p.x + m[9] * p.y + m[10] * p.z + m[11] * p.w;
+		out.w = m[12] * p.x + m[13] * p.y + m[14] * p.z + m[15] * p.w;
+		out.r = in.color.x;
+		out.g = in.color.y;
+		out.b = in.color.z;
+		out.a = in.color.w;
+		out.u = in.textCoords.x;
+		out.v = in.textCoords.y;
+	}
+
+	if (mDrawStateDirty)
+	{
+		mDrawStates.push_back({ mTexture, mRasterizerState.fillMode });
+		mDrawStateDirty = false;
+	}
+
+	for (uint32 i = 0; i + 2 < indexCount; i += 3)
+	{
+		mStats.trianglesSubmitted++;
+		ClipAndSetupTriangle(mClipVertices[indices[i]], mClipVertices[indices[i + 1]], mClipVertices[indices[i + 2]]);
+	}
+}
+
+void SoftwareRasterizer::ClipAndSetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2)
+{
+	// trivial reject, all three vertices outside the same plane
+	if ((v0.x < -v0.w && v1.x < -v1.w && v2.x < -v2.w) || (v0.x > v0.w && v1.x > v1.w && v2.x > v2.w) ||
+		(v0.y < -v0.w && v1.y < -v1.w && v2.y < -v2.w) || (v0.y > v0.w && v1.y > v1.w && v2.y > v2.w) ||
+		(v0.z < 0.0f && v1.z < 0.0f && v2.z < 0.0f) || (v0.z > v0.w && v1.z > v1.w && v2.z > v2.w))
+	{
+		return;
+	}
+
+	if (v0.z >= 0.0f && v1.z >= 0.0f && v2.z >= 0.0f)
+	{
+		SetupTriangle(v0, v1, v2);
+		return;
+	}
+
+	// near plane (z = 0) clipping, the far plane and the sides are handled per pixel and by the bounding box
+	const ClipVertex* in[3] = { &v0, &v1, &v2 };
+	ClipVertex out[4];
+	uint32 outCount = 0;
+
+	for (uint32 i = 0; i < 3; i++)
+	{
+		const ClipVertex& a = *in[i];
+		const ClipVertex& b = *in[(i + 1) % 3];
+
+		if (a.z >= 0.0f)
+			out[outCount++] = a;
+
+		if ((a.z >= 0.0f) != (b.z >= 0.0f))
+		{
+			float t = a.z / (a.z - b.z);
+			ClipVertex& c = out[outCount++];
+			c.x = a.x + (b.x - a.x) * t;
+			c.y = a.y + (b.y - a.y) * t;
+			c.z = 0.0f;
+			c.w = a.w + (b.w - a.w) * t;
+			c.r = a.r + (b.r - a.r) * t;
+			c.g = a.g + (b.g - a.g) * t;
+			c.b = a.b + (b.b - a.b) * t;
+			c.a = a.a + (b.a - a.a) * t;
+			c.u = a.u + (b.u - a.u) * t;
+			c.v = a.v + (b.v - a.v) * t;
+		}
+	}
+
+	for (uint32 i = 1; i + 1 < outCount; i++)
+		SetupTriangle(out[0], out[i], out[i + 1]);
+}
+
+void SoftwareRasterizer::SetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2)
+{
+	const ClipVertex* clip[3] = { &v0, &v1, &v2 };
+
+	float sx[3], sy[3], attributes[3][RASTER_ATTRIBUTE_COUNT];
+	for (uint32 i = 0; i < 3; i++)
+	{
+		const ClipVertex& v = *clip[i];
+		if (v.w <= 0.0f)
+			return;
+
+		float invW = 1.0f / v.w;
+		float ndcX = v.x * invW;
+		float ndcY = v.y * invW;
+
+		sx[i] = FastFloor(ClampScreenCoord((ndcX * 0.5f + 0.5f) * (float)mTarget.width) * SUBPIXEL_STEPS + 0.5f) / SUBPIXEL_STEPS;
+		sy[i] = FastFloor(ClampScreenCoord((0.5f - ndcY * 0.5f) * (float)mTarget.height) * SUBPIXEL_STEPS + 0.5f) / SUBPIXEL_STEPS;
+
+		attributes[i][RASTER_ATTRIBUTE_Z] = v.z * invW;
+		attributes[i][RASTER_ATTRIBUTE_INV_W] = invW;
+		attributes[i][RASTER_ATTRIBUTE_R] = v.r * invW;
+		attributes[i][RASTER_ATTRIBUTE_G] = v.g * invW;
+		attributes[i][RASTER_ATTRIBUTE_B] = v.b * invW;
+		attributes[i][RASTER_ATTRIBUTE_A] = v.a * invW;
+		attributes[i][RASTER_ATTRIBUTE_U] = v.u * invW;
+		attributes[i][RASTER_ATTRIBUTE_V] = v.v * invW;
+	}
+
+	float dx1 = sx[1] - sx[0], dy1 = sy[1] - sy[0];
+	float dx2 = sx[2] - sx[0], dy2 = sy[2] - sy[0];
+	float det = dx1 * dy2 - dx2 * dy1;
+
+	// y points down, positive area = clockwise on screen = front face (d3d11 default)
+	if (det == 0.0f)
+		return;
+	if (mRasterizerState.cullMode == RASTERIZER_CULL_MODE_BACK && det < 0.0f)
+		return;
+	if (mRasterizerState.cullMode == RASTERIZER_CULL_MODE_FRONT && det > 0.0f)
+		return;
+
+	float minSx = sx[0] < sx[1] ? (sx[0] < sx[2] ? sx[0] : sx[2]) : (sx[1] < sx[2] ? sx[1] : sx[2]);
+	float maxSx = sx[0] > sx[1] ? (sx[0] > sx[2] ? sx[0] : sx[2]) : (sx[1] > sx[2] ? sx[1] : sx[2]);
+	float minSy = sy[0] < sy[1] ? (sy[0] < sy[2] ? sy[0] : sy[2]) : (sy[1] < sy[2] ? sy[1] : sy[2]);
+	float maxSy = sy[0] > sy[1] ? (sy[0] > sy[2] ? sy[0] : sy[2]) : (sy[1] > sy[2] ? sy[1] : sy[2]);
+
+	// pixels whose center can be inside
+	float minXf = FastCeil(minSx - 0.5f), maxXf = FastFloor(maxSx - 0.5f);
+	float minYf = FastCeil(minSy - 0.5f), maxYf = FastFloor(maxSy - 0.5f);
+	if (maxXf < 0.0f || maxYf < 0.0f || minXf > (float)(mTarget.width - 1) || minYf > (float)(mTarget.height - 1))
+		return;
+
+	RasterTriangle& tri = mTriangles.emplace_back();
+	tri.minX = minXf < 0.0f ? 0 : (int32)minXf;
+	tri.minY = minYf < 0.0f ? 0 : (int32)minYf;
+	tri.maxX = maxXf > (float)(mTarget.width - 1) ? (int32)mTarget.width - 1 : (int32)maxXf;
+	tri.maxY = maxYf > (float)(mTarget.height - 1) ? (int32)mTarget.height - 1 : (int32)maxYf;
+	tri.drawState = (uint32)mDrawStates.size() - 1;
+
+	if (tri.minX > tri.maxX || tri.minY > tri.maxY)
+	{
+		mTriangles.pop_back();
+		return;
+	}
+
+	// edge i goes from vertex i + 1 to vertex i + 2, positive inside for clockwise triangles
+	float orientation = det > 0.0f ? 1.0f : -1.0f;
+	bool wireframe = mRasterizerState.fillMode == RASTERIZER_FILL_MODE_WIREFRAME;
+	for (uint32 i = 0; i < 3; i++)
+	{
+		uint32 from = (i + 1) % 3;
+		uint32 to = (i + 2) % 3;
+
+		float a = (sy[from] - sy[to]) * orientation;
+		float b = (sx[to] - sx[from]) * orientation;
+		float c = -(a * sx[from] + b * sy[from]);
+
+		// top-left rule, left edges have the inside on their right, top edges are horizontal with the inside below
+		bool topLeft = a > 0.0f || (a == 0.0f && b > 0.0f);
+		if (!topLeft)
+			c -= FILL_RULE_BIAS;
+
+		tri.edgeA[i] = a;
+		tri.edgeB[i] = b;
+		tri.edgeC[i] = c;
+		tri.edgeInvLength[i] = wireframe ? 1.0f / sqrtf(a * a + b * b) : 0.0f;
+	}
+
+	float invDet = 1.0f / det;
+	for (uint32 i = 0; i < RASTER_ATTRIBUTE_COUNT; i++)
+	{
+		float d1 = attributes[1][i] - attributes[0][i];
+		float d2 = attributes[2][i] - attributes[0][i];
+
+		tri.planeDx[i] = (d1 * dy2 - d2 * dy1) * invDet;
+		tri.planeDy[i] = (d2 * dx1 - d1 * dx2) * invDet;
+		tri.planeBase[i] = attributes[0][i] - tri.planeDx[i] * sx[0] - tri.planeDy[i] * sy[0];
+	}
+
+	mStats.trianglesRasterized++;
+
+	// bin, skipping tiles fully outside one of the edges
+	uint32 triangleIndex = (uint32)mTriangles.size() - 1;
+	uint32 tileMinX = tri.minX / SOFTWARE_RASTERIZER_TILE_SIZE, tileMaxX = tri.maxX / SOFTWARE_RASTERIZER_TILE_SIZE;
+	uint32 tileMinY = tri.minY / SOFTWARE_RASTERIZER_TILE_SIZE, tileMaxY = tri.maxY / SOFTWARE_RASTERIZER_TILE_SIZE;
+	bool singleTile = tileMinX == tileMaxX && tileMinY == tileMaxY;
+
+	for (uint32 ty = tileMinY; ty <= tileMaxY; ty++)
+	{
+		for (uint32 tx = tileMinX; tx <= tileMaxX; tx++)
+		{
+			if (!singleTile)
+			{
+				float x0 = (float)(tx * SOFTWARE_RASTERIZER_TILE_SIZE) + 0.5f, x1 = x0 + (float)(SOFTWARE_RASTERIZER_TILE_SIZE - 1);
+				float y0 = (float)(ty * SOFTWARE_RASTERIZER_TILE_SIZE) + 0.5f, y1 = y0 + (float)(SOFTWARE_RASTERIZER_TILE_SIZE - 1);
+
+				bool outside = false;
+				for (uint32 e = 0; e < 3 && !outside; e++)
+				{
+					// most inside corner of the tile for this edge
+					float x = tri.edgeA[e] > 0.0f ? x1 : x0;
+					float y = tri.edgeB[e] > 0.0f ? y1 : y0;
+					outside = tri.edgeA[e] * x + tri.edgeB[e] * y + tri.edgeC[e] < 0.0f;
+				}
+				if (outside)
+					continue;
+			}
+
+			mBins[(size_t)ty * mTilesX + tx].push_back(triangleIndex);
+		}
+	}
+}
+
+uint64 SoftwareRasterizer::RasterizeTiles(uint32 firstTile, uint32 endTile)
+{
+	RasterizeTileFunc kernel = (RasterizeTileFunc)mKernel;
+	uint64 pixels = 0;
+
+	RasterTileJob job;
+	job.target = &mTarget;
+	job.triangles = mTriangles.data();
+	job.drawStates = mDrawStates.data();
+
+	for (uint32 tile = firstTile; tile < endTile; tile++)
+	{
+		const std::vector<uint32>& bin = mBins[tile];
+		if (bin.empty())
+			continue;
+
+		uint32 tx = tile % mTilesX;
+		uint32 ty = tile / mTilesX;
+
+		job.triangleIndices = bin.data();
+		job.triangleCount = (uint32)bin.size();
+		job.x0 = (int32)(tx * SOFTWARE_RASTERIZER_TILE_SIZE);
+		job.y0 = (int32)(ty * SOFTWARE_RASTERIZER_TILE_SIZE);
+		job.x1 = job.x0 + SOFTWARE_RASTERIZER_TILE_SIZE < (int32)mTarget.width ? job.x0 + SOFTWARE_RASTERIZER_TILE_SIZE : (int32)mTarget.width;
+		job.y1 = job.y0 + SOFTWARE_RASTERIZER_TILE_SIZE < (int32)mTarget.height ? job.y0 + SOFTWARE_RASTERIZER_TILE_SIZE : (int32)mTarget.height;
+
+		pixels += kernel(job);
+	}
+
+	return pixels;
+}
+
+void SoftwareRasterizer::Flush()
+{
+	if (mTriangles.empty())
+		return;
+
+	// one tile per batch, tile costs vary a lot and idle threads steal what's left
+	std::atomic<uint64> pixels = 0;
+	Jobs::ParallelFor(mTilesX * mTilesY, 1, [&](uint32 begin, uint32 end)
+	{
+		pixels.fetch_add(RasterizeTiles(begin, end), std::memory_order_relaxed);
+	});
+	mStats.pixelsWritten += pixels.load(std::memory_order_relaxed);
+
+	for (std::vector<uint32>& bin : mBins)
+		bin.clear();
+	mTriangles.clear();
+	mDrawStates.clear();
+	mDrawStateDirty = true;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "core/core.h"
+#include "renderer/mesh.h"
+#include "../renderer_api.h"
+
+
+// render target rows must be padded to this many pixels, kernels read and write whole simd registers
+#define SOFTWARE_RASTERIZER_ROW_ALIGNMENT 8
+#define SOFTWARE_RASTERIZER_TILE_SIZE 64
+
+struct RasterTriangle;
+struct RasterDrawState;
+
+enum ESoftwareRasterizerKernel
+{
+	SOFTWARE_RASTERIZER_KERNEL_AUTO,	// best one supported by the cpu
+	SOFTWARE_RASTERIZER_KERNEL_SCALAR,
+	SOFTWARE_RASTERIZER_KERNEL_SSE,		// 4 pixels at a time
+	SOFTWARE_RASTERIZER_KERNEL_AVX2		// 8 pixels at a time
+};
+
+struct SoftwareRenderTarget
+{
+	uint32 width, height;
+	// pixels per row, multiple of SOFTWARE_RASTERIZER_ROW_ALIGNMENT
+	uint32 pitch;
+	// RGBA8, nullptr = depth only
+	uint32* color;
+	// [0, 1], nullptr = no depth test
+	float* depth;
+};
+
+struct SoftwareTextureView
+{
+	// RGBA8, nullptr = white
+	const uint32* texels;
+	uint32 width, height;
+};
+
+struct SoftwareRasterizerStats
+{
+	uint64 trianglesSubmitted;
+	// survived culling and clipping, near plane clipping can add triangles
+	uint64 trianglesRasterized;
+	uint64 pixelsWritten;
+};
+
+/*
+	Tiled, multi-threaded triangle rasterizer.
+	Draws are transformed, clipped and binned into screen tiles on the calling thread,
+	Flush rasterizes the tiles on the job system (Jobs::ParallelFor, the calling thread helps).
+	Shading matches the default shader: texture (bilinear, wrap) times vertex color, depth test less.
+	Texture memory must stay alive and unchanged until the next Flush.
+*/
+class CORE_API SoftwareRasterizer
+{
+public:
+	SoftwareRasterizer(ESoftwareRasterizerKernel kernel = SOFTWARE_RASTERIZER_KERNEL_AUTO);
+	~SoftwareRasterizer();
+
+	// flushes pending work if the target changes
+	void SetRenderTarget(const SoftwareRenderTarget& target);
+	const SoftwareRenderTarget& GetRenderTarget() const { return mTarget; }
+
+	void SetRasterizerState(RasterizerState state);
+	void SetTexture(SoftwareTextureView texture);
+
+	// clipFromObject is row major, clip = clipFromObject * position (d3d clip space, z in [0, w])
+	void DrawIndexed(const float* clipFromObject, const MeshVertex* vertices, uint32 vertexCount, const MeshIndex* indices, uint32 indexCount);
+
+	// rasterizes everything submitted since the last flush, returns when the target is up to date
+	void Flush();
+	bool HasPendingWork() const;
+
+	// tiles run on the job system threads
+	uint32 GetThreadCount() const;
+	ESoftwareRasterizerKernel GetKernel() const { return mKernelType; }
+
+	const SoftwareRasterizerStats& GetStats() const { return mStats; }
+	void ResetStats() { mStats = {}; }
+
+	static bool IsKernelSupported(ESoftwareRasterizerKernel kernel);
+	static const char* GetKernelName(ESoftwareRasterizerKernel kernel);
+
+private:
+	struct ClipVertex
+	{
+		float x, y, z, w;
+		float r, g, b, a;
+		float u, v;
+	};
+
+	void SetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+	void ClipAndSetupTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+	// returns the pixels written
+	uint64 RasterizeTiles(uint32 firstTile, uint32 endTile);
+
+private:
+	SoftwareRenderTarget mTarget;
+	RasterizerState mRasterizerState;
+	SoftwareTextureView mTexture;
+	bool mDrawStateDirty;
+
+	ESoftwareRasterizerKernel mKernelType;
+	void* mKernel;
+
+	uint32 mTilesX, mTilesY;
+
+	// frame data, cleared by Flush (capacity is kept)
+	std::vector<ClipVertex> mClipVertices;
+	std::vector<RasterTriangle> mTriangles;
+	std::vector<RasterDrawState> mDrawStates;
+	std::vector<std::vector<uint32>> mBins;
+
+	SoftwareRasterizerStats mStats;
+};
+
+// benchmark, triangles per second across job system thread counts and kernels
+void BenchmarkSoftwareRasterizer();
@@ -0,0 +1,149 @@
+#include "software_rasterizer.h"
+#include "core/jobs.h"
+
+#include <chrono>
+#include <thread>
+#include <stdio.h>
+
+static constexpr uint32 BENCHMARK_WIDTH = 1280;
+static constexpr uint32 BENCHMARK_HEIGHT = 720;
+static constexpr uint32 BENCHMARK_TEXTURE_SIZE = 256;
+static constexpr uint32 BENCHMARK_FRAMES = 20;
+
+struct BenchmarkMesh
+{
+	std::vector<MeshVertex> vertices;
+	std::vector<MeshIndex> indices;
+};
+
+// grid of quads covering clip space at depth z, cellsX * cellsY * 2 triangles
+static void BuildGrid(BenchmarkMesh& mesh, uint32 cellsX, uint32 cellsY, float z)
+{
+	uint32 baseVertex = (uint32)mesh.vertices.size();
+
+	for (uint32 y = 0; y <= cellsY; y++)
+	{
+		for (uint32 x = 0; x <= cellsX; x++)
+		{
+			float u = (float)x / (float)cellsX;
+			float v = (float)y / (float)cellsY;
+
+			MeshVertex& vertex = mesh.vertices.emplace_back();
+			vertex.position = { u * 2.0f - 1.0f, 1.0f - v * 2.0f, z, 1.0f };
+			vertex.color = { u, v, 1.0f - u, 1.0f };
+			vertex.textCoords = { u * 4.0f, v * 4.0f };
+		}
+	}
+
+	for (uint32 y = 0; y < cellsY; y++)
+	{
+		for (uint32 x = 0; x < cellsX; x++)
+		{
+			MeshIndex i0 = baseVertex + y * (cellsX + 1) + x;
+			MeshIndex i1 = i0 + 1;
+			MeshIndex i2 = i0 + cellsX + 1;
+			MeshIndex i3 = i2 + 1;
+
+			// clockwise on screen
+			mesh.indices.insert(mesh.indices.end(), { i0, i1, i2, i2, i1, i3 });
+		}
+	}
+}
+
+static double RunCase(const BenchmarkMesh& mesh, const std::vector<uint32>& texels, ESoftwareRasterizerKernel kernel, uint64& outPixels)
+{
+	std::vector<uint32> color((size_t)BENCHMARK_WIDTH * BENCHMARK_HEIGHT);
+	std::vector<float> depth((size_t)BENCHMARK_WIDTH * BENCHMARK_HEIGHT);
+
+	SoftwareRasterizer rasterizer(kernel);
+
+	SoftwareRenderTarget target = { BENCHMARK_WIDTH, BENCHMARK_HEIGHT, BENCHMARK_WIDTH, color.data(), depth.data() };
+	rasterizer.SetRenderTarget(target);
+	rasterizer.SetTexture({ texels.data(), BENCHMARK_TEXTURE_SIZE, BENCHMARK_TEXTURE_SIZE });
+
+	static const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (uint32 frame = 0; frame < BENCHMARK_FRAMES; frame++)
+	{
+		std::fill(depth.begin(), depth.end(), 1.0f);
+		rasterizer.DrawIndexed(identity, mesh.vertices.data(), (uint32)mesh.vertices.size(), mesh.indices.data(), (uint32)mesh.indices.size());
+		rasterizer.Flush();
+	}
+
+	auto end = std::chrono::steady_clock::now();
+
+	outPixels = rasterizer.GetStats().pixelsWritten;
+	return std::chrono::duration<double>(end - start).count();
+}
+
+void BenchmarkSoftwareRasterizer()
+{
+	// tiles run on the job system, it's restarted with every thread count
+	uint32 previousThreadCount = Jobs::IsInitialized() ? Jobs::GetThreadCount() : 0;
+	Jobs::Shutdown();
+
+	std::vector<uint32> texels((size_t)BENCHMARK_TEXTURE_SIZE * BENCHMARK_TEXTURE_SIZE);
+	for (uint32 y = 0; y < BENCHMARK_TEXTURE_SIZE; y++)
+		for (uint32 x = 0; x < BENCHMARK_TEXTURE_SIZE; x++)
+			texels[y * BENCHMARK_TEXTURE_SIZE + x] = ((x / 32 + y / 32) % 2) ? 0xFFFFFFFF : 0xFF808080;
+
+	// small triangles (front end bound) and a few overdraw layers of big ones (fill bound)
+	BenchmarkMesh smallTriangles;
+	BuildGrid(smallTriangles, 320, 180, 0.5f);
+
+	BenchmarkMesh bigTriangles;
+	for (uint32 layer = 0; layer < 4; layer++)
+		BuildGrid(bigTriangles, 16, 9, 0.9f - layer * 0.1f);
+
+	struct BenchmarkCase { const char* name; const BenchmarkMesh* mesh; };
+	BenchmarkCase cases[] = { { "small triangles", &smallTriangles }, { "big triangles, 4x overdraw", &bigTriangles } };
+
+	std::vector<uint32> threadCounts;
+	uint32 hardwareThreads = std::thread::hardware_concurrency();
+	for (uint32 threads = 1; threads < hardwareThreads; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(hardwareThreads ? hardwareThreads : 1);
+
+	ESoftwareRasterizerKernel kernels[] = { SOFTWARE_RASTERIZER_KERNEL_SCALAR, SOFTWARE_RASTERIZER_KERNEL_SSE, SOFTWARE_RASTERIZER_KERNEL_AVX2 };
+
+	fprintf(stdout, "Software rasterizer, %ux%u, %u frames per run\n", BENCHMARK_WIDTH, BENCHMARK_HEIGHT, BENCHMARK_FRAMES);
+
+	for (const BenchmarkCase& benchmarkCase : cases)
+	{
+		uint32 trianglesPerFrame = (uint32)benchmarkCase.mesh->indices.size() / 3;
+		fprintf(stdout, "\n%s (%u triangles per frame)\n", benchmarkCase.name, trianglesPerFrame);
+		fprintf(stdout, "%-8s %8s %12s %14s %14s %9s\n", "kernel", "threads", "ms/frame", "Mtris/s", "Mpixels/s", "speedup");
+
+		for (ESoftwareRasterizerKernel kernel : kernels)
+		{
+			if (!SoftwareRasterizer::IsKernelSupported(kernel))
+				continue;
+
+			double singleThreadTime = 0.0;
+			for (uint32 threads : threadCounts)
+			{
+				Jobs::Init(threads);
+
+				uint64 pixels = 0;
+				double seconds = RunCase(*benchmarkCase.mesh, texels, kernel, pixels);
+				if (threads == 1)
+					singleThreadTime = seconds;
+
+				fprintf
+				(
+					stdout, "%-8s %8u %12.3f %14.2f %14.2f %8.2fx\n",
+					SoftwareRasterizer::GetKernelName(kernel), threads, seconds * 1000.0 / BENCHMARK_FRAMES,
+					(double)trianglesPerFrame * BENCHMARK_FRAMES / seconds / 1000000.0, (double)pixels / seconds / 1000000.0,
+					singleThreadTime / seconds
+				);
+
+				Jobs::Shutdown();
+			}
+		}
+	}
+
+	if (previousThreadCount)
+		Jobs::Init(previousThreadCount);
+}
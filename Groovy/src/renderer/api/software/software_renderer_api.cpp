@@ -0,0 +1,154 @@
+#include "software_renderer_api.h"
+#include "software_buffers.h"
+#include "software_texture.h"
+#include "software_shader.h"
+#include "software_framebuffer.h"
+#include "renderer/renderer.h"
+
+SoftwareRendererAPI* SoftwareRendererAPI::sInstance = nullptr;
+
+SoftwareShader* SoftwareRendererAPI::sBoundShader = nullptr;
+SoftwareVertexBuffer* SoftwareRendererAPI::sBoundVertexBuffer = nullptr;
+SoftwareIndexBuffer* SoftwareRendererAPI::sBoundIndexBuffer = nullptr;
+SoftwareFrameBuffer* SoftwareRendererAPI::sBoundFrameBuffer = nullptr;
+SoftwareConstBuffer* SoftwareRendererAPI::sBoundVertexConstBuffers[SOFTWARE_RENDERER_MAX_BIND_SLOTS] = {};
+SoftwareConstBuffer* SoftwareRendererAPI::sBoundPixelConstBuffers[SOFTWARE_RENDERER_MAX_BIND_SLOTS] = {};
+SoftwareTexture* SoftwareRendererAPI::sBoundTextures[SOFTWARE_RENDERER_MAX_BIND_SLOTS] = {};
+
+static void MultiplyMatrices(const float* a, const float* b, float* out)
+{
+	for (uint32 row = 0; row < 4; row++)
+		for (uint32 col = 0; col < 4; col++)
+			out[row * 4 + col] = a[row * 4 + 0] * b[0 * 4 + col] + a[row * 4 + 1] * b[1 * 4 + col] + a[row * 4 + 2] * b[2 * 4 + col] + a[row * 4 + 3] * b[3 * 4 + col];
+}
+
+SoftwareRendererAPI::SoftwareRendererAPI(RendererAPISpec spec)
+	: mSpec(spec)
+{
+	mRasterizerState.fillMode = RASTERIZER_FILL_MODE_SOLID;
+	mRasterizerState.cullMode = RASTERIZER_CULL_MODE_BACK;
+
+	mRasterizer = new SoftwareRasterizer();
+	mRasterizer->SetRasterizerState(mRasterizerState);
+
+	GROOVY_LOG_INFO
+	(
+		"Software renderer: %u threads, %s kernel",
+		mRasterizer->GetThreadCount(), SoftwareRasterizer::GetKernelName(mRasterizer->GetKernel())
+	);
+
+	sInstance = this;
+}
+
+SoftwareRendererAPI::~SoftwareRendererAPI()
+{
+	mRasterizer->Flush();
+	delete mRasterizer;
+
+	sBoundShader = nullptr;
+	sBoundVertexBuffer = nullptr;
+	sBoundIndexBuffer = nullptr;
+	sBoundFrameBuffer = nullptr;
+	for (uint32 i = 0; i < SOFTWARE_RENDERER_MAX_BIND_SLOTS; i++)
+	{
+		sBoundVertexConstBuffers[i] = nullptr;
+		sBoundPixelConstBuffers[i] = nullptr;
+		sBoundTextures[i] = nullptr;
+	}
+
+	sInstance = nullptr;
+}
+
+void SoftwareRendererAPI::DrawIndexed(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount)
+{
+	DrawIndexedInstanced(vertexOffset, indexOffset, indexCount, 1);
+}
+
+void SoftwareRendererAPI::DrawIndexedInstanced(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount, uint32 instanceCount)
+{
+	// no swapchain, nothing to draw into
+	if (!sBoundFrameBuffer)
+		return;
+
+	checkslowf(sBoundVertexBuffer && sBoundIndexBuffer, "Draw call without vertex or index buffer bound");
+	checkslowf(sBoundVertexBuffer->GetStride() == sizeof(MeshVertex), "Software renderer only supports the MeshVertex layout");
+
+	uint32 vertexCount = (uint32)(sBoundVertexBuffer->GetSize() / sizeof(MeshVertex));
+	uint32 totalIndexCount = (uint32)(sBoundIndexBuffer->GetSize() / sizeof(MeshIndex));
+	if (vertexOffset >= vertexCount || indexOffset + indexCount > totalIndexCount)
+		return;
+
+	mRasterizer->SetRenderTarget(sBoundFrameBuffer->GetRenderTarget());
+
+	// const buffers hold transposed matrices (hlsl packing), as row major arrays they are already clip = matrix * position
+	static const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+	const SoftwareConstBuffer* viewProjBuffer = sBoundVertexConstBuffers[VIEW_PROJECTION_BUFFER_INDEX];
+	const SoftwareConstBuffer* modelBuffer = sBoundVertexConstBuffers[MODEL_BUFFER_INDEX];
+	const float* viewProj = viewProjBuffer && viewProjBuffer->GetSize() >= sizeof(identity) ? (const float*)viewProjBuffer->GetData().data() : identity;
+
+	mRasterizer->SetTexture(sBoundTextures[0] ? sBoundTextures[0]->GetView() : SoftwareTextureView());
+
+	const MeshVertex* vertices = (const MeshVertex*)sBoundVertexBuffer->GetData().data();
+	const MeshIndex* indices = (const MeshIndex*)sBoundIndexBuffer->GetData().data();
+
+	// one model matrix per instance, one after the other
+	for (uint32 instance = 0; instance < instanceCount; instance++)
+	{
+		size_t modelEnd = (instance + 1) * sizeof(identity);
+		const float* model = modelBuffer && modelBuffer->GetSize() >= modelEnd ? (const float*)modelBuffer->GetData().data() + instance * 16 : identity;
+
+		float clipFromObject[16];
+		MultiplyMatrices(viewProj, model, clipFromObject);
+
+		mRasterizer->DrawIndexed(clipFromObject, vertices + vertexOffset, vertexCount - vertexOffset, indices + indexOffset, indexCount);
+	}
+}
+
+void SoftwareRendererAPI::Present()
+{
+	mRasterizer->Flush();
+}
+
+void SoftwareRendererAPI::SetFullscreen(bool fullscreen)
+{
+}
+
+void SoftwareRendererAPI::SetVSync(uint32 syncInterval)
+{
+	mSpec.vsync = syncInterval;
+}
+
+void SoftwareRendererAPI::SetRasterizerState(RasterizerState newState)
+{
+	mRasterizerState = newState;
+	mRasterizer->SetRasterizerState(newState);
+}
+
+void SoftwareRendererAPI::__internal_FlushPendingWork()
+{
+	if (sInstance)
+		sInstance->mRasterizer->Flush();
+}
+
+void SoftwareRendererAPI::__internal_Unbind(const void* resource)
+{
+	if (sBoundShader == resource)
+		sBoundShader = nullptr;
+	if (sBoundVertexBuffer == resource)
+		sBoundVertexBuffer = nullptr;
+	if (sBoundIndexBuffer == resource)
+		sBoundIndexBuffer = nullptr;
+	if (sBoundFrameBuffer == resource)
+		sBoundFrameBuffer = nullptr;
+
+	for (uint32 i = 0; i < SOFTWARE_RENDERER_MAX_BIND_SLOTS; i++)
+	{
+		if (sBoundVertexConstBuffers[i] == resource)
+			sBoundVertexConstBuffers[i] = nullptr;
+		if (sBoundPixelConstBuffers[i] == resource)
+			sBoundPixelConstBuffers[i] = nullptr;
+		if (sBoundTextures[i] == resource)
+			sBoundTextures[i] = nullptr;
+	}
+}
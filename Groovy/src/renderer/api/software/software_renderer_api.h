@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../renderer_api.h"
+#include "software_rasterizer.h"
+
+#define SOFTWARE_RENDERER_MAX_BIND_SLOTS 16
+
+/*
+	Renderer api running on the cpu, draws go through the SoftwareRasterizer into the bound SoftwareFrameBuffer.
+	Every shader behaves like the default shader (texture in slot 0 times vertex color,
+	view projection and per instance model matrices in vertex const buffer slots 0 and 1).
+	There is no swapchain, frame buffers live in memory and GetRendererID returns their pixels.
+*/
+class CORE_API SoftwareRendererAPI : public RendererAPI
+{
+public:
+	SoftwareRendererAPI(RendererAPISpec spec);
+	virtual ~SoftwareRendererAPI();
+
+	virtual void DrawIndexed(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount) override;
+	virtual void DrawIndexedInstanced(uint32 vertexOffset, uint32 indexOffset, uint32 indexCount, uint32 instanceCount) override;
+	virtual void Present() override;
+	virtual void SetFullscreen(bool fullscreen) override;
+	virtual void SetVSync(uint32 syncInterval) override;
+	virtual RendererAPISpec GetSpec() const override { return mSpec; }
+	virtual RasterizerState GetRasterizerState() const override { return mRasterizerState; }
+	virtual void SetRasterizerState(RasterizerState newState) override;
+
+	SoftwareRasterizer& GetRasterizer() { return *mRasterizer; }
+
+	// nullptr when another renderer api is selected
+	static SoftwareRendererAPI* GetInstance() { return sInstance; }
+
+	// for internal use, resources call these before their memory changes or goes away
+	static void __internal_FlushPendingWork();
+	static void __internal_Unbind(const void* resource);
+
+	// currently bound resources
+	static class SoftwareShader* sBoundShader;
+	static class SoftwareVertexBuffer* sBoundVertexBuffer;
+	static class SoftwareIndexBuffer* sBoundIndexBuffer;
+	static class SoftwareFrameBuffer* sBoundFrameBuffer;
+	static class SoftwareConstBuffer* sBoundVertexConstBuffers[SOFTWARE_RENDERER_MAX_BIND_SLOTS];
+	static class SoftwareConstBuffer* sBoundPixelConstBuffers[SOFTWARE_RENDERER_MAX_BIND_SLOTS];
+	static class SoftwareTexture* sBoundTextures[SOFTWARE_RENDERER_MAX_BIND_SLOTS];
+
+private:
+	RendererAPISpec mSpec;
+	RasterizerState mRasterizerState;
+	SoftwareRasterizer* mRasterizer;
+
+	static SoftwareRendererAPI* sInstance;
+};
@@ -0,0 +1,48 @@
+#include "software_shader.h"
+#include "software_renderer_api.h"
+#include "renderer/renderer.h"
+
+SoftwareShader::SoftwareShader(const void* vertexSrc, size_t vertexSize, const void* pixelSrc, size_t pixelSize)
+	: mUUID(0)
+{
+	// same layout as shaders/default_shader.hlsl
+	ConstBufferDesc& viewProj = mVertexConstBuffersDesc.emplace_back();
+	viewProj.name = "ViewProjBuffer";
+	viewProj.size = 64;
+	viewProj.variables.push_back({ "vp", 64, 0, SHADER_VARIABLE_TYPE_FLOAT4X4 });
+
+	ConstBufferDesc& model = mVertexConstBuffersDesc.emplace_back();
+	model.name = "ModelBuffer";
+	model.size = 64 * RENDERER_MAX_INSTANCES_PER_DRAW;
+	model.variables.push_back({ "m", 64 * RENDERER_MAX_INSTANCES_PER_DRAW, 0, SHADER_VARIABLE_TYPE_FLOAT4X4 });
+
+	mResTextures.push_back({ "albedo", 0 });
+}
+
+SoftwareShader::~SoftwareShader()
+{
+	SoftwareRendererAPI::__internal_Unbind(this);
+}
+
+void SoftwareShader::Bind()
+{
+	SoftwareRendererAPI::sBoundShader = this;
+}
+
+uint32 SoftwareShader::GetVertexConstBufferIndex(const std::string& bufferName)
+{
+	for (uint32 i = 0; i < mVertexConstBuffersDesc.size(); i++)
+		if (mVertexConstBuffersDesc[i].name == bufferName)
+			return i;
+	return ~((uint32)0);
+}
+
+uint32 SoftwareShader::GetPixelConstBufferIndex(const std::string& bufferName)
+{
+	return ~((uint32)0);
+}
+
+void SoftwareShader::OverwritePixelConstBuffer(uint32 index, void* data)
+{
+	checkslowf(index < mPixelConstBuffersDesc.size(), "Pixel const buffer index out of range");
+}
@@ -0,0 +1,46 @@
+#include "software_texture.h"
+#include "software_renderer_api.h"
+
+SoftwareTexture::SoftwareTexture(TextureSpec specs, const void* data, size_t size)
+	: mSpecs(specs), mUUID(0)
+{
+	if (data && size)
+		SetData((void*)data, size);
+}
+
+SoftwareTexture::~SoftwareTexture()
+{
+	// pending draws may still sample from us
+	SoftwareRendererAPI::__internal_FlushPendingWork();
+	SoftwareRendererAPI::__internal_Unbind(this);
+}
+
+void SoftwareTexture::Bind(uint32 slot)
+{
+	check(slot < SOFTWARE_RENDERER_MAX_BIND_SLOTS);
+	SoftwareRendererAPI::sBoundTextures[slot] = this;
+}
+
+void SoftwareTexture::SetData(void* data, size_t size)
+{
+	SoftwareRendererAPI::__internal_FlushPendingWork();
+
+	if (mData.size() != size)
+		mData.resize(size);
+
+	memcpy(mData.data(), data, size);
+}
+
+SoftwareTextureView SoftwareTexture::GetView() const
+{
+	SoftwareTextureView view = {};
+
+	if (mSpecs.format == COLOR_FORMAT_R8G8B8A8_UNORM && mSpecs.width && mSpecs.height && mData.size() >= (size_t)mSpecs.width * mSpecs.height * 4)
+	{
+		view.texels = (const uint32*)mData.data();
+		view.width = mSpecs.width;
+		view.height = mSpecs.height;
+	}
+
+	return view;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../texture.h"
+#include "software_rasterizer.h"
+
+class SoftwareTexture : public Texture
+{
+public:
+	SoftwareTexture(TextureSpec specs, const void* data, size_t size);
+	virtual ~SoftwareTexture();
+
+	virtual void __internal_SetUUID(AssetUUID uuid) override { mUUID = uuid; }
+	virtual AssetUUID GetUUID() const override { return mUUID; }
+
+	virtual void Bind(uint32 slot) override;
+	virtual void* GetRendererID() const override { return (void*)mData.data(); }
+	virtual void SetData(void* data, size_t size) override;
+	virtual TextureSpec GetSpecs() const override { return mSpecs; }
+
+	// empty view (samples white) when the format can't be sampled
+	SoftwareTextureView GetView() const;
+
+private:
+	TextureSpec mSpecs;
+	Buffer mData;
+
+	AssetUUID mUUID;
+};
@@ -2,6 +2,8 @@
 #include "renderer_api.h"
 
 #include "d3d11/d3d11_texture.h"
+#include "null/null_texture.h"
+#include "software/software_texture.h"
 
 Texture* Texture::Create(TextureSpec specs, const void* data, size_t size)
 {
@@ -10,6 +12,9 @@ Texture* Texture::Create(TextureSpec specs, const void* data, size_t size)
 #if PLATFORM_WIN32
         case RENDERER_API_D3D11:    return new D3D11Texture(specs, data, size);
 #endif
+        case RENDERER_API_NULL:     return new NullTexture(specs, data, size);
+        case RENDERER_API_SOFTWARE: return new SoftwareTexture(specs, data, size);
+        default:                    break;
     }
     checkslow("?!?");
     return nullptr;
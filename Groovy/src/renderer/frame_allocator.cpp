@@ -0,0 +1,178 @@
+#include "frame_allocator.h"
+
+#include <new>
+#include <stdlib.h>
+
+// blocks allocated when the main one is full, freed at the next reset
+struct FrameAllocatorOverflowBlock
+{
+	FrameAllocatorOverflowBlock* next;
+	size_t size;
+};
+
+static byte* sBlock = nullptr;
+static size_t sCapacity = 0;
+static size_t sOffset = 0;
+
+static FrameAllocatorOverflowBlock* sOverflowBlocks = nullptr;
+// bytes handed out from overflow blocks this frame
+static size_t sOverflowUsed = 0;
+
+static size_t sPeak = 0;
+static uint32 sHeapAllocations = 0;
+
+#if FRAME_ALLOCATOR_COUNT_SUBMISSION_ALLOCATIONS
+
+// the submitting thread only, job threads and asset loads allocate on their own
+static thread_local bool sInSubmission = false;
+static uint32 sSubmissionHeapAllocations = 0;
+
+void* operator new(size_t size)
+{
+	if (sInSubmission)
+		sSubmissionHeapAllocations++;
+
+	if (void* ptr = malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+#endif
+
+static size_t AlignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static byte* AllocateBlock(size_t size)
+{
+	sHeapAllocations++;
+	return (byte*)operator new(size, std::align_val_t(FRAME_ALLOCATOR_DEFAULT_ALIGNMENT));
+}
+
+static void FreeBlock(void* block)
+{
+	operator delete(block, std::align_val_t(FRAME_ALLOCATOR_DEFAULT_ALIGNMENT));
+}
+
+void FrameAllocator::Init(size_t capacity)
+{
+	checkf(!sBlock, "Frame allocator already initialized");
+
+	sCapacity = AlignUp(capacity, FRAME_ALLOCATOR_DEFAULT_ALIGNMENT);
+	sBlock = AllocateBlock(sCapacity);
+	sOffset = 0;
+}
+
+void FrameAllocator::Shutdown()
+{
+	Reset();
+
+	FreeBlock(sBlock);
+	sBlock = nullptr;
+	sCapacity = 0;
+}
+
+void* FrameAllocator::Alloc(size_t size, size_t alignment)
+{
+	checkslowf(alignment <= FRAME_ALLOCATOR_DEFAULT_ALIGNMENT && (alignment & (alignment - 1)) == 0, "Unsupported frame allocator alignment");
+
+	size_t offset = AlignUp(sOffset, alignment);
+	if (offset + size <= sCapacity)
+	{
+		sOffset = offset + size;
+		return sBlock + offset;
+	}
+
+	// full, the allocation gets its own block until the next reset. the header keeps the data aligned
+	const size_t headerSize = AlignUp(sizeof(FrameAllocatorOverflowBlock), FRAME_ALLOCATOR_DEFAULT_ALIGNMENT);
+
+	FrameAllocatorOverflowBlock* block = (FrameAllocatorOverflowBlock*)AllocateBlock(headerSize + size);
+	block->next = sOverflowBlocks;
+	block->size = size;
+	sOverflowBlocks = block;
+	sOverflowUsed += AlignUp(size, FRAME_ALLOCATOR_DEFAULT_ALIGNMENT);
+
+	return (byte*)block + headerSize;
+}
+
+void FrameAllocator::Reset()
+{
+	size_t used = sOffset + sOverflowUsed;
+	if (used > sPeak)
+		sPeak = used;
+
+	if (sOverflowBlocks)
+	{
+		while (sOverflowBlocks)
+		{
+			FrameAllocatorOverflowBlock* next = sOverflowBlocks->next;
+			FreeBlock(sOverflowBlocks);
+			sOverflowBlocks = next;
+		}
+
+		// one block for the whole frame next time, with some room to grow
+		size_t newCapacity = AlignUp(used + used / 2, FRAME_ALLOCATOR_DEFAULT_ALIGNMENT);
+		GROOVY_LOG_WARN("Frame allocator out of memory (%zu bytes used, %zu capacity), growing to %zu bytes", used, sCapacity, newCapacity);
+
+		FreeBlock(sBlock);
+		sCapacity = newCapacity;
+		sBlock = AllocateBlock(sCapacity);
+	}
+
+	sOffset = 0;
+	sOverflowUsed = 0;
+}
+
+size_t FrameAllocator::GetUsed()
+{
+	return sOffset + sOverflowUsed;
+}
+
+size_t FrameAllocator::GetCapacity()
+{
+	return sCapacity;
+}
+
+size_t FrameAllocator::GetPeak()
+{
+	return sPeak > GetUsed() ? sPeak : GetUsed();
+}
+
+uint32 FrameAllocator::GetHeapAllocationsCount()
+{
+	return sHeapAllocations;
+}
+
+void FrameAllocator::BeginSubmission()
+{
+#if FRAME_ALLOCATOR_COUNT_SUBMISSION_ALLOCATIONS
+	sInSubmission = true;
+#endif
+}
+
+void FrameAllocator::EndSubmission()
+{
+#if FRAME_ALLOCATOR_COUNT_SUBMISSION_ALLOCATIONS
+	sInSubmission = false;
+#endif
+}
+
+uint32 FrameAllocator::GetSubmissionHeapAllocationsCount()
+{
+#if FRAME_ALLOCATOR_COUNT_SUBMISSION_ALLOCATIONS
+	return sSubmissionHeapAllocations;
+#else
+	return 0;
+#endif
+}
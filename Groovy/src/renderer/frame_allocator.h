@@ -0,0 +1,52 @@
+#pragma once
+
+#include "core/core.h"
+
+#define FRAME_ALLOCATOR_DEFAULT_CAPACITY (1024 * 1024)
+// also the biggest alignment supported
+#define FRAME_ALLOCATOR_DEFAULT_ALIGNMENT 16
+// debug builds replace the global operator new to count what render submission allocates
+#define FRAME_ALLOCATOR_COUNT_SUBMISSION_ALLOCATIONS BUILD_DEBUG
+
+/*
+	Linear allocator for data that only lives for the current frame (render submission), main thread only.
+	Memory is handed out by bumping an offset and released all at once by Reset (Renderer::Present).
+	If a frame needs more than the capacity, extra blocks are allocated and the next Reset replaces everything
+	with one block big enough, frames of the same size then never touch the heap.
+
+	usage:
+	Mat4* models = FrameAllocator::Alloc<Mat4>(count);
+	(no constructors or destructors are called, only use it for trivial types)
+*/
+class CORE_API FrameAllocator
+{
+public:
+	static void Init(size_t capacity = FRAME_ALLOCATOR_DEFAULT_CAPACITY);
+	static void Shutdown();
+
+	static void* Alloc(size_t size, size_t alignment = FRAME_ALLOCATOR_DEFAULT_ALIGNMENT);
+
+	template<typename T>
+	static T* Alloc(uint32 count)
+	{
+		static_assert(alignof(T) <= FRAME_ALLOCATOR_DEFAULT_ALIGNMENT, "Type alignment not supported by the frame allocator");
+		return (T*)Alloc(sizeof(T) * count, alignof(T));
+	}
+
+	static void Reset();
+
+	// bytes allocated this frame
+	static size_t GetUsed();
+	static size_t GetCapacity();
+	// biggest frame so far
+	static size_t GetPeak();
+	// blocks taken from the heap since Init, stops growing once frames look alike. a growing count in steady state is a regression
+	static uint32 GetHeapAllocationsCount();
+
+	// SceneRenderer::BeginScene to Renderer::Present. any operator new on the calling thread in between is counted (debug builds only),
+	// submission shouldn't allocate once frames look alike
+	static void BeginSubmission();
+	static void EndSubmission();
+	// since Init, always 0 when not counted
+	static uint32 GetSubmissionHeapAllocationsCount();
+};
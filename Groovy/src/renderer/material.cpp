@@ -18,6 +18,14 @@ void Material::Load()
 	mLoaded = true;
 }
 
+void Material::Unload()
+{
+	mShader = nullptr;
+	mResources.clear();
+	mConstBuffersData.resize(0);
+	mLoaded = false;
+}
+
 void Material::Save()
 {
 	AssetSerializer::SerializeGenericAsset(this);
@@ -154,9 +162,11 @@ void Material::Serialize(DynamicBuffer& fileData) const
 
 void Material::Deserialize(BufferView fileData)
 {
+	GROOVY_PROFILE_FUNCTION();
+
 	MaterialAssetFile asset;
 	PropertyPack matAssetPropPack;
-	ObjectSerializer::DeserializePropertyPack(MaterialAssetFile::StaticClass(), fileData, matAssetPropPack);
+	ObjectSerializer::DeserializePropertyPack(MaterialAssetFile::StaticClass(), fileData, matAssetPropPack, true);
 	ObjectSerializer::DeserializePropertyPackData(matAssetPropPack, &asset);
 
 	// shader
@@ -182,7 +192,7 @@ void Material::Deserialize(BufferView fileData)
 			res.res = DEFAULT_TEXTURE;
 
 	// const buffers data
-	if (mConstBuffersData.size() == mConstBuffersData.size())
+	if (mConstBuffersData.size() == asset.constBuffersData.size())
 	{
 		memcpy(mConstBuffersData.data(), asset.constBuffersData.data(), asset.constBuffersData.size());
 	}
@@ -24,6 +24,7 @@ public:
 	AssetUUID GetUUID() const override { return mUUID; }
 	virtual bool IsLoaded() const override { return mLoaded; }
 	virtual void Load() override;
+	virtual void Unload() override;
 	virtual void Save() override;
 
 #if WITH_EDITOR
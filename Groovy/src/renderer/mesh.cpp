@@ -1,16 +1,18 @@
 #include "mesh.h"
 #include "classes/object_serializer.h"
 #include "assets/assets.h"
+#include "core/jobs.h"
+#include "utils/mesh_utils.h"
 
 extern Material* DEFAULT_MATERIAL;
 
 Mesh::Mesh()
-	: mVertexBuffer(nullptr), mIndexBuffer(nullptr), mUUID(0), mLoaded(false)
+	: mVertexBuffer(nullptr), mIndexBuffer(nullptr), mBoundingBox(), mBoundingSphere(), mGeometryFileSize(0), mRenderVersion(0), mUUID(0), mLoaded(false)
 {
 }
 
 Mesh::Mesh(VertexBuffer* v, IndexBuffer* i, const std::vector<SubmeshData>& s, const std::vector<Material*>& m)
-	: mVertexBuffer(v), mIndexBuffer(i), mSubmeshes(s), mMaterials(m), mUUID(0), mLoaded(false)
+	: mVertexBuffer(v), mIndexBuffer(i), mSubmeshes(s), mMaterials(m), mBoundingBox(), mBoundingSphere(), mGeometryFileSize(0), mRenderVersion(0), mUUID(0), mLoaded(false)
 {
 }
 
@@ -26,11 +28,33 @@ void Mesh::Load()
 	mLoaded = true;
 }
 
+void Mesh::Unload()
+{
+	delete mVertexBuffer;
+	delete mIndexBuffer;
+	mVertexBuffer = nullptr;
+	mIndexBuffer = nullptr;
+	mSubmeshes.clear();
+	mMaterials.clear();
+	mLODScreenSizes.clear();
+	mRenderVersion++;
+	mLoaded = false;
+}
+
 void Mesh::Save()
 {
 	AssetSerializer::SerializeMesh(this);
 }
 
+uint32 Mesh::SelectLOD(float screenSize) const
+{
+	for (uint32 lod = 0; lod < mLODScreenSizes.size(); lod++)
+		if (screenSize >= mLODScreenSizes[lod])
+			return lod;
+
+	return GetLODCount() - 1;
+}
+
 #if WITH_EDITOR
 
 bool Mesh::Editor_FixDependencyDeletion(AssetHandle assetToBeDeleted)
@@ -47,6 +71,8 @@ bool Mesh::Editor_FixDependencyDeletion(AssetHandle assetToBeDeleted)
 				found = true;
 			}
 		}
+		if (found)
+			mRenderVersion++;
 		return found;
 	}
 	return false;
@@ -59,6 +85,7 @@ void Mesh::Serialize(DynamicBuffer& fileData) const
 	MeshAssetFile asset;
 	asset.materials = mMaterials;
 	asset.submeshes = mSubmeshes;
+	asset.lodScreenSizes = mLODScreenSizes;
 
 	PropertyPack meshAssetPropPack;
 	ObjectSerializer::CreatePropertyPack(&asset, MeshAssetFile::StaticCDO(), meshAssetPropPack);
@@ -67,22 +94,48 @@ void Mesh::Serialize(DynamicBuffer& fileData) const
 
 void Mesh::Deserialize(BufferView fileData)
 {
-	MeshAssetHeader header = fileData.read<MeshAssetHeader>();
-	// geometry data
-	mVertexBuffer = VertexBuffer::Create(header.vertexBufferSize, fileData.read(header.vertexBufferSize), sizeof(MeshVertex));
-	mIndexBuffer = IndexBuffer::Create(header.indexBufferSize, fileData.read(header.indexBufferSize));
+	GROOVY_PROFILE_FUNCTION();
+
+	// geometry data, unpacked if needed. buffers are created on the main thread (assets load on job threads)
+	MeshGeometry geometry;
+	if (!meshUtils::ReadGeometry(fileData, geometry))
+	{
+		// stays loaded without buffers or submeshes, the renderer skips it
+		GROOVY_LOG_ERR("Mesh %llu has an unsupported asset format", (unsigned long long)mUUID);
+		return;
+	}
+	mGeometryFileSize = geometry.fileSize;
+
+	mBoundingBox = geometry.box;
+	mBoundingSphere = geometry.sphere;
+
+	Jobs::CallOnMainThread([&]()
+	{
+		mVertexBuffer = VertexBuffer::Create(geometry.vertexCount * sizeof(MeshVertex), geometry.vertices, sizeof(MeshVertex));
+		mIndexBuffer = IndexBuffer::Create(geometry.indexCount * sizeof(MeshIndex), geometry.indices);
+	});
 	// submeshes and materials
 	MeshAssetFile asset;
 	PropertyPack meshAssetPropPack;
-	ObjectSerializer::DeserializePropertyPack(MeshAssetFile::StaticClass(), fileData, meshAssetPropPack);
+	ObjectSerializer::DeserializePropertyPack(MeshAssetFile::StaticClass(), fileData, meshAssetPropPack, true);
 	ObjectSerializer::DeserializePropertyPackData(meshAssetPropPack, &asset);
 	mSubmeshes = asset.submeshes;
 	mMaterials = asset.materials;
+	mLODScreenSizes = asset.lodScreenSizes;
+
+	if (mLODScreenSizes.size() && mSubmeshes.size() != mMaterials.size() * mLODScreenSizes.size())
+	{
+		GROOVY_LOG_WARN("Mesh %llu has %u submeshes for %u materials and %u lods, lods ignored", (unsigned long long)mUUID, (uint32)mSubmeshes.size(), (uint32)mMaterials.size(), (uint32)mLODScreenSizes.size());
+		mSubmeshes.resize(mMaterials.size());
+		mLODScreenSizes.clear();
+	}
 
 	for (Material* mat : mMaterials)
 		if (!mat)
 			mat = DEFAULT_MATERIAL;
 
+	// proxies of components that got this mesh before it finished loading pick it up now
+	mRenderVersion++;
 }
 
 IMPL_PROPERTY_TYPE(SubmeshData, PROPERTY_TYPE_INTERNAL_SUBMESHDATA)
@@ -90,4 +143,5 @@ IMPL_PROPERTY_TYPE(SubmeshData, PROPERTY_TYPE_INTERNAL_SUBMESHDATA)
 GROOVY_CLASS_IMPL(MeshAssetFile)
 	GROOVY_REFLECT(materials)
 	GROOVY_REFLECT(submeshes)
+	GROOVY_REFLECT(lodScreenSizes)
 GROOVY_CLASS_END()
\ No newline at end of file
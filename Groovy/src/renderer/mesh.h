@@ -1,7 +1,7 @@
 #pragma once
 
 #include "api/buffers.h"
-#include "math/vector.h"
+#include "math/bounds.h"
 #include "assets/asset.h"
 #include "material.h"
 
@@ -33,27 +33,45 @@ public:
 	AssetUUID GetUUID() const override { return mUUID; }
 	virtual bool IsLoaded() const override { return mLoaded; }
 	virtual void Load() override;
+	virtual void Unload() override;
 	virtual void Save() override;
 
 #if WITH_EDITOR
 	virtual bool Editor_FixDependencyDeletion(AssetHandle assetToBeDeleted) override;
 #endif
 
-	size_t GetVertexBufferSize() const { return mVertexBuffer->GetSize(); }
-	size_t GetIndexBufferSize() const { return mIndexBuffer->GetSize(); }
+	size_t GetVertexBufferSize() const { return mVertexBuffer ? mVertexBuffer->GetSize() : 0; }
+	size_t GetIndexBufferSize() const { return mIndexBuffer ? mIndexBuffer->GetSize() : 0; }
 
+	// lod major: every lod has one submesh per material
 	const std::vector<SubmeshData>& GetSubmeshes() const { return mSubmeshes; }
 	const std::vector<Material*>& GetMaterials() const { return mMaterials; }
 
-	void SetMaterial(Material* mat, uint32 index) { check(index < mMaterials.size()); mMaterials[index] = mat; }
+	uint32 GetLODCount() const { return mLODScreenSizes.empty() ? 1 : (uint32)mLODScreenSizes.size(); }
+	// smallest screen size (bounding sphere diameter / screen height) each lod is drawn at
+	const std::vector<float>& GetLODScreenSizes() const { return mLODScreenSizes; }
+	uint32 SelectLOD(float screenSize) const;
 
-	size_t GetAssetOffsetForSerialization() const { return sizeof(MeshAssetHeader) + mVertexBuffer->GetSize() + mIndexBuffer->GetSize(); }
+	// local space bounds, from the asset header
+	const BoundingBox& GetBoundingBox() const { return mBoundingBox; }
+	const BoundingSphere& GetBoundingSphere() const { return mBoundingSphere; }
+	void __internal_SetBounds(const BoundingBox& box, const BoundingSphere& sphere) { mBoundingBox = box; mBoundingSphere = sphere; mRenderVersion++; }
+
+	void SetMaterial(Material* mat, uint32 index) { check(index < mMaterials.size()); mMaterials[index] = mat; mRenderVersion++; }
+
+	// changes every time the materials, bounds or geometry change, render proxies built from an older version get refreshed
+	uint32 GetRenderVersion() const { return mRenderVersion; }
+
+	// geometry is stored packed, the file offset doesn't match the buffer sizes
+	size_t GetAssetOffsetForSerialization() const { return mGeometryFileSize; }
 	virtual void Serialize(DynamicBuffer& fileData) const override;
 	virtual void Deserialize(BufferView fileData) override;
 
 #if WITH_EDITOR
 
+	// call Editor_OnMaterialsChanged after editing them
 	std::vector<Material*>& Editor_MaterialsRef() { return mMaterials; }
+	void Editor_OnMaterialsChanged() { mRenderVersion++; }
 
 #endif
 
@@ -62,6 +80,12 @@ private:
 	IndexBuffer* mIndexBuffer;
 	std::vector<SubmeshData> mSubmeshes;
 	std::vector<Material*> mMaterials;
+	std::vector<float> mLODScreenSizes;
+	BoundingBox mBoundingBox;
+	BoundingSphere mBoundingSphere;
+	// header + vertices + indices in the asset file
+	size_t mGeometryFileSize;
+	uint32 mRenderVersion;
 
 	AssetUUID mUUID;
 	bool mLoaded;
@@ -75,4 +99,6 @@ class CORE_API MeshAssetFile : public GroovyObject
 public:
 	std::vector<Material*> materials;
 	std::vector<SubmeshData> submeshes;
+	// empty when the mesh has a single lod
+	std::vector<float> lodScreenSizes;
 };
\ No newline at end of file
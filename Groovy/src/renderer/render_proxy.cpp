@@ -0,0 +1,186 @@
+#include "render_proxy.h"
+#include "mesh.h"
+#include "math/math.h"
+#include "gameframework/components/mesh_component.h"
+
+RenderProxies::RenderProxies()
+	: mUnusedMaterials(0)
+{
+}
+
+uint32 RenderProxies::Add(MeshComponent* meshComp)
+{
+	check(meshComp);
+
+	uint32 proxy = GetCount();
+
+	mOwners.push_back(meshComp);
+	mMeshes.push_back(nullptr);
+	mMeshVersions.push_back(0);
+	mVisible.push_back(0);
+	mModels.push_back(Mat4());
+	mSpheres.push_back({});
+	mCenterX.push_back(0.0f);
+	mCenterY.push_back(0.0f);
+	mCenterZ.push_back(0.0f);
+	mExtentX.push_back(0.0f);
+	mExtentY.push_back(0.0f);
+	mExtentZ.push_back(0.0f);
+	mMaterialOffsets.push_back((uint32)mMaterials.size());
+	mMaterialCounts.push_back(0);
+
+	meshComp->mRenderProxy = proxy;
+	Update(proxy);
+
+	return proxy;
+}
+
+void RenderProxies::Remove(uint32 proxy)
+{
+	check(proxy < GetCount());
+
+	mOwners[proxy]->mRenderProxy = INVALID_RENDER_PROXY;
+	mUnusedMaterials += mMaterialCounts[proxy];
+
+	// the last proxy takes the removed one's place
+	uint32 last = GetCount() - 1;
+	if (proxy != last)
+	{
+		mOwners[proxy] = mOwners[last];
+		mMeshes[proxy] = mMeshes[last];
+		mMeshVersions[proxy] = mMeshVersions[last];
+		mVisible[proxy] = mVisible[last];
+		mModels[proxy] = mModels[last];
+		mSpheres[proxy] = mSpheres[last];
+		mCenterX[proxy] = mCenterX[last];
+		mCenterY[proxy] = mCenterY[last];
+		mCenterZ[proxy] = mCenterZ[last];
+		mExtentX[proxy] = mExtentX[last];
+		mExtentY[proxy] = mExtentY[last];
+		mExtentZ[proxy] = mExtentZ[last];
+		mMaterialOffsets[proxy] = mMaterialOffsets[last];
+		mMaterialCounts[proxy] = mMaterialCounts[last];
+
+		mOwners[proxy]->mRenderProxy = proxy;
+	}
+
+	mOwners.pop_back();
+	mMeshes.pop_back();
+	mMeshVersions.pop_back();
+	mVisible.pop_back();
+	mModels.pop_back();
+	mSpheres.pop_back();
+	mCenterX.pop_back();
+	mCenterY.pop_back();
+	mCenterZ.pop_back();
+	mExtentX.pop_back();
+	mExtentY.pop_back();
+	mExtentZ.pop_back();
+	mMaterialOffsets.pop_back();
+	mMaterialCounts.pop_back();
+
+	if (mOwners.empty())
+	{
+		mMaterials.clear();
+		mUnusedMaterials = 0;
+	}
+}
+
+void RenderProxies::Update(uint32 proxy)
+{
+	check(proxy < GetCount());
+
+	MeshComponent* meshComp = mOwners[proxy];
+	Mesh* mesh = meshComp->mMesh;
+
+	mMeshes[proxy] = mesh;
+	mMeshVersions[proxy] = mesh ? mesh->GetRenderVersion() : 0;
+	mVisible[proxy] = meshComp->mVisible && mesh ? 1 : 0;
+
+	ResolveMaterials(proxy);
+	UpdateTransform(proxy);
+}
+
+void RenderProxies::UpdateTransform(uint32 proxy)
+{
+	check(proxy < GetCount());
+
+	MeshComponent* meshComp = mOwners[proxy];
+	Mesh* mesh = mMeshes[proxy];
+
+	const Mat4& model = meshComp->GetWorldMatrix();
+
+	// bounds are only read for proxies with a mesh
+	if (mesh)
+	{
+		Vec3 center, extents;
+		math::TransformBoundingBox(mesh->GetBoundingBox(), model, center, extents);
+
+		mSpheres[proxy] = math::TransformBoundingSphere(mesh->GetBoundingSphere(), model);
+		mCenterX[proxy] = center.x;
+		mCenterY[proxy] = center.y;
+		mCenterZ[proxy] = center.z;
+		mExtentX[proxy] = extents.x;
+		mExtentY[proxy] = extents.y;
+		mExtentZ[proxy] = extents.z;
+	}
+
+	// shaders want it transposed
+	mModels[proxy] = math::GetMatrixTransposed(model);
+}
+
+void RenderProxies::RefreshChangedMeshes()
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	uint32 count = GetCount();
+	for (uint32 i = 0; i < count; i++)
+		if (mMeshes[i] && mMeshes[i]->GetRenderVersion() != mMeshVersions[i])
+			Update(i);
+}
+
+void RenderProxies::ResolveMaterials(uint32 proxy)
+{
+	MeshComponent* meshComp = mOwners[proxy];
+	Mesh* mesh = mMeshes[proxy];
+
+	uint32 count = mesh ? (uint32)mesh->GetMaterials().size() : 0;
+
+	// same count, rewritten in place. otherwise appended at the end and the old slots are left unused
+	if (count != mMaterialCounts[proxy])
+	{
+		mUnusedMaterials += mMaterialCounts[proxy];
+
+		// more than half of the pool is unused, pack the proxies again (this one is appended below)
+		if (mUnusedMaterials > mMaterials.size() / 2)
+		{
+			std::vector<const Material*> packed;
+			packed.reserve(mMaterials.size() - mUnusedMaterials + count);
+
+			for (uint32 i = 0; i < GetCount(); i++)
+			{
+				if (i == proxy)
+					continue;
+
+				uint32 offset = (uint32)packed.size();
+				packed.insert(packed.end(), mMaterials.begin() + mMaterialOffsets[i], mMaterials.begin() + mMaterialOffsets[i] + mMaterialCounts[i]);
+				mMaterialOffsets[i] = offset;
+			}
+
+			mMaterials.swap(packed);
+			mUnusedMaterials = 0;
+		}
+
+		mMaterialOffsets[proxy] = (uint32)mMaterials.size();
+		mMaterialCounts[proxy] = count;
+		mMaterials.resize(mMaterials.size() + count);
+	}
+
+	const Material** materials = mMaterials.data() + mMaterialOffsets[proxy];
+	for (uint32 i = 0; i < count; i++)
+	{
+		// the overrides are sized when the mesh is set, a mesh that was still loading back then has none
+		Material* matOverride = i < meshComp->mMaterialOverrides.size() ? meshComp->mMaterialOverrides[i] : nullptr;
+		materials[i] = matOverride ? matOverride : mesh->GetMaterials()[i];
+	}
+}
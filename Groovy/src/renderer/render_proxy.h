@@ -0,0 +1,72 @@
+#pragma once
+
+#include "core/coreminimal.h"
+#include "math/bounds.h"
+
+#include <vector>
+
+class Mesh;
+class Material;
+class MeshComponent;
+
+#define INVALID_RENDER_PROXY 0xFFFFFFFF
+
+/*
+	What the renderer needs from the meshes of a scene, one proxy per MeshComponent, every field in its own array
+	so the renderer walks them linearly without touching the components. Owned by the scene, main thread only.
+	A proxy is only rebuilt when its component tells it something changed:
+
+	uint32 proxy = proxies.Add(meshComp);   // MeshComponent::Initialize
+	proxies.UpdateTransform(proxy);         // the component or its actor moved
+	proxies.Update(proxy);                  // mesh, material overrides or visibility changed
+	proxies.Remove(proxy);                  // the last proxy takes its index
+*/
+class CORE_API RenderProxies
+{
+public:
+	RenderProxies();
+
+	uint32 Add(MeshComponent* meshComp);
+	void Remove(uint32 proxy);
+
+	// everything, transform included
+	void Update(uint32 proxy);
+	// world matrix and bounds only
+	void UpdateTransform(uint32 proxy);
+
+	// updates the proxies whose mesh changed since they were built (finished loading, materials edited)
+	void RefreshChangedMeshes();
+
+	inline uint32 GetCount() const { return (uint32)mOwners.size(); }
+
+private:
+	void ResolveMaterials(uint32 proxy);
+
+private:
+	std::vector<MeshComponent*> mOwners;
+	std::vector<Mesh*> mMeshes;
+	// Mesh::GetRenderVersion when the proxy was built
+	std::vector<uint32> mMeshVersions;
+	// 0 when hidden or without a mesh
+	std::vector<uint8> mVisible;
+
+	// world matrices, transposed for the shaders
+	std::vector<Mat4> mModels;
+	std::vector<BoundingSphere> mSpheres;
+	// world boxes as center / extents (BoundingBoxesSoA)
+	std::vector<float> mCenterX;
+	std::vector<float> mCenterY;
+	std::vector<float> mCenterZ;
+	std::vector<float> mExtentX;
+	std::vector<float> mExtentY;
+	std::vector<float> mExtentZ;
+
+	// materials with the overrides applied, the ones of a proxy are mMaterials[offset, offset + count)
+	std::vector<uint32> mMaterialOffsets;
+	std::vector<uint32> mMaterialCounts;
+	std::vector<const Material*> mMaterials;
+	// slots left behind by proxies that changed material count or were removed, compacted when they pile up
+	uint32 mUnusedMaterials;
+
+	friend class SceneRenderer;
+};
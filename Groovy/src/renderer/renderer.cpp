@@ -1,26 +1,46 @@
 #include "renderer.h"
 #include "api/renderer_api.h"
+#include "frame_allocator.h"
+
+#include <algorithm>
 
 // register 0 = view projection
 static ConstBuffer* sCameraVPBuffer;
 // register 1 = model
 static ConstBuffer* sModelBuffer;
 
+// last bound state, binds of the same thing are skipped
 static Shader* sCurrentlyBoundShader;
+static VertexBuffer* sCurrentlyBoundVertexBuffer;
+static IndexBuffer* sCurrentlyBoundIndexBuffer;
+static Texture* sCurrentlyBoundTextures[RENDERER_MAX_TRACKED_TEXTURE_SLOTS];
+
+static RendererBindStats sBindStats;
 
 void Renderer::Init()
 {
 	sCameraVPBuffer = ConstBuffer::Create(sizeof(Mat4), nullptr);
 	sCameraVPBuffer->BindForVertexShader(VIEW_PROJECTION_BUFFER_INDEX);
-	sModelBuffer = ConstBuffer::Create(sizeof(Mat4), nullptr);
+	sModelBuffer = ConstBuffer::Create(sizeof(Mat4) * RENDERER_MAX_INSTANCES_PER_DRAW, nullptr);
 	sModelBuffer->BindForVertexShader(MODEL_BUFFER_INDEX);
-	sCurrentlyBoundShader = nullptr;
+	InvalidateBindings();
+
+	FrameAllocator::Init();
 }
 
 void Renderer::Shutdown()
 {
 	delete sCameraVPBuffer;
 	delete sModelBuffer;
+
+	FrameAllocator::Shutdown();
+}
+
+void Renderer::Present()
+{
+	FrameAllocator::EndSubmission();
+	RendererAPI::Get().Present();
+	FrameAllocator::Reset();
 }
 
 void Renderer::SetCamera(Mat4& vpMatrix)
@@ -33,38 +53,152 @@ void Renderer::SetModel(Mat4& modelMatrix)
 	sModelBuffer->Overwrite(&modelMatrix, sizeof(Mat4));
 }
 
-void Renderer::RenderMesh(Mesh* mesh, const std::vector<Material*>& materials)
+void Renderer::InvalidateBindings()
 {
-	check(mesh);
+	sCurrentlyBoundShader = nullptr;
+	sCurrentlyBoundVertexBuffer = nullptr;
+	sCurrentlyBoundIndexBuffer = nullptr;
+	for (Texture*& texture : sCurrentlyBoundTextures)
+		texture = nullptr;
+}
 
-	mesh->mVertexBuffer->Bind();
-	mesh->mIndexBuffer->Bind();
+const RendererBindStats& Renderer::GetBindStats()
+{
+	return sBindStats;
+}
 
-	uint32 indexOffset = 0;
-	uint32 vertexOffset = 0;
-	for (uint32 i = 0; i < mesh->mSubmeshes.size(); i++)
+void Renderer::ResetBindStats()
+{
+	sBindStats = {};
+}
+
+void Renderer::BindGeometry(Mesh* mesh)
+{
+	if (mesh->mVertexBuffer != sCurrentlyBoundVertexBuffer)
 	{
-		const Material* mat = materials[i];
+		mesh->mVertexBuffer->Bind();
+		sCurrentlyBoundVertexBuffer = mesh->mVertexBuffer;
+		sBindStats.issued++;
+	}
+	else
+	{
+		sBindStats.skipped++;
+	}
+
+	if (mesh->mIndexBuffer != sCurrentlyBoundIndexBuffer)
+	{
+		mesh->mIndexBuffer->Bind();
+		sCurrentlyBoundIndexBuffer = mesh->mIndexBuffer;
+		sBindStats.issued++;
+	}
+	else
+	{
+		sBindStats.skipped++;
+	}
+}
 
-		if (mat->mShader != sCurrentlyBoundShader)
+void Renderer::BindMaterial(const Material* mat)
+{
+	if (mat->mShader != sCurrentlyBoundShader)
+	{
+		mat->mShader->Bind();
+		sCurrentlyBoundShader = mat->mShader;
+		sBindStats.issued++;
+	}
+	else
+	{
+		sBindStats.skipped++;
+	}
+
+	for (const MaterialResource& res : mat->mResources)
+	{
+		if (res.slot < RENDERER_MAX_TRACKED_TEXTURE_SLOTS)
 		{
-			mat->mShader->Bind();
-			sCurrentlyBoundShader = mat->mShader;
+			if (sCurrentlyBoundTextures[res.slot] == res.res)
+			{
+				sBindStats.skipped++;
+				continue;
+			}
+			sCurrentlyBoundTextures[res.slot] = res.res;
 		}
 
-		for (const MaterialResource& res : mat->mResources)
-			res.res->Bind(res.slot);
+		res.res->Bind(res.slot);
+		sBindStats.issued++;
+	}
+}
+
+void Renderer::RenderMesh(Mesh* mesh, const std::vector<Material*>& materials, uint32 lod)
+{
+	check(mesh);
+	checkslow(lod < mesh->GetLODCount());
 
-		RendererAPI::Get().DrawIndexed(vertexOffset, indexOffset, mesh->mSubmeshes[i].indexCount);
+	// geometry that failed to load, nothing to draw
+	if (!mesh->mVertexBuffer)
+		return;
 
+	BindGeometry(mesh);
+
+	// lods are stored one after the other, skip the ones before
+	uint32 submeshCount = (uint32)mesh->mMaterials.size();
+	uint32 firstSubmesh = lod * submeshCount;
+
+	uint32 indexOffset = 0;
+	uint32 vertexOffset = 0;
+	for (uint32 i = 0; i < firstSubmesh; i++)
+	{
 		vertexOffset += mesh->mSubmeshes[i].vertexCount;
 		indexOffset += mesh->mSubmeshes[i].indexCount;
 	}
+
+	for (uint32 i = 0; i < submeshCount; i++)
+	{
+		const Material* mat = materials[i];
+		const SubmeshData& submesh = mesh->mSubmeshes[firstSubmesh + i];
+
+		BindMaterial(mat);
+
+		RendererAPI::Get().DrawIndexed(vertexOffset, indexOffset, submesh.indexCount);
+
+		vertexOffset += submesh.vertexCount;
+		indexOffset += submesh.indexCount;
+	}
 }
 
-void Renderer::RenderMesh(Mesh* mesh)
+void Renderer::RenderMesh(Mesh* mesh, uint32 lod)
 {
 	check(mesh);
 
-	RenderMesh(mesh, mesh->GetMaterials());
+	RenderMesh(mesh, mesh->GetMaterials(), lod);
 }
+
+void Renderer::RenderSubmeshInstanced(Mesh* mesh, uint32 submeshIndex, const Material* material, const Mat4* models, uint32 instanceCount)
+{
+	check(mesh && material);
+
+	if (!instanceCount || !mesh->mVertexBuffer)
+		return;
+
+	checkslow(submeshIndex < mesh->mSubmeshes.size());
+
+	BindGeometry(mesh);
+
+	uint32 indexOffset = 0;
+	uint32 vertexOffset = 0;
+	for (uint32 i = 0; i < submeshIndex; i++)
+	{
+		vertexOffset += mesh->mSubmeshes[i].vertexCount;
+		indexOffset += mesh->mSubmeshes[i].indexCount;
+	}
+
+	const SubmeshData& submesh = mesh->mSubmeshes[submeshIndex];
+
+	BindMaterial(material);
+
+	for (uint32 first = 0; first < instanceCount; first += RENDERER_MAX_INSTANCES_PER_DRAW)
+	{
+		uint32 count = std::min(instanceCount - first, (uint32)RENDERER_MAX_INSTANCES_PER_DRAW);
+		sModelBuffer->Overwrite((void*)(models + first), count * sizeof(Mat4));
+
+		RendererAPI::Get().DrawIndexedInstanced(vertexOffset, indexOffset, submesh.indexCount, count);
+	}
+}
\ No newline at end of file
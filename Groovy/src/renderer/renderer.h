@@ -6,6 +6,20 @@
 #define VIEW_PROJECTION_BUFFER_INDEX 0
 #define MODEL_BUFFER_INDEX 1
 
+// model matrices in the model buffer, shaders index it with SV_InstanceID (must match the hlsl array size)
+#define RENDERER_MAX_INSTANCES_PER_DRAW 256
+
+// texture slots whose binding is tracked, higher slots are always rebound
+#define RENDERER_MAX_TRACKED_TEXTURE_SLOTS 16
+
+struct RendererBindStats
+{
+	// binds sent to the renderer api
+	uint32 issued;
+	// binds of what was already bound, not sent
+	uint32 skipped;
+};
+
 class CORE_API Renderer
 {
 public:
@@ -15,8 +29,26 @@ public:
 
 	static void SetModel(Mat4& modelMatrix);
 
-	static void RenderMesh(Mesh* mesh, const std::vector<Material*>& materials);
-	static void RenderMesh(Mesh* mesh);
+	static void RenderMesh(Mesh* mesh, const std::vector<Material*>& materials, uint32 lod = 0);
+	static void RenderMesh(Mesh* mesh, uint32 lod = 0);
+
+	// draws one submesh (index in Mesh::GetSubmeshes, lods included) once per model matrix, matrices are transposed like in SetModel.
+	// overwrites the model buffer, draws are split every RENDERER_MAX_INSTANCES_PER_DRAW instances
+	static void RenderSubmeshInstanced(Mesh* mesh, uint32 submeshIndex, const Material* material, const Mat4* models, uint32 instanceCount);
 
 	static void Shutdown();
+
+	// ends the frame: presents and releases the frame allocator
+	static void Present();
+
+	// forgets what is bound, call it when something else may have changed the pipeline (other renderers, gui)
+	static void InvalidateBindings();
+
+	// accumulated since the last reset
+	static const RendererBindStats& GetBindStats();
+	static void ResetBindStats();
+
+private:
+	static void BindGeometry(Mesh* mesh);
+	static void BindMaterial(const Material* material);
 };
\ No newline at end of file
@@ -3,7 +3,111 @@
 #include "math/math.h"
 #include "gameframework/scene.h"
 #include "gameframework/components/camera_component.h"
-#include "gameframework/components/mesh_component.h"
+#include "render_proxy.h"
+#include "frame_allocator.h"
+#include "utils/sort_utils.h"
+
+#include <math.h>
+#include <float.h>
+#include <vector>
+
+#define SCENE_NEAR_Z 0.01f
+#define SCENE_FAR_Z 1000.0f
+
+static Vec3 sCameraLocation;
+// a sphere of radius r at distance d covers r / d * sLODScreenScale of the screen height
+static float sLODScreenScale;
+static float sLODBias = 0.0f;
+static Frustum sFrustum;
+
+static SceneRenderStats sStats;
+static SceneRenderStats sTotalStats;
+
+// a visible submesh, draws with the same mesh, submesh and material become one instanced draw
+struct SubmeshDraw
+{
+	Mesh* mesh;
+	uint32 submesh;
+	const Material* material;
+	// render proxy index
+	uint32 object;
+
+	bool IsSameBatch(const SubmeshDraw& other) const
+	{
+		return mesh == other.mesh && submesh == other.submesh && material == other.material;
+	}
+};
+
+/*
+	draw sort key, most significant first:
+	pass (4 bits) | shader (12) | material (16) | geometry = mesh + submesh (16) | depth (16)
+	state changes are ordered by cost, draws sharing all the state end up next to each other (front to back)
+*/
+enum ESceneRenderPass
+{
+	SCENE_RENDER_PASS_OPAQUE = 0
+};
+
+#define SORT_KEY_SHADER_BITS 12
+#define SORT_KEY_MATERIAL_BITS 16
+#define SORT_KEY_GEOMETRY_BITS 16
+#define SORT_KEY_DEPTH_BITS 16
+
+static uint64 MakeSortKey(ESceneRenderPass pass, uint32 shader, uint32 material, uint32 geometry, uint32 depth)
+{
+	uint64 key = pass;
+	key = (key << SORT_KEY_SHADER_BITS) | shader;
+	key = (key << SORT_KEY_MATERIAL_BITS) | material;
+	key = (key << SORT_KEY_GEOMETRY_BITS) | geometry;
+	key = (key << SORT_KEY_DEPTH_BITS) | depth;
+	return key;
+}
+
+// small ids for the sort keys in order of first use. ids past the limit share the last one,
+// the sort gets worse but batches still compare the real pointers
+struct SortIDTable
+{
+	struct Entry
+	{
+		const void* object;
+		uint32 sub;
+		uint32 id;
+	};
+
+	// open addressing, power of two size, from the frame allocator
+	Entry* entries;
+	uint32 mask;
+	uint32 count;
+
+	SortIDTable(uint32 maxEntries)
+	{
+		uint32 size = 16;
+		while (size < maxEntries * 2)
+			size *= 2;
+
+		entries = FrameAllocator::Alloc<Entry>(size);
+		memset(entries, 0, size * sizeof(Entry));
+		mask = size - 1;
+		count = 0;
+	}
+
+	uint32 GetID(const void* object, uint32 sub, uint32 idBits)
+	{
+		uint64 hash = ((uint64)(uintptr_t)object ^ ((uint64)sub << 48)) * 0x9E3779B97F4A7C15ull;
+		uint32 slot = (uint32)(hash >> 32) & mask;
+		while (entries[slot].object)
+		{
+			if (entries[slot].object == object && entries[slot].sub == sub)
+				return entries[slot].id;
+			slot = (slot + 1) & mask;
+		}
+
+		uint32 maxID = (1u << idBits) - 1;
+		entries[slot] = { object, sub, count < maxID ? count : maxID };
+		count++;
+		return entries[slot].id;
+	}
+};
 
 void SceneRenderer::BeginScene(CameraComponent* camera, float aspectRatio)
 {	
@@ -12,39 +116,172 @@ void SceneRenderer::BeginScene(CameraComponent* camera, float aspectRatio)
 
 void SceneRenderer::BeginScene(Vec3 camLocation, Vec3 camRotation, float FOV, float aspectRatio)
 {
-	Mat4 vp =
-		math::GetViewMatrix(camLocation, camRotation)
-		*
-		math::GetPerspectiveMatrix(aspectRatio, FOV, 0.01f, 1000.0f);
+	BeginScene(camLocation, math::GetViewMatrix(camLocation, camRotation), FOV, aspectRatio);
+}
+
+void SceneRenderer::BeginScene(Vec3 camLocation, Quat camRotation, float FOV, float aspectRatio)
+{
+	BeginScene(camLocation, math::GetViewMatrix(camLocation, camRotation), FOV, aspectRatio);
+}
+
+void SceneRenderer::BeginScene(Vec3 camLocation, const Mat4& view, float FOV, float aspectRatio)
+{
+	Mat4 vp = view * math::GetPerspectiveMatrix(aspectRatio, FOV, SCENE_NEAR_Z, SCENE_FAR_Z);
+	sFrustum = math::GetFrustum(vp);
 	vp = math::GetMatrixTransposed(vp);
 
 	Renderer::SetCamera(vp);
+
+	sCameraLocation = camLocation;
+	sLODScreenScale = 1.0f / tanf(math::DegToRad(FOV) * 0.5f);
+
+	sStats = SceneRenderStats();
+	FrameAllocator::BeginSubmission();
+
+	// the pipeline may have been used by something else since the last scene
+	Renderer::InvalidateBindings();
 }
 
 void SceneRenderer::RenderScene(Scene* scene)
 {
-	for (MeshComponent* meshComp : scene->GetRenderQueue())
+	GROOVY_PROFILE_FUNCTION();
+
+	float lodScreenScale = sLODScreenScale * exp2f(-sLODBias);
+
+	// moved actors and components update their proxies here
+	scene->UpdateTransforms();
+
+	// proxies hold world matrices, bounds and materials, they're only rebuilt when a component changes.
+	// the rest lives in the frame allocator, nothing is allocated from the heap once the frames look alike
+	RenderProxies& proxies = scene->GetRenderProxies();
+	proxies.RefreshChangedMeshes();
+
+	uint32 count = proxies.GetCount();
+
+	uint8* visible = FrameAllocator::Alloc<uint8>(count);
+	BoundingBoxesSoA boxes =
 	{
-		if (!meshComp->mVisible)
-			continue;
+		proxies.mCenterX.data(), proxies.mCenterY.data(), proxies.mCenterZ.data(),
+		proxies.mExtentX.data(), proxies.mExtentY.data(), proxies.mExtentZ.data()
+	};
+	math::FrustumCullBoxes(sFrustum, boxes, count, visible);
+
+	// hidden proxies and proxies without a mesh are culled with everything else, then dropped here
+	uint32 candidateCount = 0;
+	uint32 visibleCount = 0;
+	uint32 maxDrawCount = 0;
+	for (uint32 p = 0; p < count; p++)
+	{
+		visible[p] &= proxies.mVisible[p];
+		candidateCount += proxies.mVisible[p];
+		visibleCount += visible[p];
+		if (visible[p])
+			maxDrawCount += proxies.mMaterialCounts[p];
+	}
+
+	sStats.visible += visibleCount;
+	sStats.culled += candidateCount - visibleCount;
+	sTotalStats.visible += visibleCount;
+	sTotalStats.culled += candidateCount - visibleCount;
+
+	SubmeshDraw* draws = FrameAllocator::Alloc<SubmeshDraw>(maxDrawCount);
+	uint64* sortKeys = FrameAllocator::Alloc<uint64>(maxDrawCount);
 
-		Mesh* mesh = meshComp->mMesh;
-		if (!mesh)
+	SortIDTable shaderIDs(maxDrawCount);
+	SortIDTable materialIDs(maxDrawCount);
+	SortIDTable geometryIDs(maxDrawCount);
+
+	uint32 drawCount = 0;
+	for (uint32 p = 0; p < count; p++)
+	{
+		if (!visible[p])
 			continue;
 
-		Mat4 model = math::GetModelMatrix(meshComp->GetAbsoluteLocation(), meshComp->GetAbsoluteRotation(), meshComp->GetAbsoluteScale());
-		model = math::GetMatrixTransposed(model);
+		Mesh* mesh = proxies.mMeshes[p];
 
-		Renderer::SetModel(model);
+		const BoundingSphere& sphere = proxies.mSpheres[p];
+		float distance = math::Magnitude(sphere.center - sCameraLocation);
 
-		std::vector<Material*> materials = meshComp->mMesh->GetMaterials();
-		for (uint32 i = 0; i < materials.size(); i++)
+		// lod from the projected size of the world sphere
+		uint32 lod = 0;
+		if (mesh->GetLODCount() > 1)
 		{
-			Material* matOverride = meshComp->mMaterialOverrides[i];
-			if (matOverride)
-				materials[i] = matOverride;
+			float screenSize = distance > sphere.radius ? sphere.radius / distance * lodScreenScale : FLT_MAX;
+			lod = mesh->SelectLOD(screenSize);
 		}
 
-		Renderer::RenderMesh(mesh, materials);
+		uint32 depth = (uint32)(math::Clamp(distance / SCENE_FAR_Z, 0.0f, 1.0f) * ((1 << SORT_KEY_DEPTH_BITS) - 1));
+
+		// overrides already applied
+		const Material* const* materials = proxies.mMaterials.data() + proxies.mMaterialOffsets[p];
+		uint32 submeshCount = proxies.mMaterialCounts[p];
+		for (uint32 i = 0; i < submeshCount; i++)
+		{
+			const Material* material = materials[i];
+			uint32 submesh = lod * submeshCount + i;
+
+			sortKeys[drawCount] = MakeSortKey
+			(
+				SCENE_RENDER_PASS_OPAQUE,
+				shaderIDs.GetID(material->GetShader(), 0, SORT_KEY_SHADER_BITS),
+				materialIDs.GetID(material, 0, SORT_KEY_MATERIAL_BITS),
+				geometryIDs.GetID(mesh, submesh, SORT_KEY_GEOMETRY_BITS),
+				depth
+			);
+			draws[drawCount] = { mesh, submesh, material, p };
+			drawCount++;
+		}
+	}
+
+	// draw index of each key
+	uint32* sortedDraws = FrameAllocator::Alloc<uint32>(drawCount);
+	for (uint32 i = 0; i < drawCount; i++)
+		sortedDraws[i] = i;
+
+	sortUtils::RadixSort(sortKeys, sortedDraws, drawCount, FrameAllocator::Alloc<uint64>(drawCount), FrameAllocator::Alloc<uint32>(drawCount));
+
+	// per frame instance buffer, model matrices (already transposed) in sorted order so each batch is contiguous
+	Mat4* instanceModels = FrameAllocator::Alloc<Mat4>(drawCount);
+	for (uint32 i = 0; i < drawCount; i++)
+		instanceModels[i] = proxies.mModels[draws[sortedDraws[i]].object];
+
+	// batches are runs of the same mesh, submesh and material, the renderer skips binds of unchanged state between them
+	for (uint32 first = 0; first < drawCount;)
+	{
+		const SubmeshDraw& draw = draws[sortedDraws[first]];
+
+		uint32 last = first + 1;
+		while (last < drawCount && draws[sortedDraws[last]].IsSameBatch(draw))
+			last++;
+
+		Renderer::RenderSubmeshInstanced(draw.mesh, draw.submesh, draw.material, &instanceModels[first], last - first);
+
+		first = last;
 	}
 }
+
+void SceneRenderer::SetLODBias(float bias)
+{
+	sLODBias = bias;
+}
+
+float SceneRenderer::GetLODBias()
+{
+	return sLODBias;
+}
+
+const SceneRenderStats& SceneRenderer::GetStats()
+{
+	return sStats;
+}
+
+const SceneRenderStats& SceneRenderer::GetTotalStats()
+{
+	return sTotalStats;
+}
+
+void SceneRenderer::ResetStats()
+{
+	sStats = SceneRenderStats();
+	sTotalStats = SceneRenderStats();
+}
\ No newline at end of file
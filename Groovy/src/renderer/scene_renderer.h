@@ -3,11 +3,32 @@
 #include "core/core.h"
 #include "math/vector.h"
 
+struct SceneRenderStats
+{
+	// meshes tested against the camera frustum
+	uint32 visible = 0;
+	uint32 culled = 0;
+};
+
 class CORE_API SceneRenderer
 {
 public:
 	static void BeginScene(Vec3 camLocation, Vec3 camRotation, float FOV, float aspectRatio);
+	static void BeginScene(Vec3 camLocation, Quat camRotation, float FOV, float aspectRatio);
 	static void BeginScene(class CameraComponent* camera, float aspectRatio);
 	
 	static void RenderScene(class Scene* scene);
+
+	// every step halves the screen size used to pick lods, > 0 switches to lower lods sooner, < 0 later
+	static void SetLODBias(float bias);
+	static float GetLODBias();
+
+	// since the last BeginScene
+	static const SceneRenderStats& GetStats();
+	// every frame since the last ResetStats
+	static const SceneRenderStats& GetTotalStats();
+	static void ResetStats();
+
+private:
+	static void BeginScene(Vec3 camLocation, const struct Mat4& view, float FOV, float aspectRatio);
 };
\ No newline at end of file
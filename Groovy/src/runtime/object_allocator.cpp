@@ -1,16 +1,130 @@
 #include "object_allocator.h"
 #include "classes/object.h"
 
-static std::vector<GroovyObject*> sObjects;
+static constexpr size_t OBJECT_SLOT_ALIGNMENT = 16;
+static constexpr size_t OBJECT_CHUNK_TARGET_SIZE = 64 * 1024;
+static constexpr uint32 OBJECT_CHUNK_MIN_SLOTS = 8;
+
+#define ALIGN_UP(Value, Alignment) (((Value) + ((Alignment) - 1)) & ~((Alignment) - 1))
+
+struct ObjectPool;
+
+// lives right before every object
+struct alignas(OBJECT_SLOT_ALIGNMENT) ObjectSlotHeader
+{
+	ObjectPool* pool;
+	uint32 chunkIndex;		// index inside ObjectPool::chunks, kept up to date by TrimPools
+	uint32 liveIndex;		// when alive, index inside ObjectPool::liveSlots
+};
+
+static_assert(sizeof(ObjectSlotHeader) == OBJECT_SLOT_ALIGNMENT);
+
+struct ObjectPoolChunk
+{
+	byte* memory;
+	uint32 liveObjects;
+};
+
+struct ObjectPool
+{
+	GroovyClass* gClass;
+	std::string className;
+	uint32 slotSize;
+	uint32 slotsPerChunk;
+	std::vector<ObjectPoolChunk> chunks;
+	std::vector<ObjectSlotHeader*> liveSlots;
+	ObjectSlotHeader* freeList;
+};
+
+static std::vector<ObjectPool*> sPools;
+
+static inline ObjectSlotHeader* GetSlotHeader(GroovyObject* obj)
+{
+	return (ObjectSlotHeader*)obj - 1;
+}
+
+static inline GroovyObject* GetSlotObject(ObjectSlotHeader* slot)
+{
+	return (GroovyObject*)(slot + 1);
+}
+
+// when free, the next slot in the free list is stored where the object was
+static inline ObjectSlotHeader*& NextFree(ObjectSlotHeader* slot)
+{
+	return *(ObjectSlotHeader**)(slot + 1);
+}
+
+static ObjectPool* CreatePool(GroovyClass* gClass)
+{
+	ObjectPool* pool = new ObjectPool();
+	pool->gClass = gClass;
+	pool->className = gClass->name;
+	pool->slotSize = (uint32)ALIGN_UP(sizeof(ObjectSlotHeader) + gClass->size, OBJECT_SLOT_ALIGNMENT);
+	pool->slotsPerChunk = (uint32)(OBJECT_CHUNK_TARGET_SIZE / pool->slotSize);
+	if (pool->slotsPerChunk < OBJECT_CHUNK_MIN_SLOTS)
+		pool->slotsPerChunk = OBJECT_CHUNK_MIN_SLOTS;
+	pool->freeList = nullptr;
+
+	sPools.push_back(pool);
+	return pool;
+}
+
+static void AllocateChunk(ObjectPool* pool)
+{
+	size_t chunkSize = (size_t)pool->slotSize * pool->slotsPerChunk;
+
+#if PLATFORM_WIN32
+	byte* memory = (byte*)_aligned_malloc(chunkSize, OBJECT_SLOT_ALIGNMENT);
+#else
+	byte* memory = (byte*)aligned_alloc(OBJECT_SLOT_ALIGNMENT, chunkSize);
+#endif
+	checkslowf(memory, "Out of memory");
+
+	// link the new slots in front of the free list, keeping address order
+	for (uint32 i = pool->slotsPerChunk; i > 0; i--)
+	{
+		ObjectSlotHeader* slot = (ObjectSlotHeader*)(memory + (size_t)(i - 1) * pool->slotSize);
+		slot->pool = pool;
+		slot->chunkIndex = (uint32)pool->chunks.size();
+		NextFree(slot) = pool->freeList;
+		pool->freeList = slot;
+	}
+
+	pool->chunks.push_back({ memory, 0 });
+}
+
+static void FreeChunkMemory(byte* memory)
+{
+#if PLATFORM_WIN32
+	_aligned_free(memory);
+#else
+	free(memory);
+#endif
+}
 
 GroovyObject* ObjectAllocator::Instantiate(GroovyClass* gClass)
 {
 	check(gClass);
 
-	GroovyObject* obj = (GroovyObject*)malloc(gClass->size);
-	gClass->constructor(obj);
+	ObjectPool* pool = (ObjectPool*)gClass->pool;
+	if (!pool)
+	{
+		pool = CreatePool(gClass);
+		gClass->pool = pool;
+	}
+
+	if (!pool->freeList)
+		AllocateChunk(pool);
+
+	ObjectSlotHeader* slot = pool->freeList;
+	pool->freeList = NextFree(slot);
 
-	sObjects.push_back(obj);
+	slot->liveIndex = (uint32)pool->liveSlots.size();
+	pool->liveSlots.push_back(slot);
+	pool->chunks[slot->chunkIndex].liveObjects++;
+
+	GroovyObject* obj = GetSlotObject(slot);
+	gClass->constructor(obj);
 
 	return obj;
 }
@@ -20,12 +134,122 @@ void ObjectAllocator::Destroy(GroovyObject* instance)
 	check(instance);
 
 	instance->GetClass()->destructor(instance);
-	free(instance);
 
-	sObjects.erase(std::find(sObjects.begin(), sObjects.end(), instance));
+	ObjectSlotHeader* slot = GetSlotHeader(instance);
+	ObjectPool* pool = slot->pool;
+
+	// swap remove from the live list
+	uint32 index = slot->liveIndex;
+	check(index < pool->liveSlots.size() && pool->liveSlots[index] == slot);
+
+	ObjectSlotHeader* last = pool->liveSlots.back();
+	pool->liveSlots[index] = last;
+	last->liveIndex = index;
+	pool->liveSlots.pop_back();
+	pool->chunks[slot->chunkIndex].liveObjects--;
+
+	NextFree(slot) = pool->freeList;
+	pool->freeList = slot;
+}
+
+void ObjectAllocator::TrimPools()
+{
+	for (ObjectPool* pool : sPools)
+	{
+		// old chunk index to the new one, the empty chunks are freed
+		std::vector<uint32> newChunkIndex(pool->chunks.size());
+		std::vector<ObjectPoolChunk> keptChunks;
+		for (uint32 c = 0; c < pool->chunks.size(); c++)
+		{
+			ObjectPoolChunk& chunk = pool->chunks[c];
+			newChunkIndex[c] = (uint32)keptChunks.size();
+			if (chunk.liveObjects)
+				keptChunks.push_back(chunk);
+			else
+				FreeChunkMemory(chunk.memory);
+		}
+
+		if (keptChunks.size() == pool->chunks.size())
+			continue;
+
+		pool->chunks = std::move(keptChunks);
+
+		// used slots of every surviving chunk, one pass over the live objects
+		std::vector<bool> used((size_t)pool->chunks.size() * pool->slotsPerChunk, false);
+		for (ObjectSlotHeader* slot : pool->liveSlots)
+		{
+			uint32 c = newChunkIndex[slot->chunkIndex];
+			size_t slotIndex = ((byte*)slot - pool->chunks[c].memory) / pool->slotSize;
+			used[(size_t)c * pool->slotsPerChunk + slotIndex] = true;
+		}
+
+		// chunk indices moved, rebuild the free list from the surviving chunks
+		pool->freeList = nullptr;
+		for (uint32 c = 0; c < pool->chunks.size(); c++)
+		{
+			ObjectPoolChunk& chunk = pool->chunks[c];
+			for (uint32 i = pool->slotsPerChunk; i > 0; i--)
+			{
+				ObjectSlotHeader* slot = (ObjectSlotHeader*)(chunk.memory + (size_t)(i - 1) * pool->slotSize);
+				slot->chunkIndex = c;
+				if (used[(size_t)c * pool->slotsPerChunk + i - 1])
+					continue;
+				NextFree(slot) = pool->freeList;
+				pool->freeList = slot;
+			}
+		}
+	}
 }
 
-uint32 ObjectAllocator::Debug_GetLiveObjectsCount()
+void ObjectAllocator::Shutdown()
 {
-	return (uint32)sObjects.size();
+	for (ObjectPool* pool : sPools)
+	{
+		pool->gClass->pool = nullptr;
+		for (ObjectPoolChunk& chunk : pool->chunks)
+			FreeChunkMemory(chunk.memory);
+		delete pool;
+	}
+	sPools.clear();
+}
+
+void ObjectAllocator::ForEachLiveObject(ObjectVisitor visitor, void* userData)
+{
+	check(visitor);
+
+	for (ObjectPool* pool : sPools)
+		for (ObjectSlotHeader* slot : pool->liveSlots)
+			visitor(GetSlotObject(slot), userData);
+}
+
+uint32 ObjectAllocator::GetLiveObjectsCount()
+{
+	uint32 count = 0;
+	for (ObjectPool* pool : sPools)
+		count += (uint32)pool->liveSlots.size();
+	return count;
+}
+
+uint32 ObjectAllocator::GetLiveObjectsCount(GroovyClass* gClass)
+{
+	check(gClass);
+	ObjectPool* pool = (ObjectPool*)gClass->pool;
+	return pool ? (uint32)pool->liveSlots.size() : 0;
+}
+
+void ObjectAllocator::GetPoolStats(std::vector<ObjectPoolStats>& outStats)
+{
+	outStats.clear();
+	outStats.reserve(sPools.size());
+
+	for (ObjectPool* pool : sPools)
+	{
+		ObjectPoolStats& stats = outStats.emplace_back();
+		stats.className = pool->className;
+		stats.liveObjects = (uint32)pool->liveSlots.size();
+		stats.capacity = (uint32)pool->chunks.size() * pool->slotsPerChunk;
+		stats.chunks = (uint32)pool->chunks.size();
+		stats.slotSize = pool->slotSize;
+		stats.bytesReserved = (size_t)stats.capacity * pool->slotSize;
+	}
 }
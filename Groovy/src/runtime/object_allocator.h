@@ -2,6 +2,23 @@
 
 #include "classes/class.h"
 
+typedef void(*ObjectVisitor)(GroovyObject* obj, void* userData);
+
+struct ObjectPoolStats
+{
+	std::string className;
+	uint32 liveObjects;
+	uint32 capacity;		// slots reserved across all chunks
+	uint32 chunks;
+	uint32 slotSize;		// bytes per slot, header included
+	size_t bytesReserved;
+};
+
+/*
+	Every GroovyClass gets its own slab pool (lazily created on first Instantiate).
+	Memory is reserved in fixed size chunks of slots sized from GroovyClass::size, freed slots go in a free list
+	and each slot carries an intrusive index into the pool live list, so Destroy is O(1).
+*/
 class CORE_API ObjectAllocator
 {
 public:
@@ -21,5 +38,15 @@ public:
 		return (TClass*)Instantiate(TClass::StaticClass());
 	}
 
-	static uint32 Debug_GetLiveObjectsCount();
-};
\ No newline at end of file
+	// releases chunks with no live objects, pools stay registered
+	static void TrimPools();
+	// releases every pool, any object still alive is leaked, call this at shutdown
+	static void Shutdown();
+
+	// every live object of every pool, cdos included. objects can't be created or destroyed by the visitor
+	static void ForEachLiveObject(ObjectVisitor visitor, void* userData);
+
+	static uint32 GetLiveObjectsCount();
+	static uint32 GetLiveObjectsCount(GroovyClass* gClass);
+	static void GetPoolStats(std::vector<ObjectPoolStats>& outStats);
+};
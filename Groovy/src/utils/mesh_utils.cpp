@@ -0,0 +1,982 @@
+#include "mesh_utils.h"
+#include "core/profiler.h"
+
+#include <unordered_map>
+#include <algorithm>
+#include <math.h>
+#include <float.h>
+
+// a cluster is cut in two when its cache misses stay within this factor of the whole cluster
+#define OVERDRAW_CLUSTER_THRESHOLD 1.05f
+
+namespace
+{
+	struct VertexHasher
+	{
+		size_t operator()(const MeshVertex& vertex) const
+		{
+			// fnv-1a, bitwise so that it matches VertexEquals
+			const byte* data = (const byte*)&vertex;
+			uint64 hash = 14695981039346656037ull;
+			for (size_t i = 0; i < sizeof(MeshVertex); i++)
+			{
+				hash ^= data[i];
+				hash *= 1099511628211ull;
+			}
+			return (size_t)hash;
+		}
+	};
+
+	struct VertexEquals
+	{
+		bool operator()(const MeshVertex& a, const MeshVertex& b) const
+		{
+			return memcmp(&a, &b, sizeof(MeshVertex)) == 0;
+		}
+	};
+
+	// triangles using each vertex
+	struct VertexAdjacency
+	{
+		std::vector<uint32> offsets;
+		std::vector<uint32> counts;
+		std::vector<uint32> triangles;
+
+		VertexAdjacency(const MeshIndex* indices, uint32 indexCount, uint32 vertexCount)
+			: offsets(vertexCount), counts(vertexCount, 0), triangles(indexCount)
+		{
+			for (uint32 i = 0; i < indexCount; i++)
+				counts[indices[i]]++;
+
+			uint32 offset = 0;
+			for (uint32 v = 0; v < vertexCount; v++)
+			{
+				offsets[v] = offset;
+				offset += counts[v];
+			}
+
+			std::vector<uint32> fill = offsets;
+			for (uint32 i = 0; i < indexCount; i++)
+				triangles[fill[indices[i]]++] = i / 3;
+		}
+	};
+
+	Vec3 GetPosition(const MeshVertex& vertex)
+	{
+		return { vertex.position.x, vertex.position.y, vertex.position.z };
+	}
+
+	// sum of squared distances to planes, weighted by triangle area
+	struct Quadric
+	{
+		float a00, a11, a22, a01, a02, a12;
+		float b0, b1, b2;
+		float c;
+		float weight;
+
+		void AddPlane(Vec3 normal, float distance, float planeWeight)
+		{
+			a00 += normal.x * normal.x * planeWeight;
+			a11 += normal.y * normal.y * planeWeight;
+			a22 += normal.z * normal.z * planeWeight;
+			a01 += normal.x * normal.y * planeWeight;
+			a02 += normal.x * normal.z * planeWeight;
+			a12 += normal.y * normal.z * planeWeight;
+			b0 += normal.x * distance * planeWeight;
+			b1 += normal.y * distance * planeWeight;
+			b2 += normal.z * distance * planeWeight;
+			c += distance * distance * planeWeight;
+			weight += planeWeight;
+		}
+
+		void Add(const Quadric& q)
+		{
+			a00 += q.a00; a11 += q.a11; a22 += q.a22;
+			a01 += q.a01; a02 += q.a02; a12 += q.a12;
+			b0 += q.b0; b1 += q.b1; b2 += q.b2;
+			c += q.c;
+			weight += q.weight;
+		}
+
+		// squared distance, averaged over the planes
+		float Error(Vec3 p) const
+		{
+			float rx = a00 * p.x + a01 * p.y + a02 * p.z + b0;
+			float ry = a01 * p.x + a11 * p.y + a12 * p.z + b1;
+			float rz = a02 * p.x + a12 * p.y + a22 * p.z + b2;
+			float error = p.x * rx + p.y * ry + p.z * rz + b0 * p.x + b1 * p.y + b2 * p.z + c;
+			return weight > 0.0f ? fabsf(error) / weight : 0.0f;
+		}
+	};
+
+	struct PositionHasher
+	{
+		size_t operator()(const Vec3& p) const
+		{
+			uint32 bits[3];
+			memcpy(bits, &p, sizeof(bits));
+			return (size_t)((bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u));
+		}
+	};
+
+	struct PositionEquals
+	{
+		bool operator()(const Vec3& a, const Vec3& b) const
+		{
+			return a.x == b.x && a.y == b.y && a.z == b.z;
+		}
+	};
+
+	struct Collapse
+	{
+		MeshIndex from;
+		MeshIndex to;
+		float error;
+	};
+
+	uint16 FloatToHalf(float value)
+	{
+		uint32 bits;
+		memcpy(&bits, &value, sizeof(float));
+
+		uint32 sign = (bits >> 16) & 0x8000;
+		int32 exponent = (int32)((bits >> 23) & 0xFF) - 127 + 15;
+		uint32 mantissa = bits & 0x7FFFFF;
+
+		// nan and inf
+		if (((bits >> 23) & 0xFF) == 0xFF)
+			return (uint16)(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+		// too big, clamped to inf
+		if (exponent >= 31)
+			return (uint16)(sign | 0x7C00);
+		// denormal or zero
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+				return (uint16)sign;
+			mantissa |= 0x800000;
+			uint32 shift = (uint32)(14 - exponent);
+			uint32 half = mantissa >> shift;
+			// round to nearest
+			if ((mantissa >> (shift - 1)) & 1)
+				half++;
+			return (uint16)(sign | half);
+		}
+
+		uint32 half = sign | ((uint32)exponent << 10) | (mantissa >> 13);
+		// round to nearest, a carry into the exponent is still correct
+		if (mantissa & 0x1000)
+			half++;
+		return (uint16)half;
+	}
+
+	float HalfToFloat(uint16 half)
+	{
+		uint32 sign = (uint32)(half & 0x8000) << 16;
+		uint32 exponent = (half >> 10) & 0x1F;
+		uint32 mantissa = half & 0x3FF;
+
+		uint32 bits;
+		if (exponent == 0x1F)
+		{
+			bits = sign | 0x7F800000 | (mantissa << 13);
+		}
+		else if (exponent)
+		{
+			bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+		}
+		else if (mantissa)
+		{
+			// denormal, normalized for the float
+			exponent = 127 - 15 + 1;
+			while (!(mantissa & 0x400))
+			{
+				mantissa <<= 1;
+				exponent--;
+			}
+			bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+		}
+		else
+		{
+			bits = sign;
+		}
+
+		float value;
+		memcpy(&value, &bits, sizeof(float));
+		return value;
+	}
+
+	uint8 FloatToUNorm8(float value)
+	{
+		return (uint8)(math::Clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	uint32 GetPackedVertexStride(uint32 flags)
+	{
+		// position + uv (+ color)
+		return 3 * sizeof(uint16) + 2 * sizeof(uint16) + ((flags & MESH_ASSET_FLAG_VERTEX_COLOR) ? 4 : 0);
+	}
+
+	// cache misses of the triangles in [firstTriangle, lastTriangle), outCuts gets the triangles where a cluster can start
+	uint32 SimulateCluster(const MeshIndex* indices, uint32 firstTriangle, uint32 lastTriangle, std::vector<uint32>& cacheTimes, uint32& time, float cutThreshold, std::vector<uint32>* outCuts)
+	{
+		uint32 misses = 0;
+		uint32 clusterStart = firstTriangle;
+		uint32 clusterMisses = 0;
+
+		for (uint32 t = firstTriangle; t < lastTriangle; t++)
+		{
+			uint32 triangleMisses = 0;
+			for (uint32 k = 0; k < 3; k++)
+			{
+				MeshIndex v = indices[t * 3 + k];
+				if (time - cacheTimes[v] > meshUtils::VERTEX_CACHE_SIZE)
+				{
+					cacheTimes[v] = time++;
+					triangleMisses++;
+				}
+			}
+
+			misses += triangleMisses;
+			clusterMisses += triangleMisses;
+
+			if (!outCuts)
+				continue;
+
+			if (cutThreshold <= 0.0f)
+			{
+				// hard boundaries, nothing of the previous triangles is in the cache
+				if (triangleMisses == 3 && t != firstTriangle)
+					outCuts->push_back(t);
+			}
+			else if (t + 1 < lastTriangle && (float)clusterMisses / (float)(t + 1 - clusterStart) <= cutThreshold)
+			{
+				// the cluster so far is about as cache friendly as the whole one, starting over from a cold cache is affordable
+				outCuts->push_back(t + 1);
+				clusterStart = t + 1;
+				clusterMisses = 0;
+				time += meshUtils::VERTEX_CACHE_SIZE + 1;
+			}
+		}
+
+		return misses;
+	}
+}
+
+void meshUtils::WeldVertices(const MeshVertex* vertices, uint32 vertexCount, std::vector<MeshVertex>& outVertices, std::vector<MeshIndex>& outIndices)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	std::unordered_map<MeshVertex, MeshIndex, VertexHasher, VertexEquals> uniqueVertices;
+	uniqueVertices.reserve(vertexCount);
+
+	outVertices.clear();
+	outIndices.resize(vertexCount);
+
+	for (uint32 i = 0; i < vertexCount; i++)
+	{
+		auto [it, inserted] = uniqueVertices.try_emplace(vertices[i], (MeshIndex)outVertices.size());
+		if (inserted)
+			outVertices.push_back(vertices[i]);
+
+		outIndices[i] = it->second;
+	}
+}
+
+void meshUtils::OptimizeVertexCache(MeshIndex* indices, uint32 indexCount, uint32 vertexCount)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	uint32 triangleCount = indexCount / 3;
+	if (!triangleCount)
+		return;
+
+	VertexAdjacency adjacency(indices, triangleCount * 3, vertexCount);
+
+	// triangles still to be emitted per vertex
+	std::vector<uint32> liveTriangles = adjacency.counts;
+	std::vector<uint32> cacheTimes(vertexCount, 0);
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<MeshIndex> deadEnd;
+	std::vector<MeshIndex> candidates;
+
+	std::vector<MeshIndex> result;
+	result.reserve(triangleCount * 3);
+
+	uint32 time = VERTEX_CACHE_SIZE + 1;
+	uint32 scanCursor = 0;
+
+	int64 fanningVertex = 0;
+	while (fanningVertex >= 0)
+	{
+		candidates.clear();
+
+		// emits every triangle around the fanning vertex
+		uint32 first = adjacency.offsets[fanningVertex];
+		for (uint32 i = first; i < first + adjacency.counts[fanningVertex]; i++)
+		{
+			uint32 t = adjacency.triangles[i];
+			if (emitted[t])
+				continue;
+
+			for (uint32 k = 0; k < 3; k++)
+			{
+				MeshIndex v = indices[t * 3 + k];
+				result.push_back(v);
+				deadEnd.push_back(v);
+				candidates.push_back(v);
+				liveTriangles[v]--;
+
+				if (time - cacheTimes[v] > VERTEX_CACHE_SIZE)
+					cacheTimes[v] = time++;
+			}
+			emitted[t] = true;
+		}
+
+		// next fanning vertex, the one that stays the longest in the cache while its triangles are emitted
+		fanningVertex = -1;
+		int64 bestPriority = -1;
+		for (MeshIndex v : candidates)
+		{
+			if (!liveTriangles[v])
+				continue;
+
+			int64 priority = 0;
+			if (time - cacheTimes[v] + 2 * liveTriangles[v] <= VERTEX_CACHE_SIZE)
+				priority = time - cacheTimes[v];
+
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				fanningVertex = v;
+			}
+		}
+
+		if (fanningVertex != -1)
+			continue;
+
+		// dead end, most recent vertex with triangles left, then whatever comes next in the input
+		while (!deadEnd.empty() && fanningVertex == -1)
+		{
+			MeshIndex v = deadEnd.back();
+			deadEnd.pop_back();
+			if (liveTriangles[v])
+				fanningVertex = v;
+		}
+
+		while (scanCursor < vertexCount && fanningVertex == -1)
+		{
+			if (liveTriangles[scanCursor])
+				fanningVertex = scanCursor;
+			scanCursor++;
+		}
+	}
+
+	check(result.size() == triangleCount * 3);
+	memcpy(indices, result.data(), result.size() * sizeof(MeshIndex));
+}
+
+void meshUtils::OptimizeOverdraw(MeshIndex* indices, uint32 indexCount, const MeshVertex* vertices, uint32 vertexCount)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	uint32 triangleCount = indexCount / 3;
+	if (triangleCount < 2)
+		return;
+
+	// clusters that don't share vertices in the cache, then split further where it costs (almost) nothing
+	std::vector<uint32> cacheTimes(vertexCount, 0);
+	uint32 time = VERTEX_CACHE_SIZE + 1;
+
+	std::vector<uint32> hardBoundaries;
+	hardBoundaries.push_back(0);
+	SimulateCluster(indices, 0, triangleCount, cacheTimes, time, 0.0f, &hardBoundaries);
+	hardBoundaries.push_back(triangleCount);
+
+	std::vector<uint32> clusters;
+	for (uint32 i = 0; i + 1 < hardBoundaries.size(); i++)
+	{
+		uint32 first = hardBoundaries[i];
+		uint32 last = hardBoundaries[i + 1];
+
+		time += VERTEX_CACHE_SIZE + 1;
+		uint32 misses = SimulateCluster(indices, first, last, cacheTimes, time, 0.0f, nullptr);
+		float threshold = OVERDRAW_CLUSTER_THRESHOLD * (float)misses / (float)(last - first);
+
+		clusters.push_back(first);
+		time += VERTEX_CACHE_SIZE + 1;
+		SimulateCluster(indices, first, last, cacheTimes, time, threshold, &clusters);
+	}
+	clusters.push_back(triangleCount);
+
+	uint32 clusterCount = (uint32)clusters.size() - 1;
+	if (clusterCount < 2)
+		return;
+
+	// area weighted centroid and normal of each cluster
+	Vec3 meshCentroid = { 0.0f, 0.0f, 0.0f };
+	float meshArea = 0.0f;
+
+	std::vector<Vec3> clusterCentroids(clusterCount);
+	std::vector<Vec3> clusterNormals(clusterCount);
+
+	for (uint32 c = 0; c < clusterCount; c++)
+	{
+		Vec3 centroid = { 0.0f, 0.0f, 0.0f };
+		Vec3 normal = { 0.0f, 0.0f, 0.0f };
+		float clusterArea = 0.0f;
+
+		for (uint32 t = clusters[c]; t < clusters[c + 1]; t++)
+		{
+			Vec3 p0 = GetPosition(vertices[indices[t * 3 + 0]]);
+			Vec3 p1 = GetPosition(vertices[indices[t * 3 + 1]]);
+			Vec3 p2 = GetPosition(vertices[indices[t * 3 + 2]]);
+
+			Vec3 faceNormal = math::Cross(p1 - p0, p2 - p0);
+			float area = math::Magnitude(faceNormal);
+
+			centroid += (p0 + p1 + p2) * (area / 3.0f);
+			normal += faceNormal;
+			clusterArea += area;
+		}
+
+		meshCentroid += centroid;
+		meshArea += clusterArea;
+
+		clusterCentroids[c] = clusterArea > 0.0f ? centroid / clusterArea : centroid;
+		float normalLength = math::Magnitude(normal);
+		clusterNormals[c] = normalLength > 0.0f ? normal / normalLength : normal;
+	}
+
+	if (meshArea > 0.0f)
+		meshCentroid /= meshArea;
+
+	// clusters facing away from the center are the likely occluders, they go first
+	std::vector<float> sortKeys(clusterCount);
+	std::vector<uint32> order(clusterCount);
+	for (uint32 c = 0; c < clusterCount; c++)
+	{
+		sortKeys[c] = math::Dot(clusterCentroids[c] - meshCentroid, clusterNormals[c]);
+		order[c] = c;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&](uint32 a, uint32 b) { return sortKeys[a] > sortKeys[b]; });
+
+	std::vector<MeshIndex> result;
+	result.reserve(triangleCount * 3);
+	for (uint32 c : order)
+		result.insert(result.end(), indices + clusters[c] * 3, indices + clusters[c + 1] * 3);
+
+	memcpy(indices, result.data(), result.size() * sizeof(MeshIndex));
+}
+
+uint32 meshUtils::OptimizeVertexFetch(MeshVertex* vertices, uint32 vertexCount, MeshIndex* indices, uint32 indexCount)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	constexpr MeshIndex UNUSED = (MeshIndex)-1;
+
+	std::vector<MeshIndex> remap(vertexCount, UNUSED);
+	std::vector<MeshVertex> result;
+	result.reserve(vertexCount);
+
+	for (uint32 i = 0; i < indexCount; i++)
+	{
+		MeshIndex& newIndex = remap[indices[i]];
+		if (newIndex == UNUSED)
+		{
+			newIndex = (MeshIndex)result.size();
+			result.push_back(vertices[indices[i]]);
+		}
+
+		indices[i] = newIndex;
+	}
+
+	memcpy(vertices, result.data(), result.size() * sizeof(MeshVertex));
+	return (uint32)result.size();
+}
+
+void meshUtils::Simplify(const MeshIndex* indices, uint32 indexCount, const MeshVertex* vertices, uint32 vertexCount, uint32 targetIndexCount, float targetError, std::vector<MeshIndex>& outIndices, float* outError)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	outIndices.assign(indices, indices + indexCount / 3 * 3);
+	if (outError)
+		*outError = 0.0f;
+
+	if (outIndices.size() <= targetIndexCount || !vertexCount)
+		return;
+
+	// positions scaled to the unit cube, errors are relative to the mesh extent
+	Vec3 boundsMin = GetPosition(vertices[0]);
+	Vec3 boundsMax = boundsMin;
+	for (uint32 v = 1; v < vertexCount; v++)
+	{
+		Vec3 p = GetPosition(vertices[v]);
+		boundsMin = { std::min(boundsMin.x, p.x), std::min(boundsMin.y, p.y), std::min(boundsMin.z, p.z) };
+		boundsMax = { std::max(boundsMax.x, p.x), std::max(boundsMax.y, p.y), std::max(boundsMax.z, p.z) };
+	}
+
+	float extent = std::max(std::max(boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y), boundsMax.z - boundsMin.z);
+	float invExtent = extent > 0.0f ? 1.0f / extent : 0.0f;
+
+	std::vector<Vec3> positions(vertexCount);
+	for (uint32 v = 0; v < vertexCount; v++)
+		positions[v] = (GetPosition(vertices[v]) - boundsMin) * invExtent;
+
+	// vertices sharing a position (attribute seams) are moved together or not at all, they're locked
+	std::vector<bool> locked(vertexCount, false);
+	{
+		std::unordered_map<Vec3, MeshIndex, PositionHasher, PositionEquals> firstAtPosition;
+		firstAtPosition.reserve(vertexCount);
+		std::vector<MeshIndex> positionRemap(vertexCount);
+
+		for (uint32 v = 0; v < vertexCount; v++)
+		{
+			auto [it, inserted] = firstAtPosition.try_emplace(positions[v], (MeshIndex)v);
+			positionRemap[v] = it->second;
+			if (!inserted)
+				locked[v] = locked[it->second] = true;
+		}
+
+		// open edges (no opposite half edge) lock both ends, borders keep their shape
+		std::unordered_map<uint64, int32> edges;
+		edges.reserve(outIndices.size());
+		for (size_t i = 0; i < outIndices.size(); i += 3)
+		{
+			for (uint32 k = 0; k < 3; k++)
+			{
+				MeshIndex a = positionRemap[outIndices[i + k]];
+				MeshIndex b = positionRemap[outIndices[i + (k + 1) % 3]];
+				edges[((uint64)a << 32) | b]++;
+			}
+		}
+
+		for (size_t i = 0; i < outIndices.size(); i += 3)
+		{
+			for (uint32 k = 0; k < 3; k++)
+			{
+				MeshIndex a = positionRemap[outIndices[i + k]];
+				MeshIndex b = positionRemap[outIndices[i + (k + 1) % 3]];
+				if (!edges.count(((uint64)b << 32) | a))
+					locked[outIndices[i + k]] = locked[outIndices[i + (k + 1) % 3]] = true;
+			}
+		}
+	}
+
+	std::vector<Quadric> quadrics(vertexCount, Quadric{});
+	for (size_t i = 0; i < outIndices.size(); i += 3)
+	{
+		Vec3 p0 = positions[outIndices[i + 0]];
+		Vec3 normal = math::Cross(positions[outIndices[i + 1]] - p0, positions[outIndices[i + 2]] - p0);
+		float length = math::Magnitude(normal);
+		if (length <= 0.0f)
+			continue;
+
+		normal /= length;
+		float distance = -math::Dot(normal, p0);
+		for (uint32 k = 0; k < 3; k++)
+			quadrics[outIndices[i + k]].AddPlane(normal, distance, length * 0.5f);
+	}
+
+	float maxError = targetError * targetError;
+	float resultError = 0.0f;
+
+	std::vector<Collapse> collapses;
+	std::vector<MeshIndex> remap(vertexCount);
+	std::vector<bool> touched(vertexCount);
+
+	// a pass collapses as many independent edges as it can, cheapest first
+	while (outIndices.size() > targetIndexCount)
+	{
+		VertexAdjacency adjacency(outIndices.data(), (uint32)outIndices.size(), vertexCount);
+
+		collapses.clear();
+		for (size_t i = 0; i < outIndices.size(); i += 3)
+		{
+			for (uint32 k = 0; k < 3; k++)
+			{
+				MeshIndex from = outIndices[i + k];
+				MeshIndex to = outIndices[i + (k + 1) % 3];
+				if (locked[from])
+					continue;
+
+				Quadric q = quadrics[from];
+				q.Add(quadrics[to]);
+				collapses.push_back({ from, to, q.Error(positions[to]) });
+			}
+		}
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+		for (uint32 v = 0; v < vertexCount; v++)
+			remap[v] = (MeshIndex)v;
+		std::fill(touched.begin(), touched.end(), false);
+
+		size_t triangleCount = outIndices.size() / 3;
+		size_t targetTriangleCount = targetIndexCount / 3;
+		uint32 collapseCount = 0;
+
+		for (const Collapse& collapse : collapses)
+		{
+			if (collapse.error > maxError || triangleCount <= targetTriangleCount)
+				break;
+
+			if (touched[collapse.from] || touched[collapse.to])
+				continue;
+
+			// the triangles around from must not flip
+			uint32 first = adjacency.offsets[collapse.from];
+			uint32 last = first + adjacency.counts[collapse.from];
+			uint32 removedTriangles = 0;
+			bool flips = false;
+
+			for (uint32 a = first; a < last && !flips; a++)
+			{
+				const MeshIndex* triangle = &outIndices[adjacency.triangles[a] * 3];
+				if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+				{
+					removedTriangles++;
+					continue;
+				}
+
+				Vec3 before[3];
+				Vec3 after[3];
+				for (uint32 k = 0; k < 3; k++)
+				{
+					before[k] = positions[triangle[k]];
+					after[k] = triangle[k] == collapse.from ? positions[collapse.to] : before[k];
+				}
+
+				Vec3 normalBefore = math::Cross(before[1] - before[0], before[2] - before[0]);
+				Vec3 normalAfter = math::Cross(after[1] - after[0], after[2] - after[0]);
+				flips = math::Dot(normalBefore, normalAfter) <= 0.0f;
+			}
+
+			if (flips)
+				continue;
+
+			// everything around from changes, nothing else in this pass can touch it
+			for (uint32 a = first; a < last; a++)
+			{
+				const MeshIndex* triangle = &outIndices[adjacency.triangles[a] * 3];
+				touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = true;
+			}
+
+			remap[collapse.from] = collapse.to;
+			quadrics[collapse.to].Add(quadrics[collapse.from]);
+			triangleCount -= removedTriangles;
+			resultError = std::max(resultError, collapse.error);
+			collapseCount++;
+		}
+
+		if (!collapseCount)
+			break;
+
+		// degenerate triangles go away
+		size_t write = 0;
+		for (size_t i = 0; i < outIndices.size(); i += 3)
+		{
+			MeshIndex a = remap[outIndices[i + 0]];
+			MeshIndex b = remap[outIndices[i + 1]];
+			MeshIndex c = remap[outIndices[i + 2]];
+			if (a == b || b == c || c == a)
+				continue;
+
+			outIndices[write++] = a;
+			outIndices[write++] = b;
+			outIndices[write++] = c;
+		}
+		outIndices.resize(write);
+	}
+
+	if (outError)
+		*outError = sqrtf(resultError);
+}
+
+float meshUtils::ComputeACMR(const MeshIndex* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize)
+{
+	uint32 triangleCount = indexCount / 3;
+	if (!triangleCount)
+		return 0.0f;
+
+	std::vector<uint32> cacheTimes(vertexCount, 0);
+	uint32 time = cacheSize + 1;
+	uint32 misses = 0;
+
+	for (uint32 i = 0; i < triangleCount * 3; i++)
+	{
+		if (time - cacheTimes[indices[i]] > cacheSize)
+		{
+			cacheTimes[indices[i]] = time++;
+			misses++;
+		}
+	}
+
+	return (float)misses / (float)triangleCount;
+}
+
+void meshUtils::ComputeBounds(const MeshVertex* vertices, uint32 vertexCount, BoundingBox& outBox, BoundingSphere& outSphere)
+{
+	if (!vertexCount)
+	{
+		outBox = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+		outSphere = { { 0.0f, 0.0f, 0.0f }, 0.0f };
+		return;
+	}
+
+	float boundsMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float boundsMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (uint32 i = 0; i < vertexCount; i++)
+	{
+		const Vec4& p = vertices[i].position;
+		const float position[3] = { p.x, p.y, p.z };
+		for (uint32 axis = 0; axis < 3; axis++)
+		{
+			boundsMin[axis] = std::min(boundsMin[axis], position[axis]);
+			boundsMax[axis] = std::max(boundsMax[axis], position[axis]);
+		}
+	}
+
+	outBox.min = { boundsMin[0], boundsMin[1], boundsMin[2] };
+	outBox.max = { boundsMax[0], boundsMax[1], boundsMax[2] };
+
+	// tighter than the box corners for round meshes
+	Vec3 center = (outBox.min + outBox.max) * 0.5f;
+	float radiusSq = 0.0f;
+	for (uint32 i = 0; i < vertexCount; i++)
+	{
+		const Vec4& p = vertices[i].position;
+		float dx = p.x - center.x;
+		float dy = p.y - center.y;
+		float dz = p.z - center.z;
+		radiusSq = std::max(radiusSq, dx * dx + dy * dy + dz * dz);
+	}
+
+	outSphere = { center, sqrtf(radiusSq) };
+}
+
+void meshUtils::WriteGeometry(const MeshVertex* vertices, uint32 vertexCount, const MeshIndex* indices, uint32 indexCount, EMeshVertexFormat format, DynamicBuffer& out)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	MeshAssetHeader header = {};
+	header.magic = GROOVY_MESH_MAGIC;
+	header.version = GROOVY_MESH_VERSION;
+	header.vertexFormat = format;
+	header.vertexCount = vertexCount;
+	header.indexCount = indexCount;
+
+	BoundingBox box;
+	BoundingSphere sphere;
+	ComputeBounds(vertices, vertexCount, box, sphere);
+	header.boundsMin[0] = box.min.x; header.boundsMin[1] = box.min.y; header.boundsMin[2] = box.min.z;
+	header.boundsMax[0] = box.max.x; header.boundsMax[1] = box.max.y; header.boundsMax[2] = box.max.z;
+	header.sphereCenter[0] = sphere.center.x; header.sphereCenter[1] = sphere.center.y; header.sphereCenter[2] = sphere.center.z;
+	header.sphereRadius = sphere.radius;
+
+	// indices are relative to each submesh, they usually fit in 16 bits even for big meshes
+	MeshIndex maxIndex = 0;
+	for (uint32 i = 0; i < indexCount; i++)
+		maxIndex = std::max(maxIndex, indices[i]);
+
+	if (maxIndex <= 0xFFFF)
+		header.flags |= MESH_ASSET_FLAG_16BIT_INDICES;
+
+	if (format == MESH_VERTEX_FORMAT_PACKED)
+	{
+		for (uint32 i = 0; i < vertexCount; i++)
+		{
+			const MeshVertex& vertex = vertices[i];
+			if (vertex.color.x != 1.0f || vertex.color.y != 1.0f || vertex.color.z != 1.0f || vertex.color.w != 1.0f)
+				header.flags |= MESH_ASSET_FLAG_VERTEX_COLOR;
+		}
+
+		for (uint32 axis = 0; axis < 3; axis++)
+		{
+			header.positionOffset[axis] = header.boundsMin[axis];
+			header.positionScale[axis] = (header.boundsMax[axis] - header.boundsMin[axis]) / 65535.0f;
+		}
+
+		header.vertexBufferSize = (uint64)vertexCount * GetPackedVertexStride(header.flags);
+	}
+	else
+	{
+		header.vertexBufferSize = (uint64)vertexCount * sizeof(MeshVertex);
+	}
+
+	header.indexBufferSize = (uint64)indexCount * ((header.flags & MESH_ASSET_FLAG_16BIT_INDICES) ? sizeof(uint16) : sizeof(MeshIndex));
+
+	out.push(header);
+
+	if (format == MESH_VERTEX_FORMAT_PACKED)
+	{
+		for (uint32 i = 0; i < vertexCount; i++)
+		{
+			const MeshVertex& vertex = vertices[i];
+			const float position[3] = { vertex.position.x, vertex.position.y, vertex.position.z };
+
+			for (uint32 axis = 0; axis < 3; axis++)
+			{
+				float scale = header.positionScale[axis];
+				float quantized = scale > 0.0f ? (position[axis] - header.positionOffset[axis]) / scale : 0.0f;
+				out.push<uint16>((uint16)math::Clamp(quantized + 0.5f, 0.0f, 65535.0f));
+			}
+
+			out.push<uint16>(FloatToHalf(vertex.textCoords.x));
+			out.push<uint16>(FloatToHalf(vertex.textCoords.y));
+
+			if (header.flags & MESH_ASSET_FLAG_VERTEX_COLOR)
+			{
+				out.push<uint8>(FloatToUNorm8(vertex.color.x));
+				out.push<uint8>(FloatToUNorm8(vertex.color.y));
+				out.push<uint8>(FloatToUNorm8(vertex.color.z));
+				out.push<uint8>(FloatToUNorm8(vertex.color.w));
+			}
+		}
+	}
+	else
+	{
+		out.push_bytes(vertices, header.vertexBufferSize);
+	}
+
+	if (header.flags & MESH_ASSET_FLAG_16BIT_INDICES)
+	{
+		for (uint32 i = 0; i < indexCount; i++)
+			out.push<uint16>((uint16)indices[i]);
+	}
+	else
+	{
+		out.push_bytes(indices, header.indexBufferSize);
+	}
+}
+
+bool meshUtils::ReadGeometry(BufferView& fileData, MeshGeometry& outGeometry)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	size_t fileSize = fileData.remaining();
+
+	uint32 magic;
+	memcpy(&magic, fileData.seek(), sizeof(uint32));
+
+	if (magic != GROOVY_MESH_MAGIC)
+	{
+		// legacy, MeshVertex and 32 bit indices after two sizes
+		size_t vertexBufferSize = fileData.read<size_t>();
+		size_t indexBufferSize = fileData.read<size_t>();
+
+		outGeometry.vertices = (const MeshVertex*)fileData.read(vertexBufferSize);
+		outGeometry.vertexCount = (uint32)(vertexBufferSize / sizeof(MeshVertex));
+		outGeometry.indices = (const MeshIndex*)fileData.read(indexBufferSize);
+		outGeometry.indexCount = (uint32)(indexBufferSize / sizeof(MeshIndex));
+		outGeometry.fileSize = fileSize - fileData.remaining();
+		ComputeBounds(outGeometry.vertices, outGeometry.vertexCount, outGeometry.box, outGeometry.sphere);
+		return true;
+	}
+
+	// version 1 headers end before the bounds
+	uint32 version;
+	memcpy(&version, fileData.seek() + offsetof(MeshAssetHeader, version), sizeof(uint32));
+	if (version < 1 || version > GROOVY_MESH_VERSION)
+		return false;
+
+	bool hasBounds = version >= 2;
+	size_t headerSize = hasBounds ? sizeof(MeshAssetHeader) : offsetof(MeshAssetHeader, boundsMin);
+
+	MeshAssetHeader header = {};
+	memcpy(&header, fileData.read(headerSize), headerSize);
+	if (header.vertexFormat > MESH_VERTEX_FORMAT_PACKED)
+		return false;
+
+	const byte* vertexData = fileData.read(header.vertexBufferSize);
+	const byte* indexData = fileData.read(header.indexBufferSize);
+
+	outGeometry.vertexCount = header.vertexCount;
+	outGeometry.indexCount = header.indexCount;
+	outGeometry.fileSize = fileSize - fileData.remaining();
+
+	if (header.vertexFormat == MESH_VERTEX_FORMAT_PACKED)
+	{
+		uint32 stride = GetPackedVertexStride(header.flags);
+		if (header.vertexBufferSize != (uint64)header.vertexCount * stride)
+			return false;
+
+		outGeometry.vertexStorage.resize(header.vertexCount * sizeof(MeshVertex));
+		MeshVertex* vertices = (MeshVertex*)outGeometry.vertexStorage.data();
+
+		for (uint32 i = 0; i < header.vertexCount; i++)
+		{
+			const byte* packed = vertexData + (size_t)i * stride;
+			uint16 values[5];
+			memcpy(values, packed, sizeof(values));
+
+			MeshVertex& vertex = vertices[i];
+			vertex.position =
+			{
+				header.positionOffset[0] + values[0] * header.positionScale[0],
+				header.positionOffset[1] + values[1] * header.positionScale[1],
+				header.positionOffset[2] + values[2] * header.positionScale[2],
+				1.0f
+			};
+			vertex.textCoords = { HalfToFloat(values[3]), HalfToFloat(values[4]) };
+
+			if (header.flags & MESH_ASSET_FLAG_VERTEX_COLOR)
+			{
+				const byte* color = packed + sizeof(values);
+				vertex.color = { color[0] / 255.0f, color[1] / 255.0f, color[2] / 255.0f, color[3] / 255.0f };
+			}
+			else
+			{
+				vertex.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+			}
+		}
+
+		outGeometry.vertices = vertices;
+	}
+	else
+	{
+		if (header.vertexBufferSize != (uint64)header.vertexCount * sizeof(MeshVertex))
+			return false;
+
+		outGeometry.vertices = (const MeshVertex*)vertexData;
+	}
+
+	if (header.flags & MESH_ASSET_FLAG_16BIT_INDICES)
+	{
+		if (header.indexBufferSize != (uint64)header.indexCount * sizeof(uint16))
+			return false;
+
+		outGeometry.indexStorage.resize(header.indexCount * sizeof(MeshIndex));
+		MeshIndex* indices = (MeshIndex*)outGeometry.indexStorage.data();
+
+		for (uint32 i = 0; i < header.indexCount; i++)
+		{
+			uint16 index;
+			memcpy(&index, indexData + (size_t)i * sizeof(uint16), sizeof(uint16));
+			indices[i] = index;
+		}
+
+		outGeometry.indices = indices;
+	}
+	else
+	{
+		if (header.indexBufferSize != (uint64)header.indexCount * sizeof(MeshIndex))
+			return false;
+
+		outGeometry.indices = (const MeshIndex*)indexData;
+	}
+
+	if (hasBounds)
+	{
+		outGeometry.box.min = { header.boundsMin[0], header.boundsMin[1], header.boundsMin[2] };
+		outGeometry.box.max = { header.boundsMax[0], header.boundsMax[1], header.boundsMax[2] };
+		outGeometry.sphere = { { header.sphereCenter[0], header.sphereCenter[1], header.sphereCenter[2] }, header.sphereRadius };
+	}
+	else
+	{
+		ComputeBounds(outGeometry.vertices, outGeometry.vertexCount, outGeometry.box, outGeometry.sphere);
+	}
+
+	return true;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "core/coreminimal.h"
+#include "renderer/mesh.h"
+#include "assets/asset.h"
+#include "math/bounds.h"
+
+#include <vector>
+
+// geometry block of a mesh asset, points into the file data when it's stored as MeshVertex
+struct MeshGeometry
+{
+	const MeshVertex* vertices = nullptr;
+	uint32 vertexCount = 0;
+	const MeshIndex* indices = nullptr;
+	uint32 indexCount = 0;
+	// bytes the geometry takes in the file, header included
+	size_t fileSize = 0;
+	// local space bounds
+	BoundingBox box = {};
+	BoundingSphere sphere = {};
+
+	// decoded packed data
+	Buffer vertexStorage;
+	Buffer indexStorage;
+};
+
+/*
+	Geometry processing for imported meshes, every function works on one submesh (indices start at 0).
+	Usual order: WeldVertices -> OptimizeVertexCache -> OptimizeOverdraw -> OptimizeVertexFetch, Simplify for lods
+*/
+namespace meshUtils
+{
+	// post transform cache the optimizers aim for, small enough for every gpu we run on
+	constexpr uint32 VERTEX_CACHE_SIZE = 16;
+
+	// merges bitwise identical vertices, outIndices has one entry per input vertex
+	CORE_API void WeldVertices(const MeshVertex* vertices, uint32 vertexCount, std::vector<MeshVertex>& outVertices, std::vector<MeshIndex>& outIndices);
+
+	// reorders triangles for post transform cache hits (tipsify, Sander et al. 2007)
+	CORE_API void OptimizeVertexCache(MeshIndex* indices, uint32 indexCount, uint32 vertexCount);
+
+	// draws outward facing clusters of triangles first, clusters are cut where the cache optimizer restarts so the cache hits are kept.
+	// call it after OptimizeVertexCache
+	CORE_API void OptimizeOverdraw(MeshIndex* indices, uint32 indexCount, const MeshVertex* vertices, uint32 vertexCount);
+
+	// reorders vertices by first use and drops unused ones, returns the new vertex count
+	CORE_API uint32 OptimizeVertexFetch(MeshVertex* vertices, uint32 vertexCount, MeshIndex* indices, uint32 indexCount);
+
+	// collapses edges by quadric error until indexCount reaches targetIndexCount or the error would exceed targetError,
+	// both errors are relative to the mesh extent. border and seam vertices don't move, no vertex is created
+	CORE_API void Simplify(const MeshIndex* indices, uint32 indexCount, const MeshVertex* vertices, uint32 vertexCount, uint32 targetIndexCount, float targetError, std::vector<MeshIndex>& outIndices, float* outError = nullptr);
+
+	// average cache misses per triangle with a fifo cache, 3 means no reuse at all
+	CORE_API float ComputeACMR(const MeshIndex* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize = VERTEX_CACHE_SIZE);
+
+	// sphere centered on the box, with the farthest vertex on its surface
+	CORE_API void ComputeBounds(const MeshVertex* vertices, uint32 vertexCount, BoundingBox& outBox, BoundingSphere& outSphere);
+
+	// header and geometry of a mesh asset, the color stream and 32 bit indices are dropped when they carry nothing
+	CORE_API void WriteGeometry(const MeshVertex* vertices, uint32 vertexCount, const MeshIndex* indices, uint32 indexCount, EMeshVertexFormat format, DynamicBuffer& out);
+	// reads (and unpacks) the geometry at the start of a mesh asset, legacy files included (their bounds are computed here). false if the format is unknown
+	CORE_API bool ReadGeometry(BufferView& fileData, MeshGeometry& outGeometry);
+}
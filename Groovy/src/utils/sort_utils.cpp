@@ -0,0 +1,65 @@
+#include "sort_utils.h"
+#include "core/profiler.h"
+
+#include <utility>
+
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+void sortUtils::RadixSort(uint64* keys, uint32* values, uint32 count, uint64* tempKeys, uint32* tempValues)
+{
+	GROOVY_PROFILE_FUNCTION();
+
+	if (count < 2)
+		return;
+
+	// every histogram in one read of the keys
+	uint32 histograms[RADIX_PASSES][RADIX_SIZE] = {};
+	for (uint32 i = 0; i < count; i++)
+	{
+		uint64 key = keys[i];
+		for (uint32 pass = 0; pass < RADIX_PASSES; pass++)
+			histograms[pass][(key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)]++;
+	}
+
+	uint64* srcKeys = keys;
+	uint32* srcValues = values;
+	uint64* dstKeys = tempKeys;
+	uint32* dstValues = tempValues;
+
+	for (uint32 pass = 0; pass < RADIX_PASSES; pass++)
+	{
+		uint32* histogram = histograms[pass];
+		uint32 shift = pass * RADIX_BITS;
+
+		// all keys in the same bucket, the pass wouldn't move anything
+		if (histogram[(srcKeys[0] >> shift) & (RADIX_SIZE - 1)] == count)
+			continue;
+
+		uint32 offset = 0;
+		for (uint32 digit = 0; digit < RADIX_SIZE; digit++)
+		{
+			uint32 digitCount = histogram[digit];
+			histogram[digit] = offset;
+			offset += digitCount;
+		}
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			uint32 destination = histogram[(srcKeys[i] >> shift) & (RADIX_SIZE - 1)]++;
+			dstKeys[destination] = srcKeys[i];
+			dstValues[destination] = srcValues[i];
+		}
+
+		std::swap(srcKeys, dstKeys);
+		std::swap(srcValues, dstValues);
+	}
+
+	// odd number of passes, the result is in the temp buffers
+	if (srcKeys != keys)
+	{
+		memcpy(keys, srcKeys, count * sizeof(uint64));
+		memcpy(values, srcValues, count * sizeof(uint32));
+	}
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "core/coreminimal.h"
+
+namespace sortUtils
+{
+	// stable lsd radix sort, 8 bits per pass. values move with their key, temp buffers must hold count elements.
+	// passes on bytes that are the same in every key are skipped
+	CORE_API void RadixSort(uint64* keys, uint32* values, uint32 count, uint64* tempKeys, uint32* tempValues);
+}
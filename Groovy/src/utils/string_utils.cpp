@@ -25,6 +25,17 @@ bool stringUtils::Replace(std::string& str, std::string_view find, std::string_v
 	return false;
 }
 
+uint32 stringUtils::Hash32(std::string_view str)
+{
+	uint32 hash = 2166136261u;
+	for (char c : str)
+	{
+		hash ^= (uint8)c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
 uint32 stringUtils::ReplaceAll(std::string& str, std::string_view find, std::string_view replace)
 {
 	uint32 replaceCount = 0;
@@ -39,7 +50,7 @@ std::string stringUtils::ToString(Vec2 vec)
 {
 	const char* format = "X= %4.3f   Y= %4.3f";
 	char buffer[64];
-	sprintf_s(buffer, 64, format, vec.x, vec.y);
+	snprintf(buffer, 64, format, vec.x, vec.y);
 
 	return buffer;
 }
@@ -48,7 +59,7 @@ std::string stringUtils::ToString(Vec3 vec)
 {
 	const char* format = "X= %4.3f   Y= %4.3f   Z= %4.3f";
 	char buffer[96];
-	sprintf_s(buffer, 96, format, vec.x, vec.y, vec.z);
+	snprintf(buffer, 96, format, vec.x, vec.y, vec.z);
 
 	return buffer;
 }
@@ -57,7 +68,7 @@ std::string stringUtils::ToString(Vec4 vec)
 {
 	const char* format = "X= %4.3f   Y= %4.3f   Z= %4.3f   W= %4.3f";
 	char buffer[128];
-	sprintf_s(buffer, 128, format, vec.x, vec.y, vec.z, vec.w);
+	snprintf(buffer, 128, format, vec.x, vec.y, vec.z, vec.w);
 
 	return buffer;
 }
\ No newline at end of file
@@ -10,6 +10,9 @@ namespace stringUtils
 	CORE_API bool Replace(std::string& str, std::string_view find, std::string_view replace);
 	CORE_API uint32 ReplaceAll(std::string& str, std::string_view find, std::string_view replace);
 
+	// fnv-1a, for lookup tables keyed by names
+	CORE_API uint32 Hash32(std::string_view str);
+
 	CORE_API std::string ToString(Vec2 vec);
 	CORE_API std::string ToString(Vec3 vec);
 	CORE_API std::string ToString(Vec4 vec);
@@ -0,0 +1,21 @@
+project "Headless"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+
+    files
+    {
+        "src/**.h",
+        "src/**.cpp"
+    }
+
+    includedirs
+    {
+        "src",
+        "%{wks.location}/Groovy/src"
+    }
+
+    links
+    {
+        "Groovy"
+    }
\ No newline at end of file
@@ -0,0 +1,2 @@
+#include "platform/console_entrypoint.h"
+#include "engine/launch_headless.h"
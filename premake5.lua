@@ -8,5 +8,6 @@ workspace "GroovyEngine"
 include "Groovy"
 include "Editor"
 include "Sandbox"
+include "Headless"
 include "ProjectCreator"
 include "DemoProject"
\ No newline at end of file
@@ -39,4 +39,10 @@
 
     filter "system:windows"
         defines "PLATFORM_WIN32"
+    filter {}
+
+    filter "system:linux"
+        defines "PLATFORM_LINUX"
+        pic "On"
+        links { "dl", "pthread" }
     filter {}
\ No newline at end of file